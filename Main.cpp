@@ -3,12 +3,18 @@
 #include <limits>
 #include <cstring>
 #include <ctime>
+#include <chrono>
 
 // Include semua file header modular
 #include "user.h"
 #include "data_structures.h"
 #include "file_handler.h"
 #include "admin.h"
+#include "account_history.h"
+#include "transaction_id_index.h"
+#include "time_index.h"
+#include "transaction_recorder.h"
+#include "huffman_model.h"
 
 using namespace std;
 
@@ -18,7 +24,13 @@ using namespace std;
 // Struktur data ini diakses oleh Admin dan User
 RefundStack globalRefundStack;        // Stack untuk refund (LIFO)
 CSQueue globalCSQueue;                // Queue untuk CS (FIFO)
-AVLTree globalAVLTree;                // AVL Tree untuk transaksi
+TransactionStore globalTransactions;  // Record transaksi (append-only)
+TransactionIndex globalTransactionIndex(globalTransactions);  // Index jumlah (AVL / B+ Tree)
+AccountHistory globalAccountHistory(globalTransactions);      // Index riwayat per akun
+TransactionIdIndex globalTransactionIds(globalTransactions);  // Index ID + status refund
+TransactionTimeIndex globalTimeIndex(globalTransactions);     // Index urut waktu
+TransactionRecorder globalRecorder(globalTransactionIndex, globalAccountHistory,
+                                   globalTransactionIds, globalTimeIndex);  // WAL lalu semua index
 
 // =================================================================
 // FUNGSI UTILITY
@@ -31,7 +43,7 @@ void clearScreen() {
     #endif
 }
 
-void pause() {
+void pauseScreen() {
     cout << "\nTekan ENTER untuk melanjutkan...";
     cin.get();
 }
@@ -105,13 +117,13 @@ bool isValidPassword(const char* password) {
 // =================================================================
 // DEKLARASI FUNGSI (Forward Declaration)
 // =================================================================
-void demoHuffman();
-void userMenu(User* user, User* users, int count, FileHandler& fileHandler);
+void demoHuffman(FileHandler& fileHandler);
+void userMenu(User* user, AccountTable& accounts, FileHandler& fileHandler);
 
 // =================================================================
 // FUNGSI REGISTRASI USER BARU DENGAN DATA KTP
 // =================================================================
-bool registerUser(User*& users, int& userCount, FileHandler& fileHandler) {
+bool registerUser(AccountTable& accounts, FileHandler& fileHandler) {
     clearScreen();
     cout << "\n";
     cout << "========================================\n";
@@ -138,13 +150,18 @@ bool registerUser(User*& users, int& userCount, FileHandler& fileHandler) {
         return false;
     }
     
-    // Cek apakah username sudah terdaftar
-    for (int i = 0; i < userCount; i++) {
-        if (strcmp(users[i].getUsername(), username) == 0) {
-            cout << "\n[ERROR] Username '" << username << "' sudah terdaftar!\n";
-            cout << "Silakan gunakan username lain.\n";
-            return false;
-        }
+    // Username admin tidak boleh dipakai user (login user dicek lebih dulu)
+    if (fileHandler.isAdminUsername(username)) {
+        cout << "\n[ERROR] Username '" << username << "' sudah terdaftar!\n";
+        cout << "Silakan gunakan username lain.\n";
+        return false;
+    }
+    
+    // Cek apakah username sudah terdaftar (hash index, O(1))
+    if (accounts.findSlot(username) >= 0) {
+        cout << "\n[ERROR] Username '" << username << "' sudah terdaftar!\n";
+        cout << "Silakan gunakan username lain.\n";
+        return false;
     }
     
     cout << "[OK] Username tersedia!\n";
@@ -214,8 +231,8 @@ bool registerUser(User*& users, int& userCount, FileHandler& fileHandler) {
     }
     
     // Cek apakah NIK sudah terdaftar
-    for (int i = 0; i < userCount; i++) {
-        KTP existingKTP = users[i].getKTP();
+    for (int i = 0; i < accounts.size(); i++) {
+        KTP existingKTP = accounts[i].getKTP();
         if (strcmp(existingKTP.nik, ktp.nik) == 0) {
             cout << "\n[ERROR] NIK sudah terdaftar dalam sistem!\n";
             cout << "Satu NIK hanya dapat didaftarkan sekali.\n";
@@ -292,25 +309,21 @@ bool registerUser(User*& users, int& userCount, FileHandler& fileHandler) {
     // =================================================================
     cout << "\n[INFO] Memproses registrasi...\n";
     
-    // Buat array baru dengan ukuran +1
-    User* newUsers = new User[userCount + 1];
-    
-    // Copy semua user lama ke array baru
-    for (int i = 0; i < userCount; i++) {
-        newUsers[i] = users[i];
+    // Tambah user baru dengan saldo awal 0 (amortized O(1), akun lain
+    // tidak dipindah sehingga pointer User* yang ada tetap valid)
+    User newUser(username, password, pin, 0.0);
+    newUser.setKTP(ktp);
+    User* created = accounts.add(newUser);
+    if (created == NULL) {
+        cout << "\n[ERROR] Kapasitas akun penuh!\n";
+        return false;
     }
+    created->markDirty();
     
-    // Tambah user baru dengan saldo awal 0
-    newUsers[userCount] = User(username, password, pin, 0.0);
-    newUsers[userCount].setKTP(ktp);
-    
-    // Hapus array lama dan gunakan array baru
-    delete[] users;
-    users = newUsers;
-    userCount++;
-    
-    // Simpan ke file users.txt
-    fileHandler.saveUsers(users, userCount);
+    // Simpan ke file users.dat
+    if (!fileHandler.saveUsers(accounts)) {
+        cout << "\n[ERROR] Akun dibuat tetapi gagal disimpan ke disk!\n";
+    }
     
     // =================================================================
     // STEP 7: Tampilkan Pesan Sukses
@@ -359,14 +372,23 @@ void userAjukanRefund(User* user) {
     }
     cin.ignore();
     
+    // Validasi O(1) lewat hash index ID: pemilik, jumlah, refund ganda
+    globalTransactionIds.sync();
+    int64_t rec = globalTransactionIds.validateRefund(req.username, req.transactionId,
+                                                      req.jumlah, REFUND_NONE);
+    if (rec < 0) {
+        return;
+    }
+    
     cout << "Alasan refund: ";
     cin.getline(req.alasan, 200);
     
     generateTimestamp(req.timestamp);
     strcpy(req.status, "Pending");
     
-    // Push ke Stack global
+    // Push ke Stack global, transaksi ditandai sedang diajukan
     globalRefundStack.push(req);
+    globalTransactionIds.markPending((uint32_t)rec);
     
     cout << "\n[SUCCESS] Refund request berhasil diajukan!\n";
     cout << "Request Anda akan diproses oleh Admin.\n";
@@ -440,29 +462,26 @@ void userTopUp(User* user, FileHandler& fileHandler) {
         strcpy(keterangan, "Top up via transfer bank");
     }
     
-    // Proses top up
-    user->addSaldo(jumlah);
-    
-    // Buat transaksi dan simpan ke AVL Tree & file
+    // Buat transaksi dan simpan ke file & AVL Tree, baru saldo diubah
     Transaksi t("Top Up", jumlah, keterangan, 
                 "System", user->getUsername());
     
-    globalAVLTree.insert(t);  // Insert ke AVL Tree global
-    fileHandler.appendTransaction(t);
-    
-    // HUFFMAN CODING - Kompresi Keterangan
-    HuffmanCoding huffman;
-    huffman.buildTree(t.keterangan);
-    
-    char compressed[10000];
-    huffman.encode(t.keterangan, compressed);
+    // HUFFMAN CODING - Keterangan disimpan terkompresi di arena store
+    // (model bersama, tanpa tabel per transaksi); ukuran & versi dari arena
+    KeteranganEncoding encoded;
+    if (!globalRecorder.record(t, fileHandler, &encoded)) {  // WAL + index global + riwayat
+        cout << "\n[ERROR] Top up gagal disimpan, saldo tidak berubah.\n";
+        return;
+    }
+    user->addSaldo(jumlah);
     
     int originalSize = strlen(t.keterangan);
-    int compressedSize = (strlen(compressed) + 7) / 8; // Convert bits to bytes
+    int compressedSize = (int)encoded.bytes;
     
+    char waktu[20];
     cout << "\n========== STRUK TRANSAKSI ==========\n";
     cout << "ID         : " << t.id << "\n";
-    cout << "Waktu      : " << t.timestamp << "\n";
+    cout << "Waktu      : " << t.formatWaktu(waktu) << "\n";
     cout << "Jenis      : " << t.jenis << "\n";
     cout << "Jumlah     : Rp " << t.jumlah << "\n";
     cout << "Keterangan : " << t.keterangan << "\n";
@@ -472,13 +491,16 @@ void userTopUp(User* user, FileHandler& fileHandler) {
     cout << "\n=== HUFFMAN COMPRESSION ===\n";
     cout << "Original Size  : " << originalSize << " bytes\n";
     cout << "Compressed     : " << compressedSize << " bytes\n";
-    cout << "Saving         : " << (originalSize - compressedSize) << " bytes (";
-    cout << fixed << setprecision(1) << (100.0 - 100.0 * compressedSize / originalSize) << "% smaller)\n";
+    cout << "Saving         : " << (originalSize - compressedSize) << " bytes\n";
+    cout << "Rasio          : " << fixed << setprecision(1) << (100.0 * compressedSize / originalSize)
+         << "% dari ukuran asli\n";
+    cout << "Model          : v" << encoded.version
+         << " (dipakai bersama semua transaksi)\n";
     cout << "\n[INFO] Keterangan dikompresi dengan Huffman Coding!\n";
-    cout << "[INFO] Transaksi disimpan ke AVL Tree untuk laporan Admin.\n";
+    cout << "[INFO] Transaksi disimpan ke " << TRANSACTION_INDEX_NAME << " untuk laporan Admin.\n";
 }
 
-void userTransfer(User* user, User* users, int count, FileHandler& fileHandler) {
+void userTransfer(User* user, AccountTable& accounts, FileHandler& fileHandler) {
     clearScreen();
     cout << "\n=== TRANSFER SALDO ===\n";
     
@@ -486,14 +508,8 @@ void userTransfer(User* user, User* users, int count, FileHandler& fileHandler)
     cout << "Username tujuan: ";
     cin.getline(targetUsername, 50);
     
-    // Cari user tujuan
-    User* target = NULL;
-    for (int i = 0; i < count; i++) {
-        if (strcmp(users[i].getUsername(), targetUsername) == 0) {
-            target = &users[i];
-            break;
-        }
-    }
+    // Cari user tujuan (hash index, O(1))
+    User* target = accounts.find(targetUsername);
     
     if (target == NULL) {
         cout << "\n[ERROR] Username tujuan tidak ditemukan!\n";
@@ -539,30 +555,26 @@ void userTransfer(User* user, User* users, int count, FileHandler& fileHandler)
         return;
     }
     
-    // Proses transfer
-    user->deductSaldo(jumlah);
-    target->addSaldo(jumlah);
-    
-    // Buat transaksi dan simpan
+    // Buat transaksi dan simpan, saldo baru dipindah setelah tersimpan
     Transaksi t("Transfer", jumlah, keterangan,
                 user->getUsername(), target->getUsername());
     
-    globalAVLTree.insert(t);
-    fileHandler.appendTransaction(t);
-    
-    // HUFFMAN CODING - Kompresi Keterangan
-    HuffmanCoding huffman;
-    huffman.buildTree(t.keterangan);
-    
-    char compressed[10000];
-    huffman.encode(t.keterangan, compressed);
+    // HUFFMAN CODING - Kompresi Keterangan (model bersama, disimpan di arena store)
+    KeteranganEncoding encoded;
+    if (!globalRecorder.record(t, fileHandler, &encoded)) {
+        cout << "\n[ERROR] Transfer gagal disimpan, saldo tidak berubah.\n";
+        return;
+    }
+    user->deductSaldo(jumlah);
+    target->addSaldo(jumlah);
     
     int originalSize = strlen(t.keterangan);
-    int compressedSize = (strlen(compressed) + 7) / 8;
+    int compressedSize = (int)encoded.bytes;
     
+    char waktu[20];
     cout << "\n========== STRUK TRANSAKSI ==========\n";
     cout << "ID         : " << t.id << "\n";
-    cout << "Waktu      : " << t.timestamp << "\n";
+    cout << "Waktu      : " << t.formatWaktu(waktu) << "\n";
     cout << "Dari       : " << user->getUsername() << "\n";
     cout << "Ke         : " << target->getUsername() << "\n";
     cout << "Jumlah     : Rp " << t.jumlah << "\n";
@@ -625,31 +637,82 @@ void userPembayaran(User* user, FileHandler& fileHandler) {
         return;
     }
     
-    // Proses pembayaran
-    user->deductSaldo(jumlah);
-    
     char keterangan[200];
     sprintf(keterangan, "Pembayaran %s", layanan[pilihan-1]);
     
     Transaksi t("Pembayaran", jumlah, keterangan,
                 user->getUsername(), "Merchant");
     
-    globalAVLTree.insert(t);
-    fileHandler.appendTransaction(t);
+    // Saldo baru dipotong setelah transaksi tersimpan
+    if (!globalRecorder.record(t, fileHandler)) {
+        cout << "\n[ERROR] Pembayaran gagal disimpan, saldo tidak berubah.\n";
+        return;
+    }
+    user->deductSaldo(jumlah);
     
+    char waktu[20];
     cout << "\n========== STRUK TRANSAKSI ==========\n";
     cout << "ID         : " << t.id << "\n";
-    cout << "Waktu      : " << t.timestamp << "\n";
+    cout << "Waktu      : " << t.formatWaktu(waktu) << "\n";
     cout << "Jenis      : " << layanan[pilihan-1] << "\n";
     cout << "Jumlah     : Rp " << t.jumlah << "\n";
     cout << "Saldo Akhir: Rp " << user->getSaldo() << "\n";
     cout << "=====================================\n";
 }
 
+// =================================================================
+// FUNGSI USER - RIWAYAT TRANSAKSI (Index per Akun)
+// =================================================================
+void userRiwayatTransaksi(User* user) {
+    clearScreen();
+    cout << "\n=== RIWAYAT TRANSAKSI ===\n";
+    
+    globalAccountHistory.sync();
+    const char* username = user->getUsername();
+    size_t total = globalAccountHistory.count(username);
+    if (total == 0) {
+        cout << "Belum ada transaksi.\n";
+        return;
+    }
+    
+    size_t pages = (total + REPORT_PAGE_SIZE - 1) / REPORT_PAGE_SIZE;
+    cout << "Total: " << total << " transaksi (terbaru lebih dulu, "
+         << REPORT_PAGE_SIZE << " per halaman)\n";
+    
+    // Setiap halaman hanya membaca REPORT_PAGE_SIZE record dari index
+    for (size_t page = 0; page < pages; page++) {
+        cout << "\nHalaman " << page + 1 << "/" << pages << "\n";
+        cout << "--------------------------------------------------------------------------\n";
+        cout << "| Waktu               | Jenis      | Arah   | Jumlah        | Lawan       |\n";
+        cout << "--------------------------------------------------------------------------\n";
+        globalAccountHistory.visitNewest(username, page * REPORT_PAGE_SIZE, REPORT_PAGE_SIZE,
+                                         [&](const TransaksiRecord& t) {
+            bool keluar = strcmp(t.dari, username) == 0;
+            char waktu[20];
+            cout << "| " << setw(19) << left << t.formatWaktu(waktu)
+                 << " | " << setw(10) << left << t.jenis
+                 << " | " << setw(6) << left << (keluar ? "Keluar" : "Masuk")
+                 << " | Rp " << setw(10) << right << fixed << setprecision(2) << t.jumlah
+                 << " | " << setw(11) << left << (keluar ? t.ke : t.dari) << " |\n";
+        });
+        cout << "--------------------------------------------------------------------------\n";
+        
+        if (page + 1 == pages) break;
+        cout << "ENTER = halaman berikutnya, q = selesai: ";
+        char input[16];
+        if (!cin.getline(input, sizeof(input))) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            break;
+        }
+        if (strcmp(input, "q") == 0 || strcmp(input, "Q") == 0) break;
+    }
+}
+
 // =================================================================
 // DEMO HUFFMAN CODING - DENGAN PRAKTIK LANGSUNG
 // =================================================================
-void demoHuffman() {
+void demoHuffman(FileHandler& fileHandler) {
     clearScreen();
     cout << "\n========================================\n";
     cout << "  HUFFMAN CODING - KOMPRESI TRANSAKSI\n";
@@ -680,7 +743,7 @@ void demoHuffman() {
         huffman.buildTree(keterangan);
         
         char encoded[10000];
-        huffman.encode(keterangan, encoded);
+        huffman.encode(keterangan, encoded, sizeof(encoded));
         
         cout << "\n=== HASIL KOMPRESI ===\n";
         cout << "Kode Binary:\n" << encoded << "\n";
@@ -712,16 +775,16 @@ void demoHuffman() {
         huffman.buildTree(keterangan);
         
         char encoded[10000];
-        huffman.encode(keterangan, encoded);
+        huffman.encode(keterangan, encoded, sizeof(encoded));
         
         cout << "\n=== HASIL KOMPRESI ===\n";
         cout << "Kode Binary:\n" << encoded << "\n";
         cout << "\nPanjang: " << strlen(encoded) << " bits\n";
         
-        // Hitung ukuran file
+        // Hitung ukuran file: stream kanonik padat (panjang + tabel + bit)
+        vector<uint8_t> packed;
         int originalBytes = strlen(keterangan);
-        int compressedBits = strlen(encoded);
-        int compressedBytes = (compressedBits + 7) / 8; // Round up
+        int compressedBytes = (int)huffman.encodePacked(keterangan, packed);
         
         cout << "\n=== PERBANDINGAN UKURAN ===\n";
         cout << "Ukuran Original    : " << originalBytes << " bytes\n";
@@ -730,71 +793,78 @@ void demoHuffman() {
         cout << "Rasio Kompresi     : " << fixed << setprecision(2) 
              << (100.0 * compressedBytes / originalBytes) << "%\n";
         
+        // Decode ulang dari stream padat untuk verifikasi
+        char decoded[sizeof(keterangan)];
+        bool ok = huffman.decodePacked(packed, decoded, sizeof(decoded)) &&
+                  strcmp(decoded, keterangan) == 0;
+        cout << "Decode Ulang       : " << (ok ? "Sama dengan original" : "GAGAL") << "\n";
+        
         cout << "\n=== TABEL KODE HUFFMAN ===\n";
         huffman.displayKode();
         
     } else if (choice == 3) {
-        // KOMPRESI DATABASE
+        // KOMPRESI DATABASE: riwayat dingin dikompresi per blok (.hz)
         cout << "\n=== KOMPRESI DATABASE TRANSAKSI ===\n";
-        cout << "Menganalisis semua transaksi di AVL Tree...\n";
+        bool hasText = fileHandler.hasTransactionText();
+        if (hasText) {
+            cout << "transactions.txt : " << fileHandler.legacyTransactionSize() << " bytes\n";
+        } else {
+            cout << "transactions.txt : sudah terkompresi / tidak ada\n";
+        }
+        cout << "Segmen log       : " << fileHandler.segmentCount() << " (" << SEGMENT_HOT_COUNT
+             << " terbaru tidak dikompresi)\n";
+        cout << "Blok " << BLOCK_SIZE / 1024 << " KB, tabel Huffman per blok, dikompresi paralel\n";
         
-        if (globalAVLTree.isEmpty()) {
-            cout << "\n[INFO] Belum ada transaksi di database.\n";
+        cout << "\nKompresi sekarang? File asli dihapus setelah terverifikasi (y/n): ";
+        char confirm[8];
+        cin.getline(confirm, sizeof(confirm));
+        if (confirm[0] != 'y' && confirm[0] != 'Y') {
+            cout << "Dibatalkan.\n";
             return;
         }
         
-        cout << "\n[INFO] Fitur ini akan mengkompresi semua keterangan transaksi.\n";
-        cout << "Dalam implementasi real:\n";
-        cout << "- Setiap keterangan transaksi di-encode saat disimpan\n";
-        cout << "- Ukuran database berkurang signifikan\n";
-        cout << "- Transmisi data lebih cepat\n";
-        cout << "- Cost storage server lebih murah\n";
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        BlockCompressStats text, segments;
+        bool textOk = hasText && fileHandler.compressTransactionFile(text);
+        int segmentCount = fileHandler.compressColdSegments(segments);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
         
-        // Simulasi kompresi
-        const char* samples[] = {
-            "Transfer ke user lain",
-            "Pembayaran Listrik PLN",
-            "Top up via Bank BCA",
-            "Pembayaran PDAM Jakarta",
-            "Transfer dana darurat"
-        };
-        
-        int totalOriginal = 0;
-        int totalCompressed = 0;
+        uint64_t original = text.originalBytes + segments.originalBytes;
+        uint64_t compressed = text.compressedBytes + segments.compressedBytes;
+        cout << "\n=== HASIL KOMPRESI ===\n";
+        cout << "transactions.txt   : " << (textOk ? "dikompresi" : "dilewati") << "\n";
+        cout << "Segmen dikompresi  : " << segmentCount << "\n";
+        if (original == 0) {
+            cout << "\n[INFO] Tidak ada riwayat yang perlu dikompresi.\n";
+            return;
+        }
+        cout << "Jumlah Blok        : " << (text.blocks + segments.blocks) << " ("
+             << (text.rawBlocks + segments.rawBlocks) << " disimpan tanpa kompresi)\n";
+        cout << "Ukuran Original    : " << original << " bytes\n";
+        cout << "Ukuran Compressed  : " << compressed << " bytes\n";
+        cout << "Rasio Kompresi     : " << fixed << setprecision(2)
+             << (100.0 * compressed / original) << "%\n";
+        cout << "Kecepatan          : " << fixed << setprecision(1)
+             << (seconds > 0 ? original / seconds / 1e6 : 0.0) << " MB/s (termasuk verifikasi)\n";
         
-        cout << "\n=== SIMULASI KOMPRESI 5 TRANSAKSI ===\n";
-        for (int i = 0; i < 5; i++) {
-            HuffmanCoding huffman;
-            huffman.buildTree(samples[i]);
-            
-            char encoded[10000];
-            huffman.encode(samples[i], encoded);
-            
-            int origSize = strlen(samples[i]);
-            int compSize = (strlen(encoded) + 7) / 8;
+        // Akses acak: 1 blok di tengah file di-decode sendiri
+        char packedPath[260];
+        fileHandler.packedTransactionFile(packedPath, sizeof(packedPath));
+        BlockFileReader reader;
+        vector<char> block;
+        if (textOk && reader.open(packedPath) && reader.blockCount() > 0) {
+            uint64_t b = reader.findBlock(reader.originalSize() / 2);
+            start = chrono::steady_clock::now();
+            bool ok = reader.readBlock(b, block);
+            double micros = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
             
-            totalOriginal += origSize;
-            totalCompressed += compSize;
-            
-            cout << "\n[" << (i+1) << "] \"" << samples[i] << "\"\n";
-            cout << "    Original: " << origSize << " bytes ? Compressed: " 
-                 << compSize << " bytes (";
-            cout << fixed << setprecision(1) << (100.0 * compSize / origSize) << "%)\n";
+            size_t lineEnd = 0;
+            while (lineEnd < block.size() && lineEnd < 100 && block[lineEnd] != '\n') lineEnd++;
+            cout << "\n=== AKSES ACAK BLOK " << b << " ===\n";
+            cout << "Decode 1 blok      : " << (ok ? "OK" : "GAGAL") << ", " << block.size()
+                 << " bytes dalam " << fixed << setprecision(0) << micros << " us\n";
+            cout << "Baris pertama      : " << string(block.data(), lineEnd) << "\n";
         }
-        
-        cout << "\n=== TOTAL PENGHEMATAN ===\n";
-        cout << "Total Original     : " << totalOriginal << " bytes\n";
-        cout << "Total Compressed   : " << totalCompressed << " bytes\n";
-        cout << "Total Penghematan  : " << (totalOriginal - totalCompressed) << " bytes\n";
-        cout << "Efisiensi          : " << fixed << setprecision(2) 
-             << (100.0 - 100.0 * totalCompressed / totalOriginal) << "% lebih kecil\n";
-        
-        cout << "\n=== PROYEKSI DATABASE ===\n";
-        cout << "Jika database memiliki 1 juta transaksi:\n";
-        cout << "- Penghematan: ~" << ((totalOriginal - totalCompressed) * 1000000 / 5 / 1024 / 1024) 
-             << " MB\n";
-        cout << "- Backup lebih cepat\n";
-        cout << "- Biaya cloud storage lebih murah\n";
     }
     
     cout << "\n=== CARA KERJA HUFFMAN CODING ===\n";
@@ -816,7 +886,7 @@ void demoHuffman() {
 // =================================================================
 // MENU USER
 // =================================================================
-void userMenu(User* user, User* users, int count, FileHandler& fileHandler) {
+void userMenu(User* user, AccountTable& accounts, FileHandler& fileHandler) {
     while (true) {
         clearScreen();
         cout << "\n========================================\n";
@@ -833,8 +903,9 @@ void userMenu(User* user, User* users, int count, FileHandler& fileHandler) {
         cout << "5. Kirim Keluhan Customer Service (Queue - FIFO)\n";
         cout << "6. Lihat Info Lengkap (termasuk KTP)\n";
         cout << "7. Demo Huffman Coding\n";
-        cout << "8. Logout\n";
-        cout << "\nPilih menu (1-8): ";
+        cout << "8. Riwayat Transaksi\n";
+        cout << "9. Logout\n";
+        cout << "\nPilih menu (1-9): ";
         
         int choice;
         if (!(cin >> choice)) {
@@ -849,7 +920,7 @@ void userMenu(User* user, User* users, int count, FileHandler& fileHandler) {
                 userTopUp(user, fileHandler);
                 break;
             case 2:
-                userTransfer(user, users, count, fileHandler);
+                userTransfer(user, accounts, fileHandler);
                 break;
             case 3:
                 userPembayaran(user, fileHandler);
@@ -864,11 +935,17 @@ void userMenu(User* user, User* users, int count, FileHandler& fileHandler) {
                 user->displayInfo();
                 break;
             case 7:
-                demoHuffman();
+                demoHuffman(fileHandler);
                 break;
             case 8:
-                fileHandler.saveUsers(users, count);
-                cout << "\nData tersimpan. Logout berhasil.\n";
+                userRiwayatTransaksi(user);
+                break;
+            case 9:
+                if (fileHandler.saveUsers(accounts)) {
+                    cout << "\nData tersimpan. Logout berhasil.\n";
+                } else {
+                    cout << "\n[ERROR] Data GAGAL disimpan! Logout tetap dilakukan.\n";
+                }
                 return;
             default:
                 cout << "\nPilihan tidak valid!\n";
@@ -882,7 +959,7 @@ void userMenu(User* user, User* users, int count, FileHandler& fileHandler) {
 // =================================================================
 // FUNGSI LOGIN (User atau Admin)
 // =================================================================
-int loginSystem(User* users, int count, User** loggedUser, FileHandler& fileHandler, char* adminID) {
+int loginSystem(AccountTable& accounts, User** loggedUser, FileHandler& fileHandler, char* adminID) {
     char username[50], password[50];
     
     cout << "Username: ";
@@ -890,21 +967,21 @@ int loginSystem(User* users, int count, User** loggedUser, FileHandler& fileHand
     cout << "Password: ";
     cin.getline(password, 50);
     
-    // Cek apakah login sebagai admin
+    // Cek apakah login sebagai user biasa (jalur paling sering,
+    // tidak perlu lookup admin sama sekali)
+    User* user = accounts.find(username);
+    if (user != NULL && user->authenticate(username, password)) {
+        *loggedUser = user;
+        cout << "\n[SUCCESS] Login berhasil sebagai User!\n";
+        return 1; // Return 1 untuk user
+    }
+    
+    // Cek apakah login sebagai admin (hash table di memori)
     if (fileHandler.loadAdmin(username, password, adminID)) {
         cout << "\n[SUCCESS] Login berhasil sebagai Admin!\n";
         return 2; // Return 2 untuk admin
     }
     
-    // Cek apakah login sebagai user biasa
-    for (int i = 0; i < count; i++) {
-        if (users[i].authenticate(username, password)) {
-            *loggedUser = &users[i];
-            cout << "\n[SUCCESS] Login berhasil sebagai User!\n";
-            return 1; // Return 1 untuk user
-        }
-    }
-    
     return 0; // Return 0 untuk login gagal
 }
 
@@ -927,15 +1004,20 @@ int main() {
     
     // Load data
     cout << "Memuat data dari database...\n";
-    User* users = NULL;
-    int userCount = fileHandler.loadUsers(users);
-    fileHandler.loadTransactions(globalAVLTree);
+    AccountTable accounts;
+    fileHandler.loadUsers(accounts);
+    fileHandler.loadTransactions(globalTransactionIndex, globalRefundStack, globalCSQueue);
+    globalAccountHistory.sync();
+    globalTransactionIds.sync();
+    globalTransactionIds.restorePending(globalRefundStack);
+    globalTimeIndex.sync();
+    keteranganModels().startBackground();  // Model dilatih saat load (TransactionStore::appendBulk)
     
     cout << "\nData berhasil dimuat!\n";
-    cout << "Total User: " << userCount << "\n";
-    cout << "Transaksi dimuat ke AVL Tree.\n";
+    cout << "Total User: " << accounts.size() << "\n";
+    cout << "Transaksi dimuat ke " << TRANSACTION_INDEX_NAME << ".\n";
     
-    pause();
+    pauseScreen();
     
     // Main Loop
     while (true) {
@@ -970,58 +1052,64 @@ int main() {
             User* loggedUser = NULL;
             char adminID[20];
             
-            int loginResult = loginSystem(users, userCount, &loggedUser, fileHandler, adminID);
+            int loginResult = loginSystem(accounts, &loggedUser, fileHandler, adminID);
             
             if (loginResult == 1) {
                 // Login sebagai User
-                pause();
-                userMenu(loggedUser, users, userCount, fileHandler);
+                pauseScreen();
+                userMenu(loggedUser, accounts, fileHandler);
+                fileHandler.checkpointIfDue(globalTransactionIndex, globalRefundStack, globalCSQueue,
+                                            accounts);
                 
             } else if (loginResult == 2) {
                 // Login sebagai Admin
                 Admin admin("admin", "admin123", adminID);
-                pause();
+                pauseScreen();
                 adminMenu(&admin, globalRefundStack, globalCSQueue, 
-                         globalAVLTree, users, userCount);
-                fileHandler.saveUsers(users, userCount);
+                         globalTransactionIndex, globalTransactionIds, globalTimeIndex,
+                         globalRecorder, accounts, fileHandler);
+                fileHandler.saveUsers(accounts);
+                fileHandler.checkpointIfDue(globalTransactionIndex, globalRefundStack, globalCSQueue,
+                                            accounts);
                 
             } else {
                 cout << "\n[ERROR] Username atau password salah!\n";
-                pause();
+                pauseScreen();
             }
             
         } else if (choice == 2) {
             // REGISTRASI USER BARU
-            if (registerUser(users, userCount, fileHandler)) {
-                pause();
+            if (registerUser(accounts, fileHandler)) {
+                pauseScreen();
             } else {
                 cout << "\n[INFO] Registrasi dibatalkan atau gagal.\n";
-                pause();
+                pauseScreen();
             }
             
         } else if (choice == 3) {
             // DEMO HUFFMAN CODING
-            demoHuffman();
-            pause();
+            demoHuffman(fileHandler);
+            pauseScreen();
             
         } else if (choice == 4) {
             // KELUAR
             cout << "\n========================================\n";
             cout << "Menyimpan data ke database...\n";
-            fileHandler.saveUsers(users, userCount);
-            cout << "Data berhasil disimpan!\n";
+            bool saved = fileHandler.saveUsers(accounts);
+            fileHandler.writeCheckpoint(globalTransactionIndex, globalRefundStack, globalCSQueue,
+                                        accounts);
+            cout << (saved ? "Data berhasil disimpan!\n" : "[ERROR] Sebagian data user GAGAL disimpan!\n");
             cout << "\nTerima kasih telah menggunakan E-Wallet System.\n";
             cout << "========================================\n\n";
             break;
             
         } else {
             cout << "\n[ERROR] Pilihan tidak valid!\n";
-            pause();
+            pauseScreen();
         }
     }
     
-    // Cleanup
-    delete[] users;
+    // Cleanup: tabel akun dibebaskan otomatis oleh destructor AccountTable
     
     return 0;
 }
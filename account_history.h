@@ -0,0 +1,149 @@
+#ifndef ACCOUNT_HISTORY_H
+#define ACCOUNT_HISTORY_H
+
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <string_view>
+#include "data_structures.h"
+#include "hash_index.h"
+
+using namespace std;
+
+// =================================================================
+// ACCOUNT HISTORY - Index Riwayat Transaksi per Akun
+// =================================================================
+/*
+ * Index jumlah (AVL / B+ Tree) urut berdasarkan jumlah, sehingga
+ * riwayat 1 akun harus memindai SEMUA transaksi -> O(total transaksi).
+ *
+ * KONSEP:
+ * - Setiap akun (dari & ke) punya daftar nomor record di
+ *   TransactionStore, urut waktu (sama -> urut record)
+ * - Username -> daftar lewat HashIndex (key diambil dari daftar itu
+ *   sendiri, tidak disalin ke slot hash)
+ * - sync() mengejar record store yang belum ter-index: saat load
+ *   semua record sekaligus (diurutkan per akun), setelah insert hanya
+ *   record baru (biasanya cukup ditempel di ujung daftar)
+ * - 1 halaman riwayat = O(ukuran halaman), tidak tergantung jumlah
+ *   transaksi akun maupun total transaksi
+ */
+
+struct AccountHistoryList {
+    char username[50];
+    vector<uint32_t> recs;          // Record di TransactionStore, urut waktu
+};
+
+struct HistoryNameOf {
+    const vector<AccountHistoryList>* lists;
+
+    string_view operator()(int l) const {
+        return (*lists)[l].username;
+    }
+};
+
+class AccountHistory {
+private:
+    const TransactionStore& store;
+    vector<AccountHistoryList> lists;
+    HashIndex<int, HistoryNameOf> index;
+    uint32_t synced;                // Record [0, synced) sudah ter-index
+
+    AccountHistory(const AccountHistory&);
+    AccountHistory& operator=(const AccountHistory&);
+
+    int listOf(const char* username) {
+        const int* l = index.find(username);
+        if (l != NULL) return *l;
+
+        lists.push_back(AccountHistoryList());
+        AccountHistoryList& list = lists.back();
+        strncpy(list.username, username, sizeof(list.username) - 1);
+        list.username[sizeof(list.username) - 1] = '\0';
+        index.insert((int)lists.size() - 1);
+        return (int)lists.size() - 1;
+    }
+
+public:
+    explicit AccountHistory(const TransactionStore& transactions)
+        : store(transactions), index(HistoryNameOf{&lists}), synced(0) {}
+
+    /*
+     * Index semua record baru di store. Record baru ditempel ke daftar
+     * akunnya; daftar yang bertambah lalu diurutkan di bagian barunya
+     * saja dan digabung dengan bagian lama hanya jika waktunya mundur.
+     */
+    void sync() {
+        uint32_t from = synced, to = (uint32_t)store.size();
+        if (from == to) return;
+
+        // (daftar, panjang sebelum sync) untuk setiap daftar yang bertambah
+        vector< pair<int, size_t> > touched;
+        for (uint32_t rec = from; rec < to; rec++) {
+            const TransaksiRecord& t = store[rec];
+            const char* names[2] = {t.dari, t.ke};
+            for (int side = 0; side < 2; side++) {
+                if (names[side][0] == '\0') continue;
+                if (side == 1 && strcmp(t.dari, t.ke) == 0) continue;
+
+                int l = listOf(names[side]);
+                vector<uint32_t>& recs = lists[l].recs;
+                if (recs.empty() || recs.back() < from) {
+                    touched.push_back(make_pair(l, recs.size()));
+                }
+                recs.push_back(rec);
+            }
+        }
+
+        auto timeLess = [&](uint32_t a, uint32_t b) {
+            int64_t ta = store[a].waktu, tb = store[b].waktu;
+            return ta < tb || (ta == tb && a < b);
+        };
+        for (size_t i = 0; i < touched.size(); i++) {
+            vector<uint32_t>& recs = lists[touched[i].first].recs;
+            vector<uint32_t>::iterator mid = recs.begin() + touched[i].second;
+            sort(mid, recs.end(), timeLess);
+            if (mid != recs.begin() && timeLess(*mid, *(mid - 1))) {
+                inplace_merge(recs.begin(), mid, recs.end(), timeLess);
+            }
+        }
+        synced = to;
+    }
+
+    // Jumlah transaksi akun (sebagai pengirim atau penerima)
+    size_t count(const char* username) const {
+        const int* l = index.find(username);
+        return l ? lists[*l].recs.size() : 0;
+    }
+
+    /*
+     * Kunjungi maksimal limit transaksi akun, dari yang terbaru,
+     * melewati offset transaksi terbaru pertama. Return jumlah baris.
+     */
+    template <typename Fn>
+    size_t visitNewest(const char* username, size_t offset, size_t limit, Fn fn) const {
+        const int* l = index.find(username);
+        if (l == NULL) return 0;
+
+        const vector<uint32_t>& recs = lists[*l].recs;
+        size_t rows = 0;
+        for (size_t i = offset; i < recs.size() && rows < limit; i++, rows++) {
+            fn(store[recs[recs.size() - 1 - i]]);
+        }
+        return rows;
+    }
+
+    size_t accountCount() const { return lists.size(); }
+
+    size_t indexBytes() const {
+        size_t total = lists.capacity() * sizeof(AccountHistoryList) +
+                       index.capacity() * (sizeof(uint32_t) + sizeof(int));
+        for (size_t l = 0; l < lists.size(); l++) {
+            total += lists[l].recs.capacity() * sizeof(uint32_t);
+        }
+        return total;
+    }
+};
+
+#endif
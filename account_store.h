@@ -0,0 +1,322 @@
+#ifndef ACCOUNT_STORE_H
+#define ACCOUNT_STORE_H
+
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace std;
+
+// =================================================================
+// ACCOUNT STORE - Database Akun Biner (Memory-Mapped)
+// =================================================================
+/*
+ * FORMAT FILE users.dat
+ *
+ * [Header 512 byte][Record 0][Record 1]...[Record capacity-1]
+ *
+ * - Header berisi magic "EWACCT", versi format, ukuran record,
+ *   jumlah akun terisi (count) dan kapasitas file (capacity)
+ * - Setiap record berukuran TETAP 512 byte, sehingga record ke-i
+ *   selalu berada di offset 512 * (i + 1) dan tidak pernah melewati
+ *   batas page 4 KB
+ *
+ * KEUNTUNGAN DIBANDING users.txt:
+ * - Membuka + memvalidasi database = 1x mmap, tidak ada parsing teks
+ *   -> O(1). Catatan: FileHandler::loadUsers tetap menyalin setiap
+ *   record ke User (O(n), ~0.7 detik per 1 juta akun)
+ * - Mengubah saldo 1 user hanya menyentuh 1 page di disk
+ * - Tidak perlu menulis ulang seluruh file saat menyimpan
+ */
+const uint32_t ACCOUNT_STORE_VERSION = 1;
+const size_t ACCOUNT_PAGE_SIZE = 512;
+
+struct AccountStoreHeader {
+    char magic[8];          // "EWACCT\0\0"
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t count;         // Jumlah record terisi
+    uint64_t capacity;      // Jumlah slot record di file
+    char reserved[ACCOUNT_PAGE_SIZE - 32];
+};
+
+struct AccountRecord {
+    double saldo;
+    uint32_t flags;
+    char username[50];
+    char password[50];
+    char pin[7];
+    char nik[17];
+    char namaLengkap[100];
+    char alamat[200];
+    char tanggalLahir[11];
+    char reserved[ACCOUNT_PAGE_SIZE - 447];
+};
+
+static_assert(sizeof(AccountStoreHeader) == ACCOUNT_PAGE_SIZE, "Header harus 512 byte");
+static_assert(sizeof(AccountRecord) == ACCOUNT_PAGE_SIZE, "Record harus 512 byte");
+
+class AccountStore {
+private:
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mapHandle;
+#else
+    int fd;
+#endif
+    char* base;
+    size_t mappedSize;
+
+    AccountStoreHeader* header() const {
+        return (AccountStoreHeader*)base;
+    }
+
+    bool mapFile(size_t size) {
+#ifdef _WIN32
+        mapHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READWRITE, 0, 0, NULL);
+        if (mapHandle == NULL) return false;
+        base = (char*)MapViewOfFile(mapHandle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (base == NULL) {
+            CloseHandle(mapHandle);
+            mapHandle = NULL;
+            return false;
+        }
+#else
+        void* p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) return false;
+        base = (char*)p;
+#endif
+        mappedSize = size;
+        return true;
+    }
+
+    void unmapFile() {
+        if (base == NULL) return;
+#ifdef _WIN32
+        UnmapViewOfFile(base);
+        CloseHandle(mapHandle);
+        mapHandle = NULL;
+#else
+        munmap(base, mappedSize);
+#endif
+        base = NULL;
+        mappedSize = 0;
+    }
+
+    bool resizeFile(size_t size) {
+#ifdef _WIN32
+        LARGE_INTEGER li;
+        li.QuadPart = (LONGLONG)size;
+        return SetFilePointerEx(fileHandle, li, NULL, FILE_BEGIN) && SetEndOfFile(fileHandle);
+#else
+        return ftruncate(fd, (off_t)size) == 0;
+#endif
+    }
+
+    bool openFile(const char* path, bool create) {
+#ifdef _WIN32
+        fileHandle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                                 create ? CREATE_ALWAYS : OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL, NULL);
+        return fileHandle != INVALID_HANDLE_VALUE;
+#else
+        fd = ::open(path, create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+        return fd >= 0;
+#endif
+    }
+
+    size_t fileSize() const {
+#ifdef _WIN32
+        LARGE_INTEGER li;
+        if (!GetFileSizeEx(fileHandle, &li)) return 0;
+        return (size_t)li.QuadPart;
+#else
+        struct stat st;
+        if (fstat(fd, &st) != 0) return 0;
+        return (size_t)st.st_size;
+#endif
+    }
+
+    // Tambah kapasitas file secara geometris (x2) lalu mmap ulang
+    bool grow(uint64_t minCapacity) {
+        uint64_t newCapacity = header()->capacity ? header()->capacity : 16;
+        while (newCapacity < minCapacity) newCapacity *= 2;
+
+        size_t newSize = ACCOUNT_PAGE_SIZE * (size_t)(newCapacity + 1);
+        unmapFile();
+        if (!resizeFile(newSize) || !mapFile(newSize)) {
+            return false;
+        }
+        header()->capacity = newCapacity;
+        return true;
+    }
+
+public:
+    AccountStore() : base(NULL), mappedSize(0) {
+#ifdef _WIN32
+        fileHandle = INVALID_HANDLE_VALUE;
+        mapHandle = NULL;
+#else
+        fd = -1;
+#endif
+    }
+
+    ~AccountStore() {
+        close();
+    }
+
+    // Buka users.dat yang sudah ada. Gagal jika file tidak ada / rusak.
+    bool open(const char* path) {
+        close();
+        if (!openFile(path, false)) return false;
+
+        size_t size = fileSize();
+        if (size < ACCOUNT_PAGE_SIZE || !mapFile(size)) {
+            close();
+            return false;
+        }
+
+        AccountStoreHeader* h = header();
+        if (memcmp(h->magic, "EWACCT", 6) != 0 ||
+            h->version != ACCOUNT_STORE_VERSION ||
+            h->recordSize != sizeof(AccountRecord) ||
+            h->count > h->capacity ||
+            size < ACCOUNT_PAGE_SIZE * (size_t)(h->capacity + 1)) {
+            cout << "Error: Format users.dat tidak dikenali\n";
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    // Buat users.dat baru (kosong) dengan kapasitas awal
+    bool create(const char* path, uint64_t capacity) {
+        close();
+        if (capacity < 16) capacity = 16;
+        if (!openFile(path, true)) return false;
+
+        size_t size = ACCOUNT_PAGE_SIZE * (size_t)(capacity + 1);
+        if (!resizeFile(size) || !mapFile(size)) {
+            close();
+            return false;
+        }
+
+        AccountStoreHeader* h = header();
+        memset(h, 0, sizeof(AccountStoreHeader));
+        memcpy(h->magic, "EWACCT", 6);
+        h->version = ACCOUNT_STORE_VERSION;
+        h->recordSize = sizeof(AccountRecord);
+        h->count = 0;
+        h->capacity = capacity;
+        return true;
+    }
+
+    void close() {
+        unmapFile();
+#ifdef _WIN32
+        if (fileHandle != INVALID_HANDLE_VALUE) {
+            CloseHandle(fileHandle);
+            fileHandle = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+#endif
+    }
+
+    bool isOpen() const {
+        return base != NULL;
+    }
+
+    uint64_t getCount() const {
+        return base ? header()->count : 0;
+    }
+
+    AccountRecord* record(uint64_t idx) {
+        return (AccountRecord*)(base + ACCOUNT_PAGE_SIZE * (size_t)(idx + 1));
+    }
+
+    const AccountRecord* record(uint64_t idx) const {
+        return (const AccountRecord*)(base + ACCOUNT_PAGE_SIZE * (size_t)(idx + 1));
+    }
+
+    // Ubah jumlah record terisi, tambah kapasitas bila perlu
+    bool setCount(uint64_t count) {
+        if (count > header()->capacity && !grow(count)) {
+            cout << "Error: Tidak bisa memperbesar users.dat\n";
+            return false;
+        }
+        header()->count = count;
+        return true;
+    }
+
+    // Flush 1 record ke disk. msync butuh alamat kelipatan page OS,
+    // padahal record ke-i hanya sejajar 512 byte: alamat dibulatkan ke
+    // bawah ke awal page dan panjang diperluas sampai menutup record.
+    // FlushViewOfFile di Windows menerima alamat per byte.
+    bool syncRecord(uint64_t idx) {
+        char* p = (char*)record(idx);
+#ifdef _WIN32
+        if (!FlushViewOfFile(p, ACCOUNT_PAGE_SIZE)) {
+            cout << "Error: Gagal flush record users.dat (" << GetLastError() << ")\n";
+            return false;
+        }
+#else
+        static const size_t osPage = (size_t)sysconf(_SC_PAGESIZE);
+        size_t offset = (size_t)(p - base);
+        size_t start = offset - offset % osPage;
+        if (msync(base + start, offset + ACCOUNT_PAGE_SIZE - start, MS_SYNC) != 0) {
+            cout << "Error: Gagal flush record users.dat (errno " << errno << ")\n";
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    // Header selalu di offset 0, jadi sudah sejajar page
+    bool syncHeader() {
+#ifdef _WIN32
+        if (!FlushViewOfFile(base, ACCOUNT_PAGE_SIZE)) {
+            cout << "Error: Gagal flush header users.dat (" << GetLastError() << ")\n";
+            return false;
+        }
+#else
+        if (msync(base, ACCOUNT_PAGE_SIZE, MS_SYNC) != 0) {
+            cout << "Error: Gagal flush header users.dat (errno " << errno << ")\n";
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    // Flush seluruh mapping + metadata file (ukuran) ke disk. Dipakai
+    // sebelum file .tmp di-rename menjadi users.dat.
+    bool syncAll() {
+#ifdef _WIN32
+        if (!FlushViewOfFile(base, 0) || !FlushFileBuffers(fileHandle)) {
+            cout << "Error: Gagal flush users.dat (" << GetLastError() << ")\n";
+            return false;
+        }
+#else
+        if (msync(base, mappedSize, MS_SYNC) != 0 || fsync(fd) != 0) {
+            cout << "Error: Gagal flush users.dat (errno " << errno << ")\n";
+            return false;
+        }
+#endif
+        return true;
+    }
+};
+
+#endif
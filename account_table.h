@@ -0,0 +1,131 @@
+#ifndef ACCOUNT_TABLE_H
+#define ACCOUNT_TABLE_H
+
+#include <cstring>
+#include <cstdint>
+#include "user.h"
+#include "hash_index.h"
+
+using namespace std;
+
+// =================================================================
+// ACCOUNT TABLE - Tabel Akun Chunked dengan Alamat Stabil
+// =================================================================
+/*
+ * SEBELUMNYA: registrasi membuat array User[n+1] baru, menyalin semua
+ * akun, lalu menghapus array lama -> n registrasi = O(n^2), dan pointer
+ * User* yang sedang dipegang (mis. loggedUser) menjadi dangling.
+ *
+ * SEKARANG: akun disimpan dalam chunk yang ukurannya tumbuh geometris
+ *   chunk 0: 64 akun, chunk 1: 128 akun, chunk 2: 256 akun, ...
+ * - Chunk tidak pernah dipindah/disalin -> alamat User* dan slot stabil
+ * - Chunk baru dialokasi hanya saat chunk terakhir penuh
+ *   -> registrasi amortized O(1)
+ * - Slot -> (chunk, offset) dihitung dengan 1 instruksi bit scan
+ *
+ * Tabel juga memiliki hash index username -> slot (hash_index.h).
+ */
+const int ACCOUNT_FIRST_CHUNK_BITS = 6;     // Chunk pertama = 64 akun
+const int ACCOUNT_MAX_CHUNKS = 26;
+
+// Posisi bit tertinggi (v > 0)
+inline int highestBit(uint32_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31 - __builtin_clz(v);
+#else
+    int bit = 0;
+    while (v >>= 1) bit++;
+    return bit;
+#endif
+}
+
+class AccountTable;
+
+struct AccountNameOf {
+    const AccountTable* table;
+
+    string_view operator()(int slot) const;
+};
+
+class AccountTable {
+private:
+    User* chunks[ACCOUNT_MAX_CHUNKS];
+    int chunkCount;
+    int count;
+    HashIndex<int, AccountNameOf> index;
+
+    AccountTable(const AccountTable&);
+    AccountTable& operator=(const AccountTable&);
+
+    static int chunkSize(int chunk) {
+        return 1 << (ACCOUNT_FIRST_CHUNK_BITS + chunk);
+    }
+
+public:
+    AccountTable() : chunkCount(0), count(0), index(AccountNameOf{this}) {
+        memset(chunks, 0, sizeof(chunks));
+    }
+
+    ~AccountTable() {
+        for (int c = 0; c < chunkCount; c++) {
+            delete[] chunks[c];
+        }
+    }
+
+    int size() const { return count; }
+
+    // Slot -> User: chunk = bit tertinggi dari (slot / 64 + 1)
+    User& at(int slot) const {
+        uint32_t biased = (uint32_t)slot + (1u << ACCOUNT_FIRST_CHUNK_BITS);
+        int bit = highestBit(biased);
+        return chunks[bit - ACCOUNT_FIRST_CHUNK_BITS][biased - (1u << bit)];
+    }
+
+    User& operator[](int slot) const { return at(slot); }
+
+    /*
+     * Tambah akun di slot berikutnya. Return pointer stabil ke akun,
+     * atau NULL jika tabel penuh. Pemanggil memastikan username belum
+     * terdaftar (findSlot); slot selalu sama dengan urutan record di
+     * users.dat.
+     */
+    User* add(const User& user) {
+        int slot = count;
+        uint32_t biased = (uint32_t)slot + (1u << ACCOUNT_FIRST_CHUNK_BITS);
+        int chunk = highestBit(biased) - ACCOUNT_FIRST_CHUNK_BITS;
+        if (chunk >= chunkCount) {
+            if (chunk >= ACCOUNT_MAX_CHUNKS) return NULL;
+            chunks[chunk] = new User[chunkSize(chunk)];
+            chunkCount = chunk + 1;
+        }
+
+        User& target = at(slot);
+        target = user;
+        target.setSlot(slot);
+        count++;
+        index.insert(slot);
+        return &target;
+    }
+
+    // Siapkan kapasitas index untuk n akun (saat load massal)
+    void reserve(int n) {
+        index.reserve(n);
+    }
+
+    // Slot akun dengan username tertentu, -1 jika tidak ada
+    int findSlot(const char* username) const {
+        const int* slot = index.find(username);
+        return slot ? *slot : -1;
+    }
+
+    User* find(const char* username) const {
+        int slot = findSlot(username);
+        return slot >= 0 ? &at(slot) : NULL;
+    }
+};
+
+inline string_view AccountNameOf::operator()(int slot) const {
+    return table->at(slot).getUsername();
+}
+
+#endif
@@ -6,6 +6,12 @@
 #include <cstring>
 #include "user.h"
 #include "data_structures.h"
+#include "file_handler.h"
+#include "transaction_id_index.h"
+#include "time_index.h"
+#include "transaction_recorder.h"
+#include <map>
+#include <vector>
 
 using namespace std;
 
@@ -41,7 +47,8 @@ using namespace std;
  *    - Logika: Fair system - siapa cepat dia dilayani dulu
  * 
  * 3. AVL TREE (Self-Balancing BST):
- *    - Semua transaksi sistem disimpan di globalAVLTree (di main.cpp)
+ *    - Semua transaksi sistem di-index di globalTransactionIndex (di main.cpp),
+ *      AVL Tree secara default atau B+ Tree jika -DUSE_BPLUS_TREE
  *    - Admin dapat query transaksi berdasarkan rentang jumlah
  *    - AVL Tree menjaga balance otomatis -> pencarian O(log n)
  * 
@@ -103,8 +110,11 @@ public:
      * 
      * PARAMETER:
      * - refundStack: Reference ke Stack global (dari main.cpp)
-     * - users: Array user untuk update saldo jika approved
-     * - userCount: Jumlah user
+     * - accounts: Tabel akun, user dicari lewat hash index username
+     *   untuk update saldo jika approved
+     * - transactionIds: Index ID transaksi, request divalidasi ulang
+     *   (pemilik, jumlah, status refund) dalam O(1) sebelum approve
+     * - Refund yang disetujui dicatat sebagai transaksi "Refund"
      * 
      * ALUR KERJA:
      * 1. User mengalami transaksi gagal/error
@@ -119,7 +129,9 @@ public:
      * - User baru saja mengalami masalah -> butuh penanganan cepat
      * - Stack cocok untuk operasi "undo" atau "cancel terbaru"
      */
-    void processRefund(RefundStack& refundStack, User* users, int userCount) {
+    void processRefund(RefundStack& refundStack, AccountTable& accounts,
+                       TransactionIdIndex& transactionIds, TransactionRecorder& recorder,
+                       FileHandler& fileHandler) {
         cout << "\n      ========================================\n";
         cout << "      PROSES REFUND REQUEST (STACK - LIFO)\n";
         cout << "      ========================================\n";
@@ -150,22 +162,47 @@ public:
             cin >> approve;
             cin.ignore();
             
-            bool found = false;
-            for (int i = 0; i < userCount; i++) {
-                if (strcmp(users[i].getUsername(), req.username) == 0) {
-                    if (approve == 'y' || approve == 'Y') {
-                        users[i].addSaldo(req.jumlah);
-                        cout << "\n      [APPROVED] Refund Rp " << req.jumlah 
-                             << " berhasil dikembalikan ke " << req.username << "\n";
-                        cout << "      Saldo baru: Rp " << users[i].getSaldo() << "\n";
+            transactionIds.sync();
+            int64_t rec = transactionIds.findRec(req.transactionId);
+            User* target = accounts.find(req.username);
+            bool found = target != NULL;
+            if (found) {
+                if (approve == 'y' || approve == 'Y') {
+                    cout << "\n      ";
+                    if (transactionIds.validateRefund(req.username, req.transactionId, req.jumlah,
+                                                      REFUND_PENDING) < 0) {
+                        cout << "      [REJECTED] Refund request tidak valid.\n";
                     } else {
-                        cout << "\n      [REJECTED] Refund request ditolak.\n";
+                        // Alasan dipotong agar "Refund <id>: " selalu utuh di keterangan
+                        char note[KETERANGAN_MAX_LENGTH];
+                        int room = (int)sizeof(note) - 1 - (int)strlen(REFUND_NOTE_PREFIX)
+                                   - (int)strlen(req.transactionId) - 2;
+                        snprintf(note, sizeof(note), "%s%s: %.*s", REFUND_NOTE_PREFIX,
+                                 req.transactionId, room > 0 ? room : 0, req.alasan);
+                        Transaksi refund(REFUND_JENIS, req.jumlah, note, "System", req.username);
+                        
+                        // Jalur tulis yang sama dengan transaksi user: WAL + semua
+                        // index (transaksi asal -> sudah di-refund), baru saldo
+                        if (!recorder.record(refund, fileHandler)) {
+                            cout << "      [ERROR] Refund gagal disimpan, saldo tidak berubah.\n";
+                        } else {
+                            target->addSaldo(req.jumlah);
+                            cout << "[APPROVED] Refund Rp " << req.jumlah 
+                                 << " berhasil dikembalikan ke " << req.username << "\n";
+                            cout << "      Saldo baru: Rp " << target->getSaldo() << "\n";
+                            rec = -1;
+                        }
                     }
-                    found = true;
-                    break;
+                } else {
+                    cout << "\n      [REJECTED] Refund request ditolak.\n";
                 }
             }
             
+            // Request selesai tanpa refund -> transaksi boleh diajukan lagi
+            if (rec >= 0 && transactionIds.refundState((uint32_t)rec) == REFUND_PENDING) {
+                transactionIds.clearPending((uint32_t)rec);
+            }
+            
             if (!found) {
                 cout << "\n      Error: Username tidak ditemukan!\n";
             }
@@ -258,7 +295,7 @@ public:
      * LAPORAN TRANSAKSI DARI AVL TREE
      * 
      * PARAMETER:
-     * - avlTree: Reference ke AVL Tree global (dari main.cpp)
+     * - transactionIndex: Reference ke index transaksi global (dari main.cpp)
      * 
      * ALUR KERJA:
      * 1. Setiap transaksi user disimpan ke AVL Tree
@@ -277,19 +314,32 @@ public:
      * 2. Filter berdasarkan rentang jumlah (min-max)
      * 3. Visualisasi struktur tree
      * 4. Info statistik (tinggi, rotasi, balance factor)
+     * 5. Analitik arsip riwayat (format kolom)
+     * 6. Telusuri segmen log (zone map + bloom filter)
+     * 7. Ekspor transaksi per rentang jumlah ke file
      */
-    void viewTransactionReport(AVLTree& avlTree) {
+    void viewTransactionReport(TransactionIndex& transactionIndex, TransactionIdIndex& transactionIds,
+                               TransactionTimeIndex& timeIndex, FileHandler& fileHandler) {
         cout << "\n      ========================================\n";
         cout << "      LAPORAN TRANSAKSI SISTEM\n";
+#ifdef USE_BPLUS_TREE
+        cout << "      (B+ TREE - LEAF TERSAMBUNG)\n";
+#else
         cout << "      (AVL TREE - SELF-BALANCING BST)\n";
+#endif
         cout << "      ========================================\n";
         
         cout << "\n      Pilih jenis laporan:\n";
         cout << "      1. Lihat Semua Transaksi (Inorder)\n";
         cout << "      2. Filter Berdasarkan Rentang Jumlah\n";
-        cout << "      3. Visualisasi AVL Tree\n";
-        cout << "      4. Informasi AVL Tree (Statistik)\n";
-        cout << "      Pilih (1-4): ";
+        cout << "      3. Visualisasi " << TRANSACTION_INDEX_NAME << "\n";
+        cout << "      4. Informasi " << TRANSACTION_INDEX_NAME << " (Statistik)\n";
+        cout << "      5. Analitik Arsip Riwayat (Columnar)\n";
+        cout << "      6. Telusuri Segmen Log (Zone Map)\n";
+        cout << "      7. Ekspor Transaksi ke File\n";
+        cout << "      8. Cari Transaksi berdasarkan ID\n";
+        cout << "      9. Transaksi dalam Rentang Waktu\n";
+        cout << "      Pilih (1-9): ";
         
         int choice;
         if (!(cin >> choice)) {
@@ -301,18 +351,294 @@ public:
         
         if (choice == 1) {
             cout << "\n      === Semua Transaksi (Urut Berdasarkan Jumlah) ===\n";
-            avlTree.displayInorder();
+            browseTransactions(transactionIndex, -DBL_MAX, DBL_MAX);
             
         } else if (choice == 2) {
             double minVal, maxVal;
-            cout << "\n      Masukkan jumlah minimum: Rp ";
+            if (!readAmountRange(minVal, maxVal)) return;
+            
+            cout << "\n      === Transaksi Rp" << minVal << " - Rp" << maxVal << " ===\n";
+            browseTransactions(transactionIndex, minVal, maxVal);
+            
+#ifdef USE_BPLUS_TREE
+            cout << "\n      EFISIENSI PENCARIAN B+ TREE:\n";
+            cout << "      - 1x turun ke leaf pertama: O(log n) dengan sedikit level\n";
+            cout << "      - Hasil dibaca berurutan dari leaf yang tersambung\n";
+            cout << "      - Node lebar -> sedikit cache miss untuk data besar\n";
+#else
+            cout << "\n      EFISIENSI PENCARIAN AVL TREE:\n";
+            cout << "      - Kompleksitas: O(log n) - sangat cepat!\n";
+            cout << "      - Tree selalu seimbang (|Balance Factor| <= 1)\n";
+            cout << "      - Cocok untuk database dengan banyak query\n";
+#endif
+            
+        } else if (choice == 3) {
+            transactionIndex.visualize();
+            cout << "\n      Keterangan:\n";
+            cout << "      - Angka = Jumlah transaksi\n";
+#ifdef USE_BPLUS_TREE
+            cout << "      - Node = separator (key terkecil anak kanan)\n";
+            cout << "      - Leaf = rentang jumlah yang disimpan di leaf\n";
+#else
+            cout << "      - BF = Balance Factor (Height Left - Height Right)\n";
+            cout << "      - AVL Tree SELALU menjaga |BF| <= 1\n";
+#endif
+            
+        } else if (choice == 4) {
+            transactionIndex.displayInfo();
+            
+        } else if (choice == 5) {
+            const ColumnarArchive* archive = fileHandler.getArchive();
+            if (archive == NULL) {
+                cout << "\n      Arsip riwayat tidak tersedia (transactions.txt tidak ada).\n";
+                return;
+            }
+            viewArchiveAnalytics(*archive);
+            
+        } else if (choice == 6) {
+            searchLogSegments(fileHandler);
+            
+        } else if (choice == 7) {
+            exportTransactionReport(transactionIndex, fileHandler);
+            
+        } else if (choice == 8) {
+            lookupTransaction(transactionIds);
+            
+        } else if (choice == 9) {
+            browseTimeRange(timeIndex);
+        }
+    }
+    
+    // Baca 1 batas waktu: "DD/MM/YYYY" (awal/akhir hari) atau "DD/MM/YYYY HH:MM:SS"
+    bool readTimeBound(const char* prompt, bool endOfDay, int64_t& epoch) {
+        char input[40];
+        cout << prompt;
+        cin.getline(input, sizeof(input));
+        
+        char text[40];
+        if (strlen(input) == 10) {
+            snprintf(text, sizeof(text), "%s %s", input, endOfDay ? "23:59:59" : "00:00:00");
+        } else {
+            snprintf(text, sizeof(text), "%s", input);
+        }
+        if (!parseTimestamp(text, epoch)) {
+            cout << "      Format waktu tidak valid!\n";
+            return false;
+        }
+        return true;
+    }
+    
+    /*
+     * TRANSAKSI DALAM RENTANG WAKTU
+     * 1x binary search ke transaksi pertama >= dari, lalu dibaca berurutan
+     * per halaman; setiap halaman = O(ukuran halaman).
+     */
+    void browseTimeRange(TransactionTimeIndex& timeIndex) {
+        int64_t from, to;
+        cout << "\n      Format: DD/MM/YYYY atau DD/MM/YYYY HH:MM:SS\n";
+        if (!readTimeBound("      Dari   : ", false, from)) return;
+        if (!readTimeBound("      Sampai : ", true, to)) return;
+        
+        timeIndex.sync();
+        cout << "\n      Total: " << timeIndex.countInRange(from, to)
+             << " transaksi (" << REPORT_PAGE_SIZE << " per halaman, urut waktu)\n";
+        
+        size_t pos = timeIndex.lowerBound(from);
+        while (timeIndex.hasRow(pos, to)) {
+            cout << "\n";
+            timeIndex.visitFrom(pos, to, REPORT_PAGE_SIZE, [&](const TransaksiRecord& t) {
+                char waktu[20];
+                cout << "      " << setw(12) << left << t.id << " " << t.formatWaktu(waktu) << " ";
+                t.display();
+            });
+            if (!timeIndex.hasRow(pos, to)) break;
+            
+            cout << "      ENTER = lanjut, q = selesai: ";
+            char input[16];
+            if (!cin.getline(input, sizeof(input))) {
+                cin.clear();
+                cin.ignore(10000, '\n');
+                break;
+            }
+            if (strcmp(input, "q") == 0 || strcmp(input, "Q") == 0) break;
+        }
+    }
+    
+    // Cari 1 transaksi lewat hash index ID: O(1), tanpa menelusuri tree
+    void lookupTransaction(TransactionIdIndex& transactionIds) {
+        char id[20];
+        cout << "\n      Masukkan Transaction ID: ";
+        cin.getline(id, sizeof(id));
+        
+        transactionIds.sync();
+        int64_t rec = transactionIds.findRec(id);
+        if (rec < 0) {
+            cout << "\n      Transaksi " << id << " tidak ditemukan.\n";
+            return;
+        }
+        
+        const TransaksiRecord& t = *transactionIds.find(id);
+        cout << "\n      ID         : " << t.id << "\n";
+        char waktu[20];
+        cout << "      Waktu      : " << t.formatWaktu(waktu) << "\n";
+        cout << "      Jenis      : " << t.jenis << "\n";
+        cout << "      Dari       : " << t.dari << "\n";
+        cout << "      Ke         : " << t.ke << "\n";
+        cout << "      Jumlah     : Rp " << fixed << setprecision(2) << t.jumlah << "\n";
+        char keterangan[KETERANGAN_MAX_LENGTH];
+        cout << "      Keterangan : " << t.keteranganText(keterangan) << "\n";
+        cout << "      Refund     : "
+             << TransactionIdIndex::refundStateName(transactionIds.refundState((uint32_t)rec)) << "\n";
+    }
+    
+    // Baca rentang jumlah [min, max] dari input admin
+    bool readAmountRange(double& minVal, double& maxVal) {
+        cout << "\n      Masukkan jumlah minimum: Rp ";
+        if (!(cin >> minVal)) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            cout << "      Input tidak valid!\n";
+            return false;
+        }
+        cout << "      Masukkan jumlah maksimum: Rp ";
+        if (!(cin >> maxVal)) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            cout << "      Input tidak valid!\n";
+            return false;
+        }
+        cin.ignore();
+        return true;
+    }
+    
+    /*
+     * TAMPILKAN TRANSAKSI PER HALAMAN
+     * 20 baris per halaman lewat cursor index (transaction_report.h).
+     * Setelah setiap halaman ditampilkan token halaman berikutnya:
+     * ENTER = lanjut, q = selesai, atau ketik token untuk melompat
+     * (token bisa dicatat dan dipakai lagi di laporan berikutnya).
+     */
+    void browseTransactions(const TransactionIndex& transactionIndex, double minVal, double maxVal) {
+        if (transactionIndex.isEmpty()) {
+            cout << "      Tree kosong.\n";
+            return;
+        }
+        cout << "      Total: " << transactionIndex.countInRange(minVal, maxVal)
+             << " transaksi (" << REPORT_PAGE_SIZE << " per halaman)\n";
+        
+        PageToken token(minVal, 0);
+        while (true) {
+            bool hasMore;
+            writeTableHeader(cout);
+            writeTransactionPage(cout, transactionIndex, maxVal, token, REPORT_PAGE_SIZE, hasMore);
+            writeTableRule(cout);
+            if (!hasMore) break;
+            
+            char text[64];
+            token.format(text, sizeof(text));
+            cout << "      Token halaman berikutnya: " << text << "\n";
+            cout << "      ENTER = lanjut, q = selesai, atau ketik token: ";
+            
+            char input[64];
+            if (!cin.getline(input, sizeof(input))) {
+                cin.clear();
+                cin.ignore(10000, '\n');
+                break;
+            }
+            if (strcmp(input, "q") == 0 || strcmp(input, "Q") == 0) break;
+            if (input[0] != '\0') {
+                PageToken jump;
+                if (!jump.parse(input)) {
+                    cout << "      Token tidak valid, lanjut ke halaman berikutnya.\n";
+                } else if (indexKeyLess(jump.key, jump.rec, minVal, 0)) {
+                    token = PageToken(minVal, 0);
+                } else {
+                    token = jump;
+                }
+            }
+        }
+    }
+    
+    /*
+     * EKSPOR LAPORAN TRANSAKSI
+     * Semua transaksi di rentang jumlah ditulis ke laporan_transaksi.txt
+     * (format sama dengan transactions.txt, urut jumlah).
+     */
+    void exportTransactionReport(const TransactionIndex& transactionIndex, FileHandler& fileHandler) {
+        double minVal, maxVal;
+        if (!readAmountRange(minVal, maxVal)) return;
+        
+        const char* path = "laporan_transaksi.txt";
+        clock_t start = clock();
+        long long rows = fileHandler.exportTransactions(transactionIndex, minVal, maxVal, path);
+        if (rows < 0) return;
+        
+        cout << "\n      " << rows << " transaksi diekspor ke " << path << " ("
+             << fixed << setprecision(1) << 1000.0 * (clock() - start) / CLOCKS_PER_SEC << " ms)\n";
+    }
+    
+    /*
+     * TELUSURI SEGMEN LOG
+     * Setiap segmen punya zone map (min/max waktu & jumlah) dan bloom
+     * filter ID di footer-nya. Segmen yang pasti tidak cocok dilewati
+     * tanpa membaca isinya.
+     */
+    void searchLogSegments(FileHandler& fileHandler) {
+        cout << "\n      === Telusuri Segmen Log ===\n";
+        cout << "      Segmen tertutup: " << fileHandler.getSegmentCount()
+             << " (+ arsip lama + WAL aktif)\n";
+        cout << "      1. Rentang Waktu\n";
+        cout << "      2. Rentang Jumlah\n";
+        cout << "      3. Cari ID Transaksi\n";
+        cout << "      Pilih (1-3): ";
+        
+        int choice;
+        if (!(cin >> choice)) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            return;
+        }
+        cin.ignore();
+        
+        SegmentScanStats stats;
+        const uint64_t maxShown = 50;
+        auto show = [&](const Transaksi& t) {
+            if (stats.matches <= maxShown) {
+                char waktu[20];
+                cout << "      " << setw(12) << left << t.id << " " << t.formatWaktu(waktu) << " ";
+                t.display();
+            }
+        };
+        
+        if (choice == 1) {
+            char fromDate[20], toDate[20];
+            cout << "      Dari tanggal (DD/MM/YYYY): ";
+            cin.getline(fromDate, 20);
+            cout << "      Sampai tanggal (DD/MM/YYYY): ";
+            cin.getline(toDate, 20);
+            
+            char fromText[40], toText[40];
+            snprintf(fromText, sizeof(fromText), "%s 00:00:00", fromDate);
+            snprintf(toText, sizeof(toText), "%s 23:59:59", toDate);
+            int64_t from, to;
+            if (!parseTimestamp(fromText, from) || !parseTimestamp(toText, to)) {
+                cout << "      Format tanggal tidak valid!\n";
+                return;
+            }
+            
+            cout << "\n";
+            fileHandler.queryTimeRange(from, to, stats, show);
+            
+        } else if (choice == 2) {
+            double minVal, maxVal;
+            cout << "      Jumlah minimum: Rp ";
             if (!(cin >> minVal)) {
                 cin.clear();
                 cin.ignore(10000, '\n');
                 cout << "      Input tidak valid!\n";
                 return;
             }
-            cout << "      Masukkan jumlah maksimum: Rp ";
+            cout << "      Jumlah maksimum: Rp ";
             if (!(cin >> maxVal)) {
                 cin.clear();
                 cin.ignore(10000, '\n');
@@ -321,30 +647,114 @@ public:
             }
             cin.ignore();
             
-            cout << "\n      === Transaksi Rp" << minVal << " - Rp" << maxVal << " ===\n";
-            avlTree.searchByRange(minVal, maxVal);
-            
-            cout << "\n      EFISIENSI PENCARIAN AVL TREE:\n";
-            cout << "      - Kompleksitas: O(log n) - sangat cepat!\n";
-            cout << "      - Tree selalu seimbang (|Balance Factor| <= 1)\n";
-            cout << "      - Cocok untuk database dengan banyak query\n";
+            cout << "\n";
+            fileHandler.queryAmountRange(minVal, maxVal, stats, show);
             
         } else if (choice == 3) {
-            avlTree.visualize();
-            cout << "\n      Keterangan:\n";
-            cout << "      - Angka = Jumlah transaksi\n";
-            cout << "      - BF = Balance Factor (Height Left - Height Right)\n";
-            cout << "      - AVL Tree SELALU menjaga |BF| <= 1\n";
+            char id[20];
+            cout << "      ID Transaksi: ";
+            cin.getline(id, 20);
             
-        } else if (choice == 4) {
-            avlTree.displayInfo();
+            Transaksi t;
+            if (fileHandler.findTransaction(id, t, stats)) {
+                t.displayDetail();
+            } else {
+                cout << "      Transaksi " << id << " tidak ditemukan.\n";
+            }
+        } else {
+            return;
         }
+        
+        if (stats.matches > maxShown) {
+            cout << "      ... dan " << (stats.matches - maxShown) << " transaksi lainnya\n";
+        }
+        cout << "\n      Hasil          : " << stats.matches << " transaksi\n";
+        cout << "      Segmen dibaca  : " << (stats.segments - stats.skipped)
+             << " dari " << stats.segments << " (" << stats.skipped << " dilewati)\n";
+        cout << "      Baris diperiksa: " << stats.rowsScanned << "\n";
+    }
+    
+    /*
+     * ANALITIK ARSIP KOLOM
+     * Ringkasan per jenis hanya membaca kolom jenis + jumlah, dan
+     * keterangan terpopuler hanya membaca kolom keterangan. Kolom lain
+     * (id, waktu, dari, ke) tidak disentuh sama sekali.
+     */
+    void viewArchiveAnalytics(const ColumnarArchive& archive) {
+        uint64_t rows = archive.rowCount();
+        
+        cout << "\n      === Analitik Arsip Riwayat (transactions.col) ===\n";
+        cout << "      Jumlah baris        : " << rows << " transaksi\n";
+        cout << "      Ukuran teks asli    : " << archive.sourceSize() << " byte\n";
+        cout << "      Ukuran arsip kolom  : " << archive.fileSize() << " byte";
+        if (archive.fileSize() > 0) {
+            cout << " (" << fixed << setprecision(1)
+                 << (double)archive.sourceSize() / archive.fileSize() << "x lebih kecil)";
+        }
+        cout << "\n";
+        
+        // Per jenis: kode dictionary -> (jumlah transaksi, total nominal)
+        map<string_view, pair<uint64_t, double> > perJenis;
+        vector<uint64_t> jenisCount(archive.dictCount(COL_JENIS), 0);
+        vector<double> jenisTotal(archive.dictCount(COL_JENIS), 0);
+        for (uint64_t i = 0; i < rows; i++) {
+            uint32_t code = archive.code(COL_JENIS, i);
+            double amount = archive.jumlah(i);
+            if (code < jenisCount.size()) {
+                jenisCount[code]++;
+                jenisTotal[code] += amount;
+            } else {
+                pair<uint64_t, double>& agg = perJenis[archive.entry(COL_JENIS, code)];
+                agg.first++;
+                agg.second += amount;
+            }
+        }
+        for (uint32_t code = 0; code < jenisCount.size(); code++) {
+            pair<uint64_t, double>& agg = perJenis[archive.entry(COL_JENIS, code)];
+            agg.first += jenisCount[code];
+            agg.second += jenisTotal[code];
+        }
+        
+        cout << "\n      [Per Jenis] (kolom: jenis + jumlah = "
+             << (archive.columnSize(COL_JENIS) + archive.columnSize(COL_JUMLAH)) << " byte dibaca)\n";
+        for (auto it = perJenis.begin(); it != perJenis.end(); ++it) {
+            cout << "      " << setw(14) << left << string(it->first)
+                 << setw(8) << right << it->second.first << " transaksi   Rp "
+                 << fixed << setprecision(0) << it->second.second << "\n";
+        }
+        cout << left;
+        
+        // Keterangan terpopuler: cukup hitung kode dictionary
+        vector<uint64_t> ketCount(archive.dictCount(COL_KETERANGAN), 0);
+        uint64_t unique = 0;
+        for (uint64_t i = 0; i < rows; i++) {
+            uint32_t code = archive.code(COL_KETERANGAN, i);
+            if (code < ketCount.size()) {
+                ketCount[code]++;
+            } else {
+                unique++;
+            }
+        }
+        
+        vector<uint32_t> order(ketCount.size());
+        for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+        sort(order.begin(), order.end(),
+             [&](uint32_t a, uint32_t b) { return ketCount[a] > ketCount[b]; });
+        
+        cout << "\n      [Keterangan Terpopuler] (kolom: keterangan = "
+             << archive.columnSize(COL_KETERANGAN) << " byte dibaca)\n";
+        for (size_t i = 0; i < order.size() && i < 5; i++) {
+            cout << "      " << (i + 1) << ". " << string(archive.entry(COL_KETERANGAN, order[i]))
+                 << " (" << ketCount[order[i]] << "x)\n";
+        }
+        cout << "      Keterangan unik (overflow heap): " << unique << "\n";
     }
     
     // =================================================================
     // FITUR 4: LIHAT SEMUA USER
     // =================================================================
-    void viewAllUsers(User* users, int count) {
+    void viewAllUsers(AccountTable& accounts) {
+        int count = accounts.size();
         cout << "\n      ========================================\n";
         cout << "      DAFTAR SEMUA USER\n";
         cout << "      ========================================\n";
@@ -352,20 +762,52 @@ public:
         cout << "\n      Total User Terdaftar: " << count << "\n\n";
         
         for (int i = 0; i < count; i++) {
-            cout << "      [" << (i+1) << "] " << users[i].getUsername() << "\n";
-            cout << "          Saldo: Rp " << users[i].getSaldo() << "\n";
-            KTP ktp = users[i].getKTP();
+            cout << "      [" << (i+1) << "] " << accounts[i].getUsername() << "\n";
+            cout << "          Saldo: Rp " << accounts[i].getSaldo() << "\n";
+            KTP ktp = accounts[i].getKTP();
             cout << "          NIK  : " << ktp.nik << "\n";
             cout << "          Nama : " << ktp.namaLengkap << "\n";
             cout << "\n";
         }
     }
     
+    /*
+     * RINGKASAN JUMLAH TRANSAKSI (ORDER STATISTIC)
+     * Semua angka dihitung dari agregat count/sum di node index:
+     * setiap baris O(log n), tidak ada transaksi yang dikunjungi satu per satu.
+     */
+    void viewAmountStatistics(const TransactionIndex& transactionIndex) {
+        int total = transactionIndex.getNodeCount();
+        double sum = transactionIndex.sumInRange(-DBL_MAX, DBL_MAX);
+        
+        cout << "\n      === Ringkasan Jumlah Transaksi ===\n";
+        cout << fixed << setprecision(2);
+        cout << "      Total Nilai         : Rp " << sum << "\n";
+        cout << "      Rata-rata           : Rp " << sum / total << "\n";
+        cout << "      Terkecil            : Rp " << transactionIndex.kth(0)->jumlah << "\n";
+        cout << "      Median (P50)        : Rp " << transactionIndex.percentile(50) << "\n";
+        cout << "      Persentil 90        : Rp " << transactionIndex.percentile(90) << "\n";
+        cout << "      Persentil 99        : Rp " << transactionIndex.percentile(99) << "\n";
+        cout << "      Terbesar            : Rp " << transactionIndex.kth(total - 1)->jumlah << "\n";
+        
+        // Distribusi per rentang jumlah
+        const double bounds[] = {0, 100000, 1000000, 10000000, DBL_MAX};
+        const char* labels[] = {"< Rp 100rb", "Rp 100rb - 1jt", "Rp 1jt - 10jt", ">= Rp 10jt"};
+        cout << "\n      Rentang Jumlah        Transaksi      Total Nilai\n";
+        for (int i = 0; i < 4; i++) {
+            double lo = i == 0 ? -DBL_MAX : bounds[i];
+            double hi = nextafter(bounds[i + 1], -DBL_MAX);    // Batas atas eksklusif
+            cout << "      " << setw(18) << left << labels[i] << right
+                 << setw(13) << transactionIndex.countInRange(lo, hi)
+                 << "   Rp " << setw(14) << transactionIndex.sumInRange(lo, hi) << "\n";
+        }
+    }
+    
     // =================================================================
     // FITUR 5: STATISTIK SISTEM
     // =================================================================
     void viewSystemStatistics(RefundStack& refundStack, CSQueue& csQueue, 
-                              AVLTree& avlTree, int userCount) {
+                              TransactionIndex& transactionIndex, int userCount) {
         cout << "\n      ========================================\n";
         cout << "      STATISTIK SISTEM E-WALLET\n";
         cout << "      ========================================\n";
@@ -373,9 +815,10 @@ public:
         cout << "\n      === Pengguna ===\n";
         cout << "      Total User          : " << userCount << " user\n";
         
-        cout << "\n      === Transaksi (AVL Tree) ===\n";
-        if (!avlTree.isEmpty()) {
-            avlTree.displayInfo();
+        cout << "\n      === Transaksi (" << TRANSACTION_INDEX_NAME << ") ===\n";
+        if (!transactionIndex.isEmpty()) {
+            transactionIndex.displayInfo();
+            viewAmountStatistics(transactionIndex);
         } else {
             cout << "      Belum ada transaksi.\n";
         }
@@ -407,14 +850,18 @@ public:
  * Fungsi ini menerima REFERENCE ke semua struktur data global:
  * - refundStack: Stack untuk refund (LIFO)
  * - csQueue: Queue untuk customer service (FIFO)
- * - avlTree: AVL Tree untuk transaksi
- * - users: Array user untuk update saldo
+ * - transactionIndex: Index transaksi (AVL Tree / B+ Tree)
+ * - recorder: Jalur tulis transaksi baru (WAL + semua index), dipakai refund
+ * - accounts: Tabel akun (dengan hash index username) untuk update saldo
+ * - fileHandler: Akses arsip kolom dan segmen log untuk laporan
  * 
  * Admin TIDAK membuat struktur data baru, hanya mengakses yang sudah ada.
  * Perubahan yang dilakukan Admin langsung tersinkronisasi ke User.
  */
 void adminMenu(Admin* admin, RefundStack& refundStack, CSQueue& csQueue,
-               AVLTree& avlTree, User* users, int userCount) {
+               TransactionIndex& transactionIndex, TransactionIdIndex& transactionIds,
+               TransactionTimeIndex& timeIndex, TransactionRecorder& recorder,
+               AccountTable& accounts, FileHandler& fileHandler) {
     
     while (true) {
         // Clear screen
@@ -433,7 +880,7 @@ void adminMenu(Admin* admin, RefundStack& refundStack, CSQueue& csQueue,
         cout << "\n=== MENU UTAMA ===\n";
         cout << "1. Proses Refund Request (Stack - LIFO)\n";
         cout << "2. Proses Customer Service (Queue - FIFO)\n";
-        cout << "3. Lihat Laporan Transaksi (AVL Tree)\n";
+        cout << "3. Lihat Laporan Transaksi (" << TRANSACTION_INDEX_NAME << ")\n";
         cout << "4. Lihat Semua User\n";
         cout << "5. Statistik Sistem\n";
         cout << "6. Logout\n";
@@ -449,19 +896,19 @@ void adminMenu(Admin* admin, RefundStack& refundStack, CSQueue& csQueue,
         
         switch (choice) {
             case 1:
-                admin->processRefund(refundStack, users, userCount);
+                admin->processRefund(refundStack, accounts, transactionIds, recorder, fileHandler);
                 break;
             case 2:
                 admin->processCSTicket(csQueue);
                 break;
             case 3:
-                admin->viewTransactionReport(avlTree);
+                admin->viewTransactionReport(transactionIndex, transactionIds, timeIndex, fileHandler);
                 break;
             case 4:
-                admin->viewAllUsers(users, userCount);
+                admin->viewAllUsers(accounts);
                 break;
             case 5:
-                admin->viewSystemStatistics(refundStack, csQueue, avlTree, userCount);
+                admin->viewSystemStatistics(refundStack, csQueue, transactionIndex, accounts.size());
                 break;
             case 6:
                 cout << "\nLogout berhasil. Kembali ke menu login...\n";
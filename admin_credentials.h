@@ -0,0 +1,165 @@
+#ifndef ADMIN_CREDENTIALS_H
+#define ADMIN_CREDENTIALS_H
+
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <string_view>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "parallel_loader.h"
+#include "tokenizer.h"
+#include "hash_index.h"
+
+using namespace std;
+
+// =================================================================
+// ADMIN CREDENTIAL TABLE - Kredensial Admin di Memori
+// =================================================================
+/*
+ * SEBELUMNYA: setiap percobaan login membuka dan membaca admins.txt.
+ *
+ * SEKARANG:
+ * - admins.txt dibaca sekali ke HashIndex (open addressing, linear
+ *   probing) dengan key username
+ * - Setiap lookup hanya melakukan stat() pada file: jika mtime, inode
+ *   atau ukurannya berubah, tabel dimuat ulang
+ * - Lookup = O(1), tanpa open/scan file
+ */
+
+struct AdminCredential {
+    char username[50];
+    char password[50];
+    char adminID[20];
+};
+
+// Identitas versi file (berubah jika file diedit atau diganti)
+struct FileStamp {
+    bool exists;
+    int64_t mtime;
+    int64_t mtimeNsec;
+    uint64_t inode;
+    uint64_t size;
+
+    bool operator==(const FileStamp& other) const {
+        return exists == other.exists && mtime == other.mtime && mtimeNsec == other.mtimeNsec &&
+               inode == other.inode && size == other.size;
+    }
+};
+
+inline FileStamp statFile(const char* path) {
+    FileStamp stamp;
+    memset(&stamp, 0, sizeof(stamp));
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_stat64(path, &st) != 0) return stamp;
+    stamp.mtime = (int64_t)st.st_mtime;
+#else
+    struct stat st;
+    if (stat(path, &st) != 0) return stamp;
+    stamp.mtime = (int64_t)st.st_mtime;
+    stamp.inode = (uint64_t)st.st_ino;
+    #if defined(__APPLE__)
+        stamp.mtimeNsec = (int64_t)st.st_mtimespec.tv_nsec;
+    #else
+        stamp.mtimeNsec = (int64_t)st.st_mtim.tv_nsec;
+    #endif
+#endif
+    stamp.exists = true;
+    stamp.size = (uint64_t)st.st_size;
+    return stamp;
+}
+
+struct AdminNameOf {
+    const vector<AdminCredential>* entries;
+
+    string_view operator()(int e) const {
+        return (*entries)[e].username;
+    }
+};
+
+class AdminCredentialTable {
+private:
+    const char* path;
+    vector<AdminCredential> entries;
+    HashIndex<int, AdminNameOf> index;
+    FileStamp stamp;
+    bool loaded;
+
+    AdminCredentialTable(const AdminCredentialTable&);
+    AdminCredentialTable& operator=(const AdminCredentialTable&);
+
+    int findEntry(const char* username) const {
+        const int* e = index.find(username);
+        return e ? *e : -1;
+    }
+
+    void reload() {
+        entries.clear();
+
+        MappedFile file;
+        if (file.open(path)) {
+            RecordTokenizer tokenizer(file.data(), file.data() + file.size());
+            string_view f[3];
+            int n;
+
+            while ((n = tokenizer.nextRecord(f, 3)) >= 0) {
+                if (n < 3 || f[0].empty()) continue;
+
+                AdminCredential c;
+                copyField(c.username, sizeof(c.username), f[0]);
+                copyField(c.password, sizeof(c.password), f[1]);
+                copyField(c.adminID, sizeof(c.adminID), f[2]);
+                entries.push_back(c);
+            }
+        }
+
+        // Username ganda: yang pertama dipakai (insert berikutnya ditolak)
+        index.clear();
+        index.reserve(entries.size());
+        for (size_t e = 0; e < entries.size(); e++) {
+            index.insert((int)e);
+        }
+    }
+
+public:
+    AdminCredentialTable() : path(NULL), index(AdminNameOf{&entries}), loaded(false) {
+        memset(&stamp, 0, sizeof(stamp));
+    }
+
+    void setFile(const char* file) {
+        path = file;
+        loaded = false;
+    }
+
+    // Muat ulang jika admins.txt berubah sejak terakhir dibaca
+    void refreshIfChanged() {
+        FileStamp current = statFile(path);
+        if (loaded && current == stamp) return;
+
+        reload();
+        stamp = current;
+        loaded = true;
+    }
+
+    bool authenticate(const char* username, const char* password, char* adminID) {
+        refreshIfChanged();
+        int e = findEntry(username);
+        if (e < 0 || strcmp(entries[e].password, password) != 0) {
+            return false;
+        }
+        strcpy(adminID, entries[e].adminID);
+        return true;
+    }
+
+    bool contains(const char* username) {
+        refreshIfChanged();
+        return findEntry(username) >= 0;
+    }
+
+    int count() const {
+        return (int)entries.size();
+    }
+};
+
+#endif
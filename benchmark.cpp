@@ -0,0 +1,1640 @@
+// =================================================================
+// BENCHMARK E-WALLET - Pengukuran Performa Struktur Data & Loader
+// =================================================================
+/*
+ * KOMPILASI:
+ *   g++ -std=c++17 -O2 -pthread benchmark.cpp -o benchmark
+ *   (tambahkan -mavx2 untuk mengaktifkan jalur AVX2)
+ *
+ * PEMAKAIAN:
+ *   ./benchmark                     : jalankan semua benchmark
+ *   ./benchmark tokenizer [file]    : throughput parsing field "|" (GB/s)
+ *   ./benchmark archive [file]      : ukuran & kecepatan scan arsip kolom
+ *   ./benchmark hashindex [maxN]    : lookup username, 20 s/d 10 juta akun
+ *   ./benchmark accounts            : biaya registrasi (array copy vs AccountTable)
+ *   ./benchmark pool [n]            : jumlah alokasi & RSS, new per node vs NodePool
+ *   ./benchmark index [n]           : ukuran node AVL ramping & range query
+ *   ./benchmark tree [n]            : AVL Tree vs B+ Tree (1 juta, atau n mis. 100000000)
+ *   ./benchmark report [n]          : laporan lewat cursor, flush per baris vs stream
+ *   ./benchmark history [n]         : riwayat 1 akun, scan semua transaksi vs index akun
+ *   ./benchmark timerange [n]       : transaksi 1 hari, scan semua vs index waktu
+ *   ./benchmark clock [n]           : constructor Transaksi, localtime+sprintf vs TransactionClock
+ *   ./benchmark huffman [file]      : round trip & decode MB/s, bit demi bit vs tabel lookup
+ *   ./benchmark model [file]        : kompresi keterangan, pohon per transaksi vs model bersama
+ *   ./benchmark keterangan [n]      : RSS record transaksi, char[200] vs arena Huffman (mis. 10000000)
+ *   ./benchmark blockzip [file]     : kompresi file per blok, paralel & akses acak vs 1 stream
+ *   ./benchmark codec [file]        : rasio & MB/s per kolom: stored, huffman, lz-dict, rans
+ */
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <vector>
+#include <string>
+
+#include "tokenizer.h"
+#include "parallel_loader.h"
+#include "file_handler.h"
+#include "hash_index.h"
+#include "node_pool.h"
+#include "bplus_tree.h"
+#include "account_history.h"
+#include "time_index.h"
+#include "huffman_model.h"
+#include "block_compressor.h"
+
+using namespace std;
+
+// Hitung panggilan operator new (untuk benchmark alokasi)
+// noinline: malloc/free yang di-inline ke pemanggil membuat GCC salah
+// mendeteksi pasangan alokasi (-Wmismatched-new-delete)
+#if defined(__GNUC__) || defined(__clang__)
+    #define BENCH_NOINLINE __attribute__((noinline))
+#else
+    #define BENCH_NOINLINE
+#endif
+
+static size_t newCalls = 0;
+
+BENCH_NOINLINE void* operator new(size_t size) {
+    newCalls++;
+    void* p = malloc(size ? size : 1);
+    if (p == NULL) throw bad_alloc();
+    return p;
+}
+
+BENCH_NOINLINE void operator delete(void* p) noexcept { free(p); }
+BENCH_NOINLINE void operator delete(void* p, size_t) noexcept { free(p); }
+
+// =================================================================
+// UTILITY
+// =================================================================
+double nowSeconds() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Data transaksi sintetis dengan format yang sama seperti transactions.txt
+void generateTransactions(string& out, int rows) {
+    const char* jenis[] = {"Top Up", "Transfer", "Pembayaran"};
+    const char* keterangan[] = {
+        "Top up via Bank BCA", "Transfer ke user lain", "Pembayaran Listrik PLN",
+        "Pembayaran PDAM", "Top up via Indomaret", "Pembayaran Pulsa Telkomsel",
+        "Transfer antar user", "Pembayaran Internet"
+    };
+
+    srand(42);
+    char line[256];
+    out.clear();
+    out.reserve((size_t)rows * 90);
+    for (int i = 0; i < rows; i++) {
+        int len = snprintf(line, sizeof(line), "TRX%d|%02d/12/2025 %02d:%02d:%02d|%s|user%d|user%d|%d|%s\n",
+                           1000 + i, 1 + rand() % 28, rand() % 24, rand() % 60, rand() % 60,
+                           jenis[rand() % 3], 1 + rand() % 20, 1 + rand() % 20,
+                           10000 + rand() % 1000000, keterangan[rand() % 8]);
+        out.append(line, len);
+    }
+}
+
+// Muat file ke string, atau data sintetis jika path kosong
+bool loadCorpus(const char* path, string& corpus, int syntheticRows) {
+    if (path == NULL) {
+        generateTransactions(corpus, syntheticRows);
+        return true;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        cout << "Error: Tidak bisa membuka " << path << "\n";
+        return false;
+    }
+    corpus.assign(file.data(), file.size());
+    return true;
+}
+
+void printThroughput(const char* label, size_t bytes, double seconds, double checksum) {
+    cout << "  " << setw(28) << left << label
+         << setw(8) << right << fixed << setprecision(2) << (bytes / seconds / 1e9) << " GB/s"
+         << "   (checksum " << setprecision(0) << checksum << ")\n";
+}
+
+// =================================================================
+// BENCHMARK 1: TOKENIZER
+// =================================================================
+template <typename FindFn>
+double scanDelimiters(const string& corpus, FindFn find) {
+    const char* p = corpus.data();
+    const char* end = p + corpus.size();
+    double count = 0;
+    while (p < end) {
+        p = find(p, end);
+        if (p < end) {
+            count++;
+            p++;
+        }
+    }
+    return count;
+}
+
+double tokenizeAndParse(const string& corpus) {
+    RecordTokenizer tokenizer(corpus.data(), corpus.data() + corpus.size());
+    string_view f[7];
+    double total = 0;
+    int n;
+    while ((n = tokenizer.nextRecord(f, 7)) >= 0) {
+        double amount;
+        if (n >= 6 && parseDouble(f[5], amount)) total += amount;
+    }
+    return total;
+}
+
+double strtokAndAtof(string& copy) {
+    double total = 0;
+    char* line = strtok(&copy[0], "\n");
+    vector<char*> lines;
+    while (line) {
+        lines.push_back(line);
+        line = strtok(NULL, "\n");
+    }
+    for (size_t i = 0; i < lines.size(); i++) {
+        char* token = strtok(lines[i], "|");
+        for (int k = 0; k < 5 && token; k++) token = strtok(NULL, "|");
+        if (token) total += atof(token);
+    }
+    return total;
+}
+
+template <typename Fn>
+double bestOf(Fn fn, double& checksum) {
+    double best = 1e30;
+    for (int rep = 0; rep < 5; rep++) {
+        double start = nowSeconds();
+        checksum = fn();
+        double elapsed = nowSeconds() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+template <typename Fn>
+void timeBest(const char* label, size_t bytes, Fn fn) {
+    double checksum = 0;
+    double best = bestOf(fn, checksum);
+    printThroughput(label, bytes, best, checksum);
+}
+
+// Sama seperti timeBest, tapi dalam juta baris per detik
+template <typename Fn>
+void timeRows(const char* label, size_t rows, Fn fn) {
+    double checksum = 0;
+    double best = bestOf(fn, checksum);
+    cout << "  " << setw(28) << left << label
+         << setw(8) << right << fixed << setprecision(1) << (rows / best / 1e6) << " M baris/s"
+         << "   (checksum " << setprecision(0) << checksum << ")\n";
+}
+
+void benchTokenizer(const char* path) {
+    string corpus;
+    if (!loadCorpus(path, corpus, 1000000)) return;
+
+    cout << "\n=== BENCHMARK TOKENIZER ===\n";
+    cout << "  Data   : " << (path ? path : "sintetis 1.000.000 baris") << "\n";
+    cout << "  Ukuran : " << corpus.size() / 1024 / 1024 << " MB\n";
+    cout << "  Mode   : " << tokenizerMode() << " (dipakai oleh loader)\n\n";
+
+    cout << "  [Scan delimiter '|' dan '\\n']\n";
+    timeBest("Scalar", corpus.size(), [&]() { return scanDelimiters(corpus, findDelimiterScalar); });
+#ifdef __SSE2__
+    timeBest("SSE2 (16 byte)", corpus.size(), [&]() { return scanDelimiters(corpus, findDelimiterSSE2); });
+#endif
+#ifdef __AVX2__
+    timeBest("AVX2 (32 byte)", corpus.size(), [&]() { return scanDelimiters(corpus, findDelimiterAVX2); });
+#endif
+
+    cout << "\n  [Parse record + jumlah]\n";
+    timeBest("strtok + atof (lama)", corpus.size(), [&]() {
+        string copy = corpus;
+        return strtokAndAtof(copy);
+    });
+    timeBest("RecordTokenizer + from_chars", corpus.size(), [&]() { return tokenizeAndParse(corpus); });
+}
+
+// =================================================================
+// BENCHMARK 2: ARSIP KOLOM
+// =================================================================
+void benchArchive(const char* path) {
+    string corpus;
+    if (!loadCorpus(path, corpus, 1000000)) return;
+
+    vector<Transaksi> rows;
+    FileHandler::parseTransactionChunk(corpus.data(), corpus.data() + corpus.size(), rows);
+    vector<const Transaksi*> ptrs(rows.size());
+    for (size_t i = 0; i < rows.size(); i++) ptrs[i] = &rows[i];
+
+    const char* archivePath = "benchmark.col";
+    double start = nowSeconds();
+    ColumnarWriter writer;
+    if (!writer.write(archivePath, ptrs.data(), ptrs.size(), corpus.size())) {
+        cout << "Error: Tidak bisa menulis " << archivePath << "\n";
+        return;
+    }
+    double buildTime = nowSeconds() - start;
+
+    ColumnarArchive archive;
+    if (!archive.open(archivePath)) return;
+
+    cout << "\n=== BENCHMARK ARSIP KOLOM ===\n";
+    cout << "  Baris        : " << archive.rowCount() << "\n";
+    cout << "  Teks         : " << corpus.size() / 1024 << " KB\n";
+    cout << "  Arsip        : " << archive.fileSize() / 1024 << " KB ("
+         << fixed << setprecision(1) << (double)corpus.size() / archive.fileSize() << "x lebih kecil)\n";
+    cout << "  Struct array : " << rows.size() * sizeof(Transaksi) / 1024 << " KB\n";
+    cout << "  Waktu build  : " << setprecision(3) << buildTime << " s\n";
+
+    const char* names[] = {"id", "waktu", "jumlah", "jenis", "dari", "ke", "keterangan"};
+    for (int col = 0; col < COL_COUNT; col++) {
+        cout << "    kolom " << setw(11) << left << names[col] << right
+             << setw(10) << archive.columnSize(col) << " byte\n";
+    }
+
+    // Verifikasi round-trip
+    size_t mismatch = 0;
+    for (size_t i = 0; i < rows.size(); i++) {
+        Transaksi t;
+        archive.row(i, t);
+        if (strcmp(t.id, rows[i].id) != 0 || t.waktu != rows[i].waktu ||
+            strcmp(t.jenis, rows[i].jenis) != 0 || strcmp(t.dari, rows[i].dari) != 0 ||
+            strcmp(t.ke, rows[i].ke) != 0 || strcmp(t.keterangan, rows[i].keterangan) != 0 ||
+            t.jumlah != rows[i].jumlah) {
+            mismatch++;
+        }
+    }
+    cout << "  Round-trip   : " << (mismatch == 0 ? "OK" : "GAGAL") << " (" << mismatch << " baris beda)\n\n";
+
+    uint32_t firstJenis = archive.code(COL_JENIS, 0);
+    timeRows("Kolom jumlah + jenis", rows.size(), [&]() {
+        double total = 0;
+        for (uint64_t i = 0; i < archive.rowCount(); i++) {
+            if (archive.code(COL_JENIS, i) == firstJenis) total += archive.jumlah(i);
+        }
+        return total;
+    });
+    timeRows("Array Transaksi (struct)", rows.size(), [&]() {
+        double total = 0;
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (strcmp(rows[i].jenis, rows[0].jenis) == 0) total += rows[i].jumlah;
+        }
+        return total;
+    });
+
+    archive.close();
+    remove(archivePath);
+}
+
+// =================================================================
+// BENCHMARK 3: HASH INDEX USERNAME
+// =================================================================
+struct BenchName {
+    char name[24];
+};
+
+struct BenchNameOf {
+    const vector<BenchName>* names;
+
+    string_view operator()(int slot) const {
+        return (*names)[slot].name;
+    }
+};
+
+void benchHashIndex(const char* arg) {
+    long maxN = arg ? atol(arg) : 10000000;
+    const long sizes[] = {20, 1000, 100000, 1000000, 10000000};
+    const int lookups = 1000000;
+
+    cout << "\n=== BENCHMARK HASH INDEX USERNAME ===\n";
+    cout << "  " << setw(10) << right << "Akun" << setw(16) << "Hash (ns)"
+         << setw(18) << "Linear (ns)" << setw(14) << "Load factor" << "\n";
+
+    for (int s = 0; s < 5 && sizes[s] <= maxN; s++) {
+        long n = sizes[s];
+        vector<BenchName> names(n);
+        for (long i = 0; i < n; i++) {
+            snprintf(names[i].name, sizeof(names[i].name), "user%ld", i + 1);
+        }
+
+        HashIndex<int, BenchNameOf> index(BenchNameOf{&names});
+        for (long i = 0; i < n; i++) index.insert((int)i);
+
+        // Query acak (sudah disiapkan agar tidak ikut terukur)
+        vector<int> queries(lookups);
+        srand(7);
+        for (int i = 0; i < lookups; i++) {
+            queries[i] = (int)(((long)rand() * RAND_MAX + rand()) % n);
+        }
+
+        double checksum = 0;
+        double hashTime = bestOf([&]() {
+            double sum = 0;
+            for (int i = 0; i < lookups; i++) {
+                const int* slot = index.find(names[queries[i]].name);
+                if (slot) sum += *slot;
+            }
+            return sum;
+        }, checksum);
+
+        // Scan linear strcmp (cara lama), dibatasi agar tetap cepat
+        double linearNs = -1;
+        if (n <= 100000) {
+            int linearLookups = n <= 1000 ? lookups : 2000;
+            double start = nowSeconds();
+            double sum = 0;
+            for (int i = 0; i < linearLookups; i++) {
+                const char* target = names[queries[i]].name;
+                for (long k = 0; k < n; k++) {
+                    if (strcmp(names[k].name, target) == 0) {
+                        sum += k;
+                        break;
+                    }
+                }
+            }
+            linearNs = (nowSeconds() - start) / linearLookups * 1e9;
+            volatile double sink = sum;
+            (void)sink;
+        }
+
+        cout << "  " << setw(10) << n << setw(16) << fixed << setprecision(1) << hashTime / lookups * 1e9;
+        if (linearNs >= 0) {
+            cout << setw(18) << linearNs;
+        } else {
+            cout << setw(18) << "-";
+        }
+        cout << setw(14) << setprecision(2) << (double)index.size() / index.capacity() << "\n";
+    }
+}
+
+// =================================================================
+// BENCHMARK 4: REGISTRASI AKUN
+// =================================================================
+// Cara lama: alokasi array n+1, salin semua akun, hapus array lama
+double registerByCopy(int n) {
+    User* users = NULL;
+    int count = 0;
+    char name[32];
+    double start = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        User* grown = new User[count + 1];
+        for (int k = 0; k < count; k++) grown[k] = users[k];
+        snprintf(name, sizeof(name), "user%d", i);
+        grown[count] = User(name, "secret1", "123456", 0.0);
+        delete[] users;
+        users = grown;
+        count++;
+    }
+    double elapsed = nowSeconds() - start;
+    delete[] users;
+    return elapsed;
+}
+
+double registerByTable(int n) {
+    AccountTable accounts;
+    char name[32];
+    double start = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        snprintf(name, sizeof(name), "user%d", i);
+        accounts.add(User(name, "secret1", "123456", 0.0));
+    }
+    return nowSeconds() - start;
+}
+
+void benchAccounts() {
+    const int sizes[] = {1000, 5000, 20000, 1000000};
+
+    cout << "\n=== BENCHMARK REGISTRASI AKUN ===\n";
+    cout << "  " << setw(10) << right << "Akun" << setw(22) << "Array copy (us/akun)"
+         << setw(24) << "AccountTable (us/akun)" << "\n";
+
+    for (int s = 0; s < 4; s++) {
+        int n = sizes[s];
+        cout << "  " << setw(10) << n << fixed << setprecision(3);
+        if (n <= 20000) {
+            cout << setw(22) << registerByCopy(n) / n * 1e6;
+        } else {
+            cout << setw(22) << "-";
+        }
+        cout << setw(24) << registerByTable(n) / n * 1e6 << "\n";
+    }
+}
+
+// =================================================================
+// BENCHMARK 5: NODE POOL
+// =================================================================
+// Resident set size proses saat ini (KB), 0 jika tidak didukung
+size_t rssKB() {
+#ifdef __linux__
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (f == NULL) return 0;
+    unsigned long pages = 0, resident = 0;
+    if (fscanf(f, "%lu %lu", &pages, &resident) != 2) resident = 0;
+    fclose(f);
+    return resident * (size_t)sysconf(_SC_PAGESIZE) / 1024;
+#else
+    return 0;
+#endif
+}
+
+void fillTransaksi(Transaksi& t, int i) {
+    snprintf(t.id, sizeof(t.id), "TRX%d", 1000 + i);
+    t.waktu = 1764583200;   // 01/12/2025 10:00:00
+    strcpy(t.jenis, "Transfer");
+    strcpy(t.dari, "user1");
+    strcpy(t.ke, "user2");
+    t.jumlah = 10000 + rand() % 1000000;
+    strcpy(t.keterangan, "Transfer antar user");
+}
+
+// Jalankan 1 mode di proses ini: "new" (cara lama) atau "slab" (NodePool)
+void benchPoolMode(const string& mode, int n) {
+    Transaksi t;
+    size_t rssBefore = rssKB();
+    size_t callsBefore = newCalls;
+    srand(11);
+
+    double start = nowSeconds();
+    AVLNode* head = NULL;
+    NodePool<AVLNode> pool;
+    for (int i = 0; i < n; i++) {
+        fillTransaksi(t, i);
+        AVLNode* node = mode == "new" ? new AVLNode(t.jumlah, (uint32_t)i)
+                                      : pool.create(t.jumlah, (uint32_t)i);
+        node->left = head;
+        head = node;
+    }
+    double allocTime = nowSeconds() - start;
+    size_t calls = newCalls - callsBefore + pool.blockCount();
+    size_t rssAfter = rssKB();
+
+    // Telusuri semua node (mengukur lokalitas memori)
+    start = nowSeconds();
+    double sum = 0;
+    for (AVLNode* node = head; node != NULL; node = node->left) sum += node->key;
+    double walkTime = nowSeconds() - start;
+
+    start = nowSeconds();
+    if (mode == "new") {
+        while (head != NULL) {
+            AVLNode* next = head->left;
+            delete head;
+            head = next;
+        }
+    } else {
+        pool.releaseAll();
+    }
+    double freeTime = nowSeconds() - start;
+
+    cout << "  " << setw(6) << left << mode << right
+         << setw(12) << calls
+         << setw(12) << (rssAfter - rssBefore) / 1024 << " MB"
+         << setw(10) << fixed << setprecision(1) << allocTime * 1000 << " ms"
+         << setw(10) << walkTime * 1000 << " ms"
+         << setw(10) << freeTime * 1000 << " ms"
+         << "   (checksum " << setprecision(0) << sum << ")\n";
+}
+
+void benchPool(const char* self, const char* arg) {
+    int n = arg ? atoi(arg) : 1000000;
+
+    cout << "\n=== BENCHMARK NODE POOL (" << n << " AVLNode) ===\n";
+    cout << "  " << setw(6) << left << "Mode" << right << setw(12) << "Alokasi"
+         << setw(15) << "RSS" << setw(13) << "Alokasi" << setw(13) << "Telusur"
+         << setw(13) << "Bebaskan" << "\n";
+    cout.flush();
+
+    // Setiap mode dijalankan di proses terpisah agar RSS tidak tercampur
+    const char* modes[] = {"new", "slab"};
+    for (int m = 0; m < 2; m++) {
+        char command[600];
+        snprintf(command, sizeof(command), "\"%s\" pool-mode %s %d", self, modes[m], n);
+        if (system(command) != 0) {
+            cout << "Error: Gagal menjalankan mode " << modes[m] << "\n";
+        }
+    }
+
+    // Pemakaian nyata: AVLTree dengan pool
+    TransactionStore store;
+    AVLTree tree(store);
+    Transaksi t;
+    srand(11);
+    size_t callsBefore = newCalls;
+    double start = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        fillTransaksi(t, i);
+        tree.insert(t);
+    }
+    cout << "\n  AVLTree.insert x" << n << ": " << fixed << setprecision(1)
+         << (nowSeconds() - start) * 1000 << " ms, operator new dipanggil "
+         << (newCalls - callsBefore) << "x\n";
+}
+
+// =================================================================
+// BENCHMARK 6: INDEX AVL RAMPING
+// =================================================================
+// Tata letak node lama (Transaksi utuh di dalam node), hanya untuk ukuran
+struct FatAVLNode {
+    Transaksi data;
+    FatAVLNode* left;
+    FatAVLNode* right;
+    int height;
+};
+
+void benchIndex(const char* arg) {
+    int n = arg ? atoi(arg) : 1000000;
+
+    cout << "\n=== BENCHMARK INDEX AVL (" << n << " transaksi) ===\n";
+    cout << "  Node lama (Transaksi di node)  : " << sizeof(FatAVLNode) << " byte\n";
+    cout << "  Node baru (key + rec + agregat): " << sizeof(AVLNode) << " byte ("
+         << fixed << setprecision(1) << (double)sizeof(FatAVLNode) / sizeof(AVLNode)
+         << "x lebih kecil)\n";
+
+    TransactionStore store;
+    AVLTree tree(store);
+    Transaksi t;
+    srand(11);
+    double start = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        fillTransaksi(t, i);
+        tree.insert(t);
+    }
+    cout << "  Insert                         : " << (nowSeconds() - start) * 1000 << " ms\n";
+    cout << "  Store                          : " << store.reservedBytes() / (1024 * 1024)
+         << " MB (" << sizeof(TransaksiRecord) << " byte/record + "
+         << keteranganArena().reservedBytes() / (1024 * 1024) << " MB arena keterangan)\n";
+
+    // Range query sempit: hanya node di jalur pencarian + yang cocok yang dibaca
+    const int queries = 10000;
+    volatile double sink = 0;
+    uint64_t matches = 0;
+    srand(12);
+    start = nowSeconds();
+    for (int q = 0; q < queries; q++) {
+        double lo = 10000 + rand() % 1000000;
+        tree.forEachInRange(lo, lo + 50, [&](const TransaksiRecord& row) {
+            sink = sink + row.jumlah;
+            matches++;
+        });
+    }
+    double elapsed = nowSeconds() - start;
+    cout << "  Range query x" << queries << "             : " << elapsed * 1000 << " ms ("
+         << setprecision(2) << elapsed / queries * 1e6 << " us/query, "
+         << matches << " cocok)\n";
+}
+
+// =================================================================
+// BENCHMARK 7: AVL TREE vs B+ TREE
+// =================================================================
+// Index saja (key + nomor record sintetis), tanpa record di store,
+// agar 100 juta entry muat di memori
+template <typename Tree>
+void benchTreeMode(const char* mode, int n) {
+    TransactionStore store;
+    Tree tree(store);
+    size_t rssBefore = rssKB();
+
+    uint64_t state = 88172645463325252ULL;
+    double start = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        tree.insertRecord((uint32_t)i, (double)(10000 + state % 10000000));
+    }
+    double insertTime = nowSeconds() - start;
+    size_t rssAfter = rssKB();
+
+    // Range query sempit (~10 hasil per query untuk 1 juta entry)
+    const int queries = 100000;
+    double width = 10000000.0 * 10 / n;
+    uint64_t matches = 0, checksum = 0;
+    srand(12);
+    start = nowSeconds();
+    for (int q = 0; q < queries; q++) {
+        double lo = 10000 + (double)(((uint64_t)rand() << 16) ^ rand()) * 10000000 / ((uint64_t)RAND_MAX << 16);
+        tree.forEachRecInRange(lo, lo + width, [&](uint32_t rec) {
+            matches++;
+            checksum += rec;
+        });
+    }
+    double rangeTime = nowSeconds() - start;
+
+    // Range lebar: 10% data
+    start = nowSeconds();
+    uint64_t wide = 0;
+    tree.forEachRecInRange(5000000, 6000000, [&](uint32_t rec) { wide += rec; });
+    double wideTime = nowSeconds() - start;
+
+    // Order statistic: count/sum 10% data tanpa menelusuri hasilnya
+    const int statQueries = 100000;
+    uint64_t wideCount = 0;
+    double wideSum = 0;
+    start = nowSeconds();
+    for (int q = 0; q < statQueries; q++) {
+        double lo = 10000 + q * 40.0;
+        wideCount += tree.countInRange(lo, lo + 1000000);
+        wideSum += tree.sumInRange(lo, lo + 1000000);
+    }
+    double statTime = nowSeconds() - start;
+
+    cout << "  " << setw(6) << left << mode << right
+         << setw(7) << tree.getHeight()
+         << setw(10) << fixed << setprecision(1) << (double)tree.indexBytes() / n
+         << setw(10) << (rssAfter - rssBefore) / 1024 << " MB"
+         << setw(11) << insertTime * 1000 << " ms"
+         << setw(10) << setprecision(2) << rangeTime / queries * 1e6 << " us"
+         << setw(10) << setprecision(1) << wideTime * 1000 << " ms"
+         << setw(10) << setprecision(2) << statTime / statQueries * 1e6 << " us"
+         << "   (" << matches << " cocok, checksum " << (checksum ^ wide)
+         << ", agregat " << setprecision(0) << (wideSum / 1e6 + wideCount) << ")\n";
+}
+
+// Bandingkan countInRange / sumInRange / kth / percentile dengan brute force
+template <typename Tree>
+bool validateOrderStatistic(int n) {
+    TransactionStore store;
+    Tree tree(store);
+    vector<double> sorted;
+    Transaksi t;
+    srand(21);
+    for (int i = 0; i < n; i++) {
+        fillTransaksi(t, i);
+        t.jumlah = (double)(rand() % 5000) * 100;
+        tree.insert(t);
+        sorted.push_back(t.jumlah);
+    }
+    sort(sorted.begin(), sorted.end());
+
+    // Cursor: urutan penuh, lowerBound / upperBound, dan lanjut via token
+    size_t i = 0;
+    for (typename Tree::Cursor c = tree.begin(); c.valid(); c.next(), i++) {
+        if (i >= sorted.size() || c.key() != sorted[i]) return false;
+    }
+    if (i != sorted.size()) return false;
+    for (int q = 0; q < 1000; q++) {
+        double x = (double)(rand() % 5000) * 100;
+        size_t lo = lower_bound(sorted.begin(), sorted.end(), x) - sorted.begin();
+        size_t hi = upper_bound(sorted.begin(), sorted.end(), x) - sorted.begin();
+        typename Tree::Cursor lower = tree.lowerBound(x), upper = tree.upperBound(x);
+        if (lower.valid() != (lo < sorted.size()) || (lower.valid() && lower.key() != sorted[lo]) ||
+            upper.valid() != (hi < sorted.size()) || (upper.valid() && upper.key() != sorted[hi])) {
+            return false;
+        }
+        if (lower.valid()) {
+            typename Tree::Cursor resumed = tree.seek(lower.token());
+            if (!resumed.valid() || resumed.rec() != lower.rec()) return false;
+        }
+    }
+
+    for (int q = 0; q < 1000; q++) {
+        double lo = (double)(rand() % 5000) * 100, hi = lo + (rand() % 50000);
+        size_t first = lower_bound(sorted.begin(), sorted.end(), lo) - sorted.begin();
+        size_t last = upper_bound(sorted.begin(), sorted.end(), hi) - sorted.begin();
+        double sum = 0;
+        for (size_t i = first; i < last; i++) sum += sorted[i];
+
+        int k = rand() % n;
+        double p = rand() % 101;
+        int rank = (int)ceil(p / 100.0 * n) - 1;
+        if (rank < 0) rank = 0;
+        if (tree.countInRange(lo, hi) != (int)(last - first) ||
+            fabs(tree.sumInRange(lo, hi) - sum) > 0.5 ||
+            tree.kth(k)->jumlah != sorted[k] || tree.percentile(p) != sorted[rank]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void benchTree(const char* self, const char* arg) {
+    int n = arg ? atoi(arg) : 1000000;
+
+    cout << "\n=== BENCHMARK AVL TREE vs B+ TREE (" << n << " entry) ===\n";
+    cout << "  " << setw(6) << left << "Index" << right << setw(7) << "Level"
+         << setw(10) << "B/entry" << setw(13) << "RSS" << setw(14) << "Insert"
+         << setw(13) << "Range" << setw(13) << "Scan 10%"
+         << setw(13) << "Count+Sum" << "\n";
+    cout.flush();
+
+    // Setiap index dijalankan di proses terpisah agar RSS tidak tercampur
+    const char* modes[] = {"avl", "bplus"};
+    for (int m = 0; m < 2; m++) {
+        char command[600];
+        snprintf(command, sizeof(command), "\"%s\" tree-mode %s %d", self, modes[m], n);
+        if (system(command) != 0) {
+            cout << "Error: Gagal menjalankan mode " << modes[m] << "\n";
+        }
+    }
+
+    cout << "\n  Validasi cursor & order statistic (200000 insert acak vs brute force): AVL "
+         << (validateOrderStatistic<AVLTree>(200000) ? "OK" : "GAGAL") << ", B+ "
+         << (validateOrderStatistic<BPlusTree>(200000) ? "OK" : "GAGAL") << "\n";
+}
+
+// =================================================================
+// BENCHMARK 8: LAPORAN LEWAT CURSOR
+// =================================================================
+void benchReport(const char* arg) {
+    int n = arg ? atoi(arg) : 1000000;
+    const char* path = "bench_report.txt";
+
+    cout << "\n=== BENCHMARK LAPORAN TRANSAKSI (" << n << " baris) ===\n";
+    TransactionStore store;
+    TransactionIndex index(store);
+    Transaksi t;
+    srand(11);
+    for (int i = 0; i < n; i++) {
+        fillTransaksi(t, i);
+        index.insert(t);
+    }
+
+    // Cara lama: flush setiap baris (endl)
+    double start = nowSeconds();
+    {
+        ofstream out(path);
+        writeTableHeader(out);
+        index.forEachInorder([&](const TransaksiRecord& row) {
+            row.display(out);
+            out.flush();
+        });
+        writeTableRule(out);
+    }
+    double flushTime = nowSeconds() - start;
+
+    // Cursor + '\n': flush hanya saat buffer stream penuh
+    start = nowSeconds();
+    size_t rows;
+    {
+        ofstream out(path);
+        rows = writeTransactionTable(out, index, -DBL_MAX, DBL_MAX);
+    }
+    double streamTime = nowSeconds() - start;
+
+    // Halaman 20 baris, dilanjutkan dengan token sampai habis
+    start = nowSeconds();
+    size_t pages = 0, paged = 0;
+    {
+        ofstream out(path);
+        PageToken token;
+        bool hasMore = true;
+        while (hasMore) {
+            paged += writeTransactionPage(out, index, DBL_MAX, token, REPORT_PAGE_SIZE, hasMore);
+            pages++;
+        }
+    }
+    double pageTime = nowSeconds() - start;
+
+    // Ekspor format transactions.txt (buffer 1 MB)
+    FileHandler fileHandler;
+    start = nowSeconds();
+    long long exported = fileHandler.exportTransactions(index, -DBL_MAX, DBL_MAX, path);
+    double exportTime = nowSeconds() - start;
+    remove(path);
+
+    cout << fixed << setprecision(1);
+    cout << "  Tabel, flush per baris (endl) : " << setw(8) << flushTime * 1000 << " ms\n";
+    cout << "  Tabel, cursor + '\\n'          : " << setw(8) << streamTime * 1000 << " ms ("
+         << rows << " baris)\n";
+    cout << "  Per halaman, lanjut via token : " << setw(8) << pageTime * 1000 << " ms ("
+         << paged << " baris, " << pages << " halaman)\n";
+    cout << "  Ekspor transactions.txt       : " << setw(8) << exportTime * 1000 << " ms ("
+         << exported << " baris)\n";
+}
+
+// Riwayat 1 akun: scan semua transaksi (cara lama) vs AccountHistory
+void benchHistory(const char* arg) {
+    int n = arg ? atoi(arg) : 1000000;
+    const int accounts = 1000;
+
+    cout << "\n=== BENCHMARK RIWAYAT TRANSAKSI (" << n << " baris, " << accounts
+         << " akun) ===\n";
+    TransactionStore store;
+    TransactionIndex index(store);
+    AccountHistory history(store);
+    Transaksi t;
+    srand(13);
+    for (int i = 0; i < n; i++) {
+        fillTransaksi(t, i);
+        t.waktu = 1764583200 + rand() % 2592000;
+        snprintf(t.dari, sizeof(t.dari), "user%d", rand() % accounts);
+        snprintf(t.ke, sizeof(t.ke), "user%d", rand() % accounts);
+        index.insert(t);
+    }
+
+    // Load: semua record di-index sekaligus
+    double start = nowSeconds();
+    history.sync();
+    double syncTime = nowSeconds() - start;
+
+    // Cara lama: scan semua transaksi, ambil milik user7
+    const char* username = "user7";
+    start = nowSeconds();
+    size_t scanned = 0;
+    index.forEachInorder([&](const TransaksiRecord& row) {
+        if (strcmp(row.dari, username) == 0 || strcmp(row.ke, username) == 0) scanned++;
+    });
+    double scanTime = nowSeconds() - start;
+
+    // 1 halaman terbaru dari index akun
+    const int repeats = 10000;
+    double checksum = 0;
+    start = nowSeconds();
+    for (int r = 0; r < repeats; r++) {
+        history.visitNewest(username, 0, REPORT_PAGE_SIZE,
+                            [&](const TransaksiRecord& row) { checksum += row.jumlah; });
+    }
+    double pageTime = (nowSeconds() - start) / repeats;
+
+    // Insert baru: index + sync 1 record
+    const int inserts = 100000;
+    start = nowSeconds();
+    for (int i = 0; i < inserts; i++) {
+        fillTransaksi(t, n + i);
+        t.waktu = 1767261600 + i;
+        index.insert(t);
+        history.sync();
+    }
+    double insertTime = (nowSeconds() - start) / inserts;
+
+    cout << fixed << setprecision(2);
+    cout << "  Index riwayat saat load       : " << setw(10) << syncTime * 1000 << " ms ("
+         << history.accountCount() << " akun, "
+         << history.indexBytes() / (1024.0 * 1024.0) << " MB)\n";
+    cout << "  Riwayat via scan semua        : " << setw(10) << scanTime * 1000 << " ms ("
+         << scanned << " transaksi " << username << ")\n";
+    cout << "  1 halaman via index akun      : " << setw(10) << pageTime * 1e6 << " us ("
+         << history.count(username) << " transaksi, checksum " << checksum << ")\n";
+    cout << "  Insert + sync riwayat         : " << setw(10) << insertTime * 1e6 << " us/transaksi\n";
+}
+
+// Transaksi dalam 1 hari (dari 30 hari): scan semua vs TransactionTimeIndex
+void benchTimeRange(const char* arg) {
+    int n = arg ? atoi(arg) : 1000000;
+
+    cout << "\n=== BENCHMARK RENTANG WAKTU (" << n << " baris, 30 hari) ===\n";
+    TransactionStore store;
+    TransactionIndex index(store);
+    TransactionTimeIndex timeIndex(store);
+    Transaksi t;
+    srand(17);
+    for (int i = 0; i < n; i++) {
+        fillTransaksi(t, i);
+        t.waktu = 1764583200 + rand() % 2592000;
+        index.insert(t);
+    }
+
+    double start = nowSeconds();
+    timeIndex.sync();
+    double syncTime = nowSeconds() - start;
+
+    int64_t from = 1764583200 + 10 * 86400, to = from + 86399;
+    const int repeats = 5;
+    size_t scanned = 0, indexed = 0;
+    double sumScan = 0, sumIndex = 0;
+
+    start = nowSeconds();
+    for (int r = 0; r < repeats; r++) {
+        index.forEachInorder([&](const TransaksiRecord& row) {
+            if (row.waktu >= from && row.waktu <= to) {
+                scanned++;
+                sumScan += row.jumlah;
+            }
+        });
+    }
+    double scanTime = (nowSeconds() - start) / repeats;
+
+    start = nowSeconds();
+    for (int r = 0; r < repeats; r++) {
+        indexed += timeIndex.forEachInRange(from, to, [&](const TransaksiRecord& row) {
+            sumIndex += row.jumlah;
+        });
+    }
+    double indexTime = (nowSeconds() - start) / repeats;
+
+    cout << fixed << setprecision(2);
+    cout << "  Index waktu saat load         : " << setw(10) << syncTime * 1000 << " ms ("
+         << timeIndex.indexBytes() / (1024.0 * 1024.0) << " MB)\n";
+    cout << "  1 hari via scan semua         : " << setw(10) << scanTime * 1000 << " ms ("
+         << scanned / repeats << " transaksi)\n";
+    cout << "  1 hari via index waktu        : " << setw(10) << indexTime * 1000 << " ms ("
+         << indexed / repeats << " transaksi, " << (sumScan == sumIndex ? "cocok" : "BEDA")
+         << ")\n";
+}
+
+// Cara lama constructor Transaksi: counter statis + time/localtime/sprintf
+void legacyStamp(char* id, char* timestamp) {
+    static int counter = 1000;
+    sprintf(id, "TRX%d", counter++);
+    time_t now = time(0);
+    struct tm* t = localtime(&now);
+    sprintf(timestamp, "%02d/%02d/%04d %02d:%02d:%02d",
+            t->tm_mday, t->tm_mon + 1, t->tm_year + 1900,
+            t->tm_hour, t->tm_min, t->tm_sec);
+}
+
+void benchClock(const char* arg) {
+    int n = arg ? atoi(arg) : 1000000;
+
+    cout << "\n=== BENCHMARK WAKTU & ID TRANSAKSI (" << n << " transaksi) ===\n";
+    char id[20], timestamp[20];
+    size_t checksum = 0;
+    double start = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        legacyStamp(id, timestamp);
+        checksum += (unsigned char)id[4] + (unsigned char)timestamp[18];
+    }
+    double legacyTime = nowSeconds() - start;
+
+    start = nowSeconds();
+    for (int i = 0; i < n; i++) {
+        Transaksi t("Transfer", 1000, "bench", "user1", "user2");
+        checksum += (unsigned char)t.id[4] + (size_t)t.waktu;
+    }
+    double clockTime = nowSeconds() - start;
+
+    // ID dari beberapa thread: harus unik & naik di setiap thread
+    const int threads = 4, perThread = n / 4;
+    vector< vector<uint64_t> > ids(threads);
+    parallelFor(threads, [&](int th) {
+        ids[th].reserve(perThread);
+        for (int i = 0; i < perThread; i++) {
+            ids[th].push_back(transactionClock().nextIdNumber());
+        }
+    });
+    vector<uint64_t> all;
+    bool increasing = true;
+    for (int th = 0; th < threads; th++) {
+        for (size_t i = 1; i < ids[th].size(); i++) {
+            if (ids[th][i] <= ids[th][i - 1]) increasing = false;
+        }
+        all.insert(all.end(), ids[th].begin(), ids[th].end());
+    }
+    sort(all.begin(), all.end());
+    bool unique = adjacent_find(all.begin(), all.end()) == all.end();
+
+    cout << fixed << setprecision(1);
+    cout << "  localtime + sprintf + counter : " << setw(8) << legacyTime * 1e9 / n << " ns/transaksi\n";
+    cout << "  TransactionClock              : " << setw(8) << clockTime * 1e9 / n << " ns/transaksi\n";
+    cout << "  ID dari " << threads << " thread             : "
+         << (unique ? "unik" : "BENTROK") << ", " << (increasing ? "naik per thread" : "TIDAK URUT")
+         << " (" << all.size() << " ID, checksum " << checksum % 1000 << ")\n";
+}
+
+// =================================================================
+// BENCHMARK 9: DECODE HUFFMAN
+// =================================================================
+void printDecodeRate(const char* label, size_t bytes, double seconds) {
+    cout << "  " << setw(28) << left << label
+         << setw(8) << right << fixed << setprecision(1) << (bytes / seconds / 1e6) << " MB/s\n";
+}
+
+void benchHuffman(const char* arg) {
+    // Default: transactions.txt di direktori kerja, jika ada
+    const char* path = arg;
+    if (path == NULL) {
+        FILE* f = fopen("transactions.txt", "rb");
+        if (f != NULL) {
+            fclose(f);
+            path = "transactions.txt";
+        }
+    }
+    string corpus;
+    if (!loadCorpus(path, corpus, 200000)) return;
+
+    vector<Transaksi> rows;
+    FileHandler::parseTransactionChunk(corpus.data(), corpus.data() + corpus.size(), rows);
+
+    cout << "\n=== BENCHMARK DECODE HUFFMAN ===\n";
+    cout << "  Data   : " << (path ? path : "sintetis 200.000 baris") << " ("
+         << rows.size() << " transaksi, " << corpus.size() / 1024 << " KB)\n";
+
+    // 1. Round trip per keterangan (model & stream sendiri per transaksi)
+    vector< vector<uint8_t> > streams(rows.size());
+    size_t textBytes = 0, packedBytes = 0, failed = 0, tested = 0;
+    char decoded[256];
+    for (size_t i = 0; i < rows.size(); i++) {
+        const char* text = rows[i].keterangan;
+        if (text[0] == '\0') continue;
+        HuffmanCoding huffman;
+        huffman.buildTree(text);
+        huffman.encodePacked(text, streams[i]);
+        textBytes += strlen(text);
+        packedBytes += streams[i].size();
+        tested++;
+
+        bool ok = huffman.decodePacked(streams[i], decoded, sizeof(decoded)) &&
+                  strcmp(decoded, text) == 0;
+        ok = ok && CanonicalHuffman::decodeBitwise(streams[i].data(), streams[i].size(),
+                                                   decoded, sizeof(decoded)) &&
+             strcmp(decoded, text) == 0;
+        // Stream terpotong harus ditolak, bukan dibaca melewati batas
+        if (streams[i].size() > 1) {
+            ok = ok && !HuffmanDecoder::decodeStream(streams[i].data(), streams[i].size() - 1,
+                                                     decoded, sizeof(decoded));
+        }
+        if (!ok) failed++;
+    }
+    cout << "\n  [Round trip per keterangan]\n";
+    cout << "  " << tested << " keterangan, " << textBytes << " -> " << packedBytes
+         << " byte, gagal: " << failed << "\n";
+
+    // 2. Seluruh file sebagai 1 stream (1 model untuk semua byte)
+    int frekuensi[256] = {0};
+    for (size_t i = 0; i < corpus.size(); i++) frekuensi[(unsigned char)corpus[i]]++;
+    HuffmanCoding model;
+    model.buildFromFrequencies(frekuensi);
+    vector<uint8_t> stream;
+    model.getCanonical().encode(corpus.data(), corpus.size(), stream);
+    HuffmanDecoder decoder(model.getCanonical());
+
+    string out(corpus.size() + 1, '\0');
+    bool bitwiseOk = CanonicalHuffman::decodeBitwise(stream.data(), stream.size(), &out[0], out.size()) &&
+                     memcmp(out.data(), corpus.data(), corpus.size()) == 0;
+    out.assign(corpus.size() + 1, '\0');
+    bool tableOk = HuffmanDecoder::decodeStream(stream.data(), stream.size(), &out[0], out.size()) &&
+                   memcmp(out.data(), corpus.data(), corpus.size()) == 0;
+
+    cout << "\n  [Seluruh file, 1 stream]\n";
+    cout << "  " << corpus.size() << " -> " << stream.size() << " byte ("
+         << fixed << setprecision(1) << 100.0 * stream.size() / corpus.size() << "%), tabel lookup "
+         << decoder.getTableBits() << " bit = " << decoder.tableBytes() << " byte\n";
+    cout << "  Round trip bit demi bit      : " << (bitwiseOk ? "OK" : "GAGAL") << "\n";
+    cout << "  Round trip tabel lookup      : " << (tableOk ? "OK" : "GAGAL") << "\n\n";
+
+    double checksum = 0;
+    double bitwise = bestOf([&]() {
+        CanonicalHuffman::decodeBitwise(stream.data(), stream.size(), &out[0], out.size());
+        return (double)(unsigned char)out[corpus.size() / 2];
+    }, checksum);
+    printDecodeRate("Bit demi bit (lama)", corpus.size(), bitwise);
+    double table = bestOf([&]() {
+        HuffmanDecoder::decodeStream(stream.data(), stream.size(), &out[0], out.size());
+        return (double)(unsigned char)out[corpus.size() / 2];
+    }, checksum);
+    printDecodeRate("Tabel lookup multi-simbol", corpus.size(), table);
+
+    // 3. Banyak stream kecil: biaya bangun tabel ikut terhitung
+    double small = bestOf([&]() {
+        double sum = 0;
+        for (size_t i = 0; i < streams.size(); i++) {
+            if (streams[i].empty()) continue;
+            HuffmanDecoder::decodeStream(streams[i].data(), streams[i].size(), decoded, sizeof(decoded));
+            sum += (unsigned char)decoded[0];
+        }
+        return sum;
+    }, checksum);
+    double smallBitwise = bestOf([&]() {
+        double sum = 0;
+        for (size_t i = 0; i < streams.size(); i++) {
+            if (streams[i].empty()) continue;
+            CanonicalHuffman::decodeBitwise(streams[i].data(), streams[i].size(), decoded, sizeof(decoded));
+            sum += (unsigned char)decoded[0];
+        }
+        return sum;
+    }, checksum);
+    cout << "\n  [Per keterangan, termasuk baca tabel kode]\n";
+    printDecodeRate("Bit demi bit (lama)", textBytes, smallBitwise);
+    printDecodeRate("Tabel lookup multi-simbol", textBytes, small);
+}
+
+// =================================================================
+// BENCHMARK 10: MODEL HUFFMAN BERSAMA
+// =================================================================
+void benchModel(const char* arg) {
+    const char* path = arg;
+    if (path == NULL) {
+        FILE* f = fopen("transactions.txt", "rb");
+        if (f != NULL) {
+            fclose(f);
+            path = "transactions.txt";
+        }
+    }
+    string corpus;
+    if (!loadCorpus(path, corpus, 200000)) return;
+
+    vector<Transaksi> rows;
+    FileHandler::parseTransactionChunk(corpus.data(), corpus.data() + corpus.size(), rows);
+    size_t textBytes = 0;
+    uint64_t freq[256] = {0};
+    for (size_t i = 0; i < rows.size(); i++) {
+        for (const char* p = rows[i].keterangan; *p != '\0'; p++) {
+            freq[(unsigned char)*p]++;
+            textBytes++;
+        }
+    }
+
+    cout << "\n=== BENCHMARK MODEL HUFFMAN KETERANGAN ===\n";
+    cout << "  Data   : " << (path ? path : "sintetis 200.000 baris") << " ("
+         << rows.size() << " keterangan, " << textBytes << " byte)\n\n";
+
+    // Cara lama: pohon + tabel baru untuk setiap transaksi
+    vector<uint8_t> out;
+    size_t treeBytes = 0, calls = newCalls;
+    double start = nowSeconds();
+    for (size_t i = 0; i < rows.size(); i++) {
+        HuffmanCoding huffman;
+        huffman.buildTree(rows[i].keterangan);
+        out.clear();
+        treeBytes += huffman.encodePacked(rows[i].keterangan, out);
+    }
+    double treeTime = nowSeconds() - start;
+    size_t treeCalls = newCalls - calls;
+
+    // Model bersama: dilatih sekali, encode = lookup tabel
+    HuffmanModelRegistry registry;
+    start = nowSeconds();
+    uint32_t version = registry.train(freq);
+    double trainTime = nowSeconds() - start;
+
+    size_t modelBytes = 0;
+    calls = newCalls;
+    start = nowSeconds();
+    for (size_t i = 0; i < rows.size(); i++) {
+        out.clear();
+        modelBytes += registry.encode(rows[i].keterangan, out);
+    }
+    double modelTime = nowSeconds() - start;
+    size_t modelCalls = newCalls - calls;
+
+    // Round trip semua keterangan
+    size_t failed = 0;
+    char decoded[256];
+    for (size_t i = 0; i < rows.size(); i++) {
+        out.clear();
+        registry.encode(rows[i].keterangan, out);
+        if (!registry.decode(out.data(), out.size(), decoded, sizeof(decoded)) ||
+            strcmp(decoded, rows[i].keterangan) != 0) {
+            failed++;
+        }
+    }
+
+    size_t n = rows.size() ? rows.size() : 1;
+    cout << fixed << setprecision(1);
+    cout << "  Latih model v" << version << "                : " << trainTime * 1000 << " ms\n";
+    cout << "  Pohon per transaksi (lama)    : " << setw(8) << treeTime * 1e9 / n << " ns/transaksi, "
+         << setw(6) << (double)treeBytes / n << " byte, " << (double)treeCalls / n << " alokasi\n";
+    cout << "  Model bersama                 : " << setw(8) << modelTime * 1e9 / n << " ns/transaksi, "
+         << setw(6) << (double)modelBytes / n << " byte, " << (double)modelCalls / n << " alokasi\n";
+    cout << "  Rata-rata keterangan          : " << (double)textBytes / n << " byte, round trip gagal: "
+         << failed << "\n";
+
+    // Isi keterangan bergeser -> model baru diterbitkan, stream lama tetap terbaca
+    registry.retrainIfDrifted();    // Nilai teks benchmark di atas (sama dengan model)
+    vector<uint8_t> oldStream;
+    registry.encode(rows.empty() ? "Top up" : rows[0].keterangan, oldStream);
+    const char* drifted = "QRIS merchant 0x9F2A kopi susu gula aren #promo";
+    for (int i = 0; i < 200; i++) registry.observe(drifted, strlen(drifted));
+    bool retrained = registry.retrainIfDrifted();
+    bool oldReadable = registry.decode(oldStream.data(), oldStream.size(), decoded, sizeof(decoded)) &&
+                       strcmp(decoded, rows.empty() ? "Top up" : rows[0].keterangan) == 0;
+    vector<uint8_t> before, after;
+    registry.model(version)->encode(drifted, strlen(drifted), before);
+    registry.current().encode(drifted, strlen(drifted), after);
+    cout << "  Teks bergeser                 : " << (retrained ? "dilatih ulang" : "TIDAK dilatih ulang")
+         << " -> v" << registry.current().getVersion() << " (" << before.size() << " -> "
+         << after.size() << " byte), stream v" << version << " "
+         << (oldReadable ? "tetap terbaca" : "GAGAL dibaca") << "\n";
+}
+
+// =================================================================
+// BENCHMARK 11: KETERANGAN TERKOMPRESI DI STORE
+// =================================================================
+const char* const BENCH_KETERANGAN[] = {
+    "Top up via Bank BCA", "Transfer ke user lain", "Pembayaran Listrik PLN",
+    "Pembayaran PDAM", "Top up via Indomaret", "Pembayaran Pulsa Telkomsel",
+    "Transfer antar user", "Pembayaran Internet", "Bayar arisan bulan ini",
+    "Uang makan siang", "Patungan kado ulang tahun", "Top up via transfer bank"
+};
+
+// Jalankan 1 mode di proses ini: "inline" (record char[200]) atau "arena"
+void benchKeteranganMode(const string& mode, int n) {
+    const int batch = (int)TRANSACTION_CHUNK_SIZE;
+    vector<Transaksi> rows(batch);
+    vector<const Transaksi*> ptrs(batch);
+    for (int i = 0; i < batch; i++) ptrs[i] = &rows[i];
+
+    srand(17);
+    size_t rssBefore = rssKB();
+    double start = nowSeconds();
+    TransactionStore store;
+    vector<Transaksi*> inlineChunks;       // Tata letak lama: Transaksi utuh per record
+    for (int done = 0; done < n; done += batch) {
+        int count = n - done < batch ? n - done : batch;
+        for (int i = 0; i < count; i++) {
+            fillTransaksi(rows[i], done + i);
+            strcpy(rows[i].keterangan, BENCH_KETERANGAN[rand() % 12]);
+        }
+        if (mode == "inline") {
+            Transaksi* chunk = (Transaksi*)malloc(batch * sizeof(Transaksi));
+            if (chunk == NULL) throw bad_alloc();
+            memcpy((void*)chunk, (const void*)rows.data(), count * sizeof(Transaksi));
+            inlineChunks.push_back(chunk);
+        } else {
+            store.appendBulk(ptrs.data(), count);
+        }
+    }
+    double loadTime = nowSeconds() - start;
+    size_t rssAfter = rssKB();
+
+    // Baca semua keterangan (arena: decode per record)
+    start = nowSeconds();
+    size_t checksum = 0;
+    char text[KETERANGAN_MAX_LENGTH];
+    for (int i = 0; i < n; i++) {
+        const char* k = mode == "inline" ? inlineChunks[i / batch][i % batch].keterangan
+                                         : store[(uint32_t)i].keteranganText(text);
+        checksum += strlen(k);
+    }
+    double readTime = nowSeconds() - start;
+
+    cout << "  " << setw(7) << left << mode << right
+         << setw(10) << (rssAfter - rssBefore) / 1024 << " MB"
+         << setw(10) << fixed << setprecision(1) << loadTime * 1000 << " ms"
+         << setw(10) << readTime * 1e9 / n << " ns"
+         << "   (checksum " << checksum << ")\n";
+    if (mode == "arena") {
+        const KeteranganArena& arena = keteranganArena();
+        cout << "          record " << sizeof(TransaksiRecord) << " byte (lama " << sizeof(Transaksi)
+             << "), keterangan " << arena.originalBytes() / 1024 / 1024 << " MB -> "
+             << arena.compressedBytes() / 1024 / 1024 << " MB di arena\n";
+    }
+    for (size_t c = 0; c < inlineChunks.size(); c++) free(inlineChunks[c]);
+}
+
+void benchKeterangan(const char* self, const char* arg) {
+    int n = arg ? atoi(arg) : 1000000;
+
+    cout << "\n=== BENCHMARK KETERANGAN DI STORE (" << n << " transaksi) ===\n";
+    cout << "  " << setw(7) << left << "Mode" << right << setw(13) << "RSS"
+         << setw(13) << "Muat" << setw(13) << "Baca" << "\n";
+    cout.flush();
+
+    // Setiap mode dijalankan di proses terpisah agar RSS tidak tercampur
+    const char* modes[] = {"inline", "arena"};
+    for (int m = 0; m < 2; m++) {
+        char command[600];
+        snprintf(command, sizeof(command), "\"%s\" keterangan-mode %s %d", self, modes[m], n);
+        if (system(command) != 0) {
+            cout << "Error: Gagal menjalankan mode " << modes[m] << "\n";
+        }
+    }
+}
+
+// =================================================================
+// BENCHMARK 12: KOMPRESI FILE PER BLOK
+// =================================================================
+void benchBlockZip(const char* arg) {
+    string corpus;
+    if (!loadCorpus(arg, corpus, 1000000)) return;
+
+    cout << "\n=== BENCHMARK KOMPRESI PER BLOK (.hz) ===\n";
+    cout << "  Data   : " << (arg ? arg : "sintetis 1.000.000 baris") << " ("
+         << corpus.size() / 1024 << " KB), blok " << BLOCK_SIZE / 1024 << " KB\n\n";
+
+    // 1. Seluruh file sebagai 1 stream (1 thread, harus decode dari awal)
+    uint64_t freq[256] = {0};
+    for (size_t i = 0; i < corpus.size(); i++) freq[(unsigned char)corpus[i]]++;
+    double start = nowSeconds();
+    CanonicalHuffman code;
+    code.buildFromFrequencies(freq);
+    vector<uint8_t> stream;
+    code.encode(corpus.data(), corpus.size(), stream);
+    double singleEncode = nowSeconds() - start;
+    string out(corpus.size() + 1, '\0');
+    double checksum = 0;
+    double singleDecode = bestOf([&]() {
+        HuffmanDecoder::decodeStream(stream.data(), stream.size(), &out[0], out.size());
+        return (double)(unsigned char)out[corpus.size() / 2];
+    }, checksum);
+
+    // 2. Per blok, paralel
+    const char* path = "benchmark.hz";
+    BlockCompressStats stats;
+    start = nowSeconds();
+    if (!compressToFile(corpus.data(), corpus.size(), path, true, stats)) {
+        cout << "Error: Tidak bisa menulis " << path << "\n";
+        return;
+    }
+    double blockEncode = nowSeconds() - start;
+
+    BlockFileReader reader;
+    if (!reader.open(path)) return;
+    vector<char> text;
+    bool roundTrip = reader.readAll(text) && text.size() == corpus.size() &&
+                     memcmp(text.data(), corpus.data(), corpus.size()) == 0;
+    double blockDecode = bestOf([&]() {
+        reader.readAll(text);
+        return (double)(unsigned char)text[text.size() / 2];
+    }, checksum);
+
+    cout << "  " << setw(26) << left << "Mode" << right << setw(10) << "Ukuran"
+         << setw(13) << "Kompresi" << setw(13) << "Dekompresi" << "\n";
+    cout << "  " << setw(26) << left << "1 stream (1 thread)" << right
+         << setw(8) << fixed << setprecision(1) << 100.0 * stream.size() / corpus.size() << " %"
+         << setw(8) << corpus.size() / singleEncode / 1e6 << " MB/s"
+         << setw(8) << corpus.size() / singleDecode / 1e6 << " MB/s\n";
+    cout << "  " << setw(26) << left << "Per blok (paralel)" << right
+         << setw(8) << 100.0 * stats.compressedBytes / corpus.size() << " %"
+         << setw(8) << corpus.size() / blockEncode / 1e6 << " MB/s"
+         << setw(8) << corpus.size() / blockDecode / 1e6 << " MB/s\n";
+    cout << "  Blok: " << stats.blocks << " (" << stats.rawBlocks << " tanpa kompresi), baris utuh: "
+         << (reader.lineAligned() ? "ya" : "tidak") << ", round trip: " << (roundTrip ? "OK" : "GAGAL") << "\n";
+
+    // 3. Akses acak: 1 blok dari offset asli acak
+    srand(7);
+    int lookups = 1000;
+    size_t wrong = 0;
+    vector<char> block;
+    start = nowSeconds();
+    for (int i = 0; i < lookups; i++) {
+        uint64_t offset = ((uint64_t)rand() * RAND_MAX + rand()) % (corpus.size() ? corpus.size() : 1);
+        uint64_t b = reader.findBlock(offset);
+        const BlockIndexEntry& e = reader.block(b);
+        if (offset < e.originalOffset || offset >= e.originalOffset + e.originalSize ||
+            !reader.readBlock(b, block) ||
+            memcmp(block.data(), corpus.data() + e.originalOffset, block.size()) != 0) {
+            wrong++;
+        }
+    }
+    double randomTime = nowSeconds() - start;
+    cout << "  Akses acak 1 blok: " << setprecision(0) << randomTime / lookups * 1e6
+         << " us rata-rata (" << lookups << "x, salah: " << wrong << ") vs decode 1 stream "
+         << singleDecode * 1e6 << " us\n";
+
+    // 4. Blok rusak harus ditolak (CRC), blok lain tetap terbaca
+    if (reader.blockCount() > 1) {
+        vector<uint8_t> copy(reader.block(0).storedSize);
+        MappedFile file;
+        file.open(path);
+        memcpy(copy.data(), file.data() + reader.block(0).offset, copy.size());
+        copy[copy.size() / 2] ^= 0x10;
+        vector<char> damaged(reader.block(0).originalSize);
+        bool rejected = !decompressBlock(copy.data(), reader.block(0), damaged.data());
+        cout << "  Blok rusak ditolak: " << (rejected ? "ya" : "TIDAK")
+             << ", blok 1 tetap terbaca: " << (reader.readBlock(1, block) ? "ya" : "TIDAK") << "\n";
+    }
+
+    // 5. Arsip kolom dingin: dibuka dari .col.hz jika .col tidak ada
+    vector<Transaksi> rows;
+    FileHandler::parseTransactionChunk(corpus.data(), corpus.data() + corpus.size(), rows);
+    vector<const Transaksi*> ptrs(rows.size());
+    for (size_t i = 0; i < rows.size(); i++) ptrs[i] = &rows[i];
+    const char* archivePath = "benchmark.col";
+    const char* packedArchive = "benchmark.col.hz";
+    ColumnarWriter writer;
+    BlockCompressStats archiveStats;
+    if (writer.write(archivePath, ptrs.data(), ptrs.size(), corpus.size()) &&
+        compressFile(archivePath, packedArchive, false, archiveStats)) {
+        uint64_t columnarBytes = archiveStats.originalBytes;
+        remove(archivePath);
+
+        ColumnarArchive archive;
+        start = nowSeconds();
+        bool opened = archive.open(archivePath);
+        double openTime = nowSeconds() - start;
+        size_t mismatch = opened ? 0 : rows.size();
+        for (size_t i = 0; opened && i < rows.size(); i++) {
+            Transaksi t;
+            archive.row(i, t);
+            if (strcmp(t.id, rows[i].id) != 0 || t.jumlah != rows[i].jumlah ||
+                strcmp(t.keterangan, rows[i].keterangan) != 0) {
+                mismatch++;
+            }
+        }
+        cout << "  Arsip kolom .hz  : " << columnarBytes / 1024 << " -> " << archiveStats.compressedBytes / 1024
+             << " KB, dibuka dalam " << setprecision(1) << openTime * 1000 << " ms, baris beda: "
+             << mismatch << "\n";
+        archive.close();
+    }
+    remove(archivePath);
+    remove(packedArchive);
+
+    reader.close();
+    remove(path);
+}
+
+// =================================================================
+// BENCHMARK 13: CODEC PER KOLOM
+// =================================================================
+struct CodecResult {
+    size_t bytes;
+    double trainSeconds;
+    double encodeSeconds;
+    double decodeSeconds;
+    size_t failed;
+};
+
+// Latih codec dari semua nilai kolom, lalu encode & decode setiap nilai sendiri
+CodecResult runCodec(Codec& codec, const vector<const char*>& values) {
+    CodecResult r;
+    double start = nowSeconds();
+    codec.train(values.data(), values.size());
+    r.trainSeconds = nowSeconds() - start;
+
+    vector<uint8_t> packed;
+    vector<size_t> offsets(values.size() + 1, 0);
+    double checksum = 0;
+    r.encodeSeconds = bestOf([&]() {
+        packed.clear();
+        for (size_t i = 0; i < values.size(); i++) {
+            codec.compress(values[i], strlen(values[i]), packed);
+            offsets[i + 1] = packed.size();
+        }
+        return (double)packed.size();
+    }, checksum);
+    r.bytes = packed.size();
+
+    char decoded[256];
+    r.decodeSeconds = bestOf([&]() {
+        double sum = 0;
+        for (size_t i = 0; i < values.size(); i++) {
+            codec.decompress(packed.data() + offsets[i], offsets[i + 1] - offsets[i], decoded, sizeof(decoded));
+            sum += (unsigned char)decoded[0];
+        }
+        return sum;
+    }, checksum);
+
+    r.failed = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        size_t size = offsets[i + 1] - offsets[i];
+        bool ok = size > 0 &&
+                  codec.decompress(packed.data() + offsets[i], size, decoded, sizeof(decoded)) &&
+                  strcmp(decoded, values[i]) == 0;
+        // Stream terpotong harus ditolak
+        if (ok && size > 1) {
+            ok = !codec.decompress(packed.data() + offsets[i], size - 1, decoded, sizeof(decoded));
+        }
+        if (!ok) r.failed++;
+    }
+    return r;
+}
+
+void benchCodec(const char* arg) {
+    const char* path = arg;
+    if (path == NULL) {
+        FILE* f = fopen("transactions.txt", "rb");
+        if (f != NULL) {
+            fclose(f);
+            path = "transactions.txt";
+        }
+    }
+    string corpus;
+    if (!loadCorpus(path, corpus, 200000)) return;
+
+    vector<Transaksi> rows;
+    FileHandler::parseTransactionChunk(corpus.data(), corpus.data() + corpus.size(), rows);
+
+    // Kolom teks seperti di transactions.txt
+    const char* names[] = {"id", "waktu", "jenis", "dari", "ke", "jumlah", "keterangan"};
+    const int columnCount = 7;
+    vector< vector<string> > columns(columnCount, vector<string>(rows.size()));
+    for (size_t i = 0; i < rows.size(); i++) {
+        char text[64];
+        columns[0][i] = rows[i].id;
+        columns[1][i] = rows[i].formatWaktu(text);
+        columns[2][i] = rows[i].jenis;
+        columns[3][i] = rows[i].dari;
+        columns[4][i] = rows[i].ke;
+        snprintf(text, sizeof(text), "%.15g", rows[i].jumlah);
+        columns[5][i] = text;
+        columns[6][i] = rows[i].keterangan;
+    }
+
+    cout << "\n=== BENCHMARK CODEC PER KOLOM ===\n";
+    cout << "  Data   : " << (path ? path : "sintetis 200.000 baris") << " (" << rows.size()
+         << " transaksi), setiap nilai di-encode sendiri (akses acak per baris)\n";
+
+    size_t chosenTotal = 0, huffmanTotal = 0, ransTotal = 0, textTotal = 0;
+    int ransWins = 0;
+    string choices;
+    for (int col = 0; col < columnCount; col++) {
+        vector<const char*> values(rows.size());
+        size_t textBytes = 0;
+        for (size_t i = 0; i < rows.size(); i++) {
+            values[i] = columns[col][i].c_str();
+            textBytes += columns[col][i].size();
+        }
+
+        StoredCodec stored;
+        HuffmanCoding huffman;
+        LzDictCodec lz;
+        RansCodec rans;
+        Codec* codecs[] = {&stored, &huffman, &lz, &rans};
+        const int codecCount = 4;
+
+        cout << "\n  [kolom " << names[col] << "] " << textBytes / 1024 << " KB teks\n";
+        cout << "  " << setw(10) << left << "Codec" << right << setw(10) << "Ukuran" << setw(13) << "Latih"
+             << setw(13) << "Encode" << setw(13) << "Decode" << setw(8) << "Gagal" << "\n";
+
+        int best = 0;
+        size_t bestBytes = 0, huffmanBytes = 0, ransBytes = 0;
+        for (int c = 0; c < codecCount; c++) {
+            CodecResult r = runCodec(*codecs[c], values);
+            cout << "  " << setw(10) << left << codecs[c]->name() << right
+                 << setw(8) << fixed << setprecision(1) << (textBytes ? 100.0 * r.bytes / textBytes : 0.0) << " %"
+                 << setw(10) << setprecision(1) << r.trainSeconds * 1000 << " ms"
+                 << setw(8) << textBytes / r.encodeSeconds / 1e6 << " MB/s"
+                 << setw(8) << textBytes / r.decodeSeconds / 1e6 << " MB/s"
+                 << setw(8) << r.failed << "\n";
+            if (r.failed == 0 && (bestBytes == 0 || r.bytes < bestBytes)) {
+                best = c;
+                bestBytes = r.bytes;
+            }
+            if (codecs[c] == &huffman) huffmanBytes = r.bytes;
+            if (codecs[c] == &rans) ransBytes = r.bytes;
+        }
+        huffmanTotal += huffmanBytes;
+        ransTotal += ransBytes;
+        if (ransBytes < huffmanBytes) ransWins++;
+        if (col == columnCount - 1) {
+            cout << "  (kamus lz-dict: " << lz.dictBytes() << " byte)\n";
+        }
+
+        chosenTotal += bestBytes;
+        textTotal += textBytes;
+        choices += string("  ") + names[col] + " -> " + codecs[best]->name() + "\n";
+    }
+
+    cout << "\n  [Pilihan per kolom (ukuran terkecil)]\n" << choices;
+    cout << "  Total: teks " << textTotal / 1024 << " KB, semua huffman " << huffmanTotal / 1024
+         << " KB, pilihan per kolom " << chosenTotal / 1024 << " KB (tanpa tabel/kamus)\n";
+    cout << "  Catatan: rans per nilai " << ransTotal / 1024 << " KB, lebih kecil dari huffman di "
+         << ransWins << " dari " << columnCount << " kolom. State 3 byte di-flush di setiap nilai,\n"
+         << "  sehingga rANS per nilai TIDAK kompetitif untuk nilai pendek (butuh 1 state per blok).\n";
+}
+
+// =================================================================
+// MAIN
+// =================================================================
+int main(int argc, char** argv) {
+    string name = argc > 1 ? argv[1] : "all";
+    const char* arg = argc > 2 ? argv[2] : NULL;
+
+    if (name == "tokenizer" || name == "all") {
+        benchTokenizer(name == "all" ? NULL : arg);
+    }
+    if (name == "archive" || name == "all") {
+        benchArchive(name == "all" ? NULL : arg);
+    }
+    if (name == "hashindex" || name == "all") {
+        benchHashIndex(name == "all" ? NULL : arg);
+    }
+    if (name == "accounts" || name == "all") {
+        benchAccounts();
+    }
+    if (name == "pool" || name == "all") {
+        benchPool(argv[0], name == "all" ? NULL : arg);
+    }
+    if (name == "index" || name == "all") {
+        benchIndex(name == "all" ? NULL : arg);
+    }
+    if (name == "tree" || name == "all") {
+        benchTree(argv[0], name == "all" ? NULL : arg);
+    }
+    if (name == "report" || name == "all") {
+        benchReport(name == "all" ? NULL : arg);
+    }
+    if (name == "history" || name == "all") {
+        benchHistory(name == "all" ? NULL : arg);
+    }
+    if (name == "timerange" || name == "all") {
+        benchTimeRange(name == "all" ? NULL : arg);
+    }
+    if (name == "clock" || name == "all") {
+        benchClock(name == "all" ? NULL : arg);
+    }
+    if (name == "huffman" || name == "all") {
+        benchHuffman(name == "all" ? NULL : arg);
+    }
+    if (name == "model" || name == "all") {
+        benchModel(name == "all" ? NULL : arg);
+    }
+    if (name == "keterangan" || name == "all") {
+        benchKeterangan(argv[0], name == "all" ? NULL : arg);
+    }
+    if (name == "blockzip" || name == "all") {
+        benchBlockZip(name == "all" ? NULL : arg);
+    }
+    if (name == "codec" || name == "all") {
+        benchCodec(name == "all" ? NULL : arg);
+    }
+    if (name == "tree-mode" && argc > 3) {
+        if (strcmp(argv[2], "bplus") == 0) benchTreeMode<BPlusTree>("bplus", atoi(argv[3]));
+        else benchTreeMode<AVLTree>("avl", atoi(argv[3]));
+    }
+    if (name == "pool-mode" && argc > 3) {
+        benchPoolMode(argv[2], atoi(argv[3]));
+    }
+    if (name == "keterangan-mode" && argc > 3) {
+        benchKeteranganMode(argv[2], atoi(argv[3]));
+    }
+
+    return 0;
+}
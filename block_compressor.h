@@ -0,0 +1,351 @@
+#ifndef BLOCK_COMPRESSOR_H
+#define BLOCK_COMPRESSOR_H
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "canonical_huffman.h"
+#include "parallel_loader.h"
+#include "transaction_log.h"
+
+using namespace std;
+
+// =================================================================
+// BLOCK COMPRESSOR - Kompresi File per Blok (Huffman, Paralel)
+// =================================================================
+/*
+ * SEBELUMNYA: Huffman hanya untuk 1 string di RAM; menu "kompresi
+ * database" hanya menampilkan simulasi 5 contoh keterangan.
+ *
+ * FORMAT FILE <nama>.hz:
+ * [header][blok 0][blok 1]...[index blok]
+ * - Blok = maks. 256 KB isi asli. File teks dipotong di '\n' terakhir
+ *   dalam blok -> 1 blok = baris utuh, bisa langsung di-parse loader
+ * - Setiap blok punya tabel kode sendiri (stream CanonicalHuffman
+ *   [panjang][tabel][bit]) -> setiap blok bisa di-decode sendiri
+ * - Blok yang tidak mengecil disimpan apa adanya (BLOCK_FLAG_RAW)
+ * - Index di akhir file: offset & ukuran blok, offset di file asli,
+ *   CRC32 isi asli (blok rusak terdeteksi saat dibaca)
+ *
+ * STREAMING & PARALEL:
+ * - Kompresi: file sumber di-mmap, blok dikompresi per gelombang
+ *   (jumlah core x 4 blok) di thread pool, lalu ditulis berurutan
+ *   -> memori tambahan = 1 gelombang, bukan seluruh file
+ * - Dekompresi: semua blok paralel langsung ke posisinya di buffer
+ *   tujuan, per gelombang ke file, atau 1 blok saja (akses acak:
+ *   blok dari offset asli dicari dengan binary search di index)
+ */
+const uint32_t BLOCK_FILE_VERSION = 1;
+const uint32_t BLOCK_SIZE = 256 * 1024;
+const int BLOCKS_PER_WORKER = 4;
+const char* const BLOCK_FILE_SUFFIX = ".hz";
+
+const uint32_t BLOCK_FLAG_RAW = 1;          // Blok disimpan tanpa kompresi
+const uint32_t BLOCK_FILE_LINES = 1;        // Semua blok berakhir di '\n' (atau akhir file)
+
+struct BlockFileHeader {
+    char magic[8];                  // "EWHUFBK"
+    uint32_t version;
+    uint32_t flags;
+    uint32_t blockSize;
+    uint32_t reserved;
+    uint64_t originalSize;
+    uint64_t blockCount;
+    uint64_t indexOffset;
+};
+
+struct BlockIndexEntry {
+    uint64_t offset;                // Posisi blok di file .hz
+    uint64_t originalOffset;        // Posisi isi blok di file asli
+    uint32_t storedSize;
+    uint32_t originalSize;
+    uint32_t crc;                   // CRC32 isi asli
+    uint32_t flags;
+};
+
+struct BlockCompressStats {
+    uint64_t originalBytes;
+    uint64_t compressedBytes;
+    uint64_t blocks;
+    uint64_t rawBlocks;
+
+    BlockCompressStats() : originalBytes(0), compressedBytes(0), blocks(0), rawBlocks(0) {}
+};
+
+/*
+ * Batas blok: maks. blockSize byte. Mode baris: dipotong setelah '\n'
+ * terakhir di dalam blok; baris yang lebih panjang dari 1 blok
+ * dipotong di batas ukuran (lines jadi false).
+ */
+inline void splitBlocks(const char* data, size_t size, size_t blockSize,
+                        vector<size_t>& bounds, bool& lines) {
+    bounds.clear();
+    bounds.push_back(0);
+
+    size_t pos = 0;
+    while (size - pos > blockSize) {
+        size_t cut = pos + blockSize;
+        if (lines) {
+            size_t nl = cut;
+            while (nl > pos && data[nl - 1] != '\n') nl--;
+            if (nl > pos) cut = nl;
+            else lines = false;
+        }
+        pos = cut;
+        bounds.push_back(pos);
+    }
+
+    if (bounds.back() != size) {
+        bounds.push_back(size);
+    }
+}
+
+// Kompresi 1 blok dengan tabel kodenya sendiri. Return flag blok.
+inline uint32_t compressBlock(const char* data, size_t n, vector<uint8_t>& out) {
+    out.clear();
+    uint64_t freq[256] = {0};
+    for (size_t i = 0; i < n; i++) {
+        freq[(unsigned char)data[i]]++;
+    }
+
+    CanonicalHuffman code;
+    code.buildFromFrequencies(freq);
+    if (code.encode(data, n, out) == 0 || out.size() >= n) {
+        out.assign((const uint8_t*)data, (const uint8_t*)data + n);
+        return BLOCK_FLAG_RAW;
+    }
+    return 0;
+}
+
+/*
+ * Decode 1 blok langsung ke out (tepat entry.originalSize byte, tanpa
+ * '\0' -> blok tetangga bisa di-decode paralel ke buffer yang sama).
+ */
+inline bool decompressBlock(const uint8_t* data, const BlockIndexEntry& entry, char* out) {
+    if (entry.flags & BLOCK_FLAG_RAW) {
+        if (entry.storedSize != entry.originalSize) return false;
+        memcpy(out, data, entry.originalSize);
+    } else {
+        const uint8_t* p = data;
+        const uint8_t* end = data + entry.storedSize;
+        uint64_t n;
+        CanonicalHuffman code;
+        if (!getVarint(p, end, n) || n != entry.originalSize || !code.readTable(p, end)) {
+            return false;
+        }
+        HuffmanDecoder decoder(code, (size_t)n);
+        if (!decoder.decode(p, end - p, (size_t)n, out)) return false;
+    }
+    return crc32(out, entry.originalSize) == entry.crc;
+}
+
+// Jumlah blok per gelombang paralel
+inline int blockWaveSize() {
+    unsigned cores = thread::hardware_concurrency();
+    return (int)(cores == 0 ? 1 : cores) * BLOCKS_PER_WORKER;
+}
+
+/*
+ * Kompresi data ke file .hz (tmp + rename). lines = potong blok di
+ * akhir baris (file teks). Return false jika gagal menulis.
+ */
+inline bool compressToFile(const char* data, size_t size, const char* path, bool lines,
+                           BlockCompressStats& stats, uint32_t blockSize = BLOCK_SIZE) {
+    vector<size_t> bounds;
+    splitBlocks(data, size, blockSize, bounds, lines);
+    int blockCount = (int)bounds.size() - 1;
+
+    char tmpPath[260];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+    FILE* f = fopen(tmpPath, "wb");
+    if (f == NULL) return false;
+
+    BlockFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "EWHUFBK", 7);
+    header.version = BLOCK_FILE_VERSION;
+    header.flags = lines ? BLOCK_FILE_LINES : 0;
+    header.blockSize = blockSize;
+    header.originalSize = size;
+    header.blockCount = blockCount;
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+
+    vector<BlockIndexEntry> index(blockCount);
+    int wave = blockWaveSize();
+    vector< vector<uint8_t> > packed(wave < blockCount ? wave : blockCount);
+    uint64_t offset = sizeof(header);
+    stats = BlockCompressStats();
+
+    for (int first = 0; ok && first < blockCount; first += wave) {
+        int count = blockCount - first < wave ? blockCount - first : wave;
+        parallelFor(count, [&](int w) {
+            int b = first + w;
+            size_t n = bounds[b + 1] - bounds[b];
+            BlockIndexEntry& e = index[b];
+            e.originalOffset = bounds[b];
+            e.originalSize = (uint32_t)n;
+            e.crc = crc32(data + bounds[b], n);
+            e.flags = compressBlock(data + bounds[b], n, packed[w]);
+            e.storedSize = (uint32_t)packed[w].size();
+        });
+
+        for (int w = 0; ok && w < count; w++) {
+            BlockIndexEntry& e = index[first + w];
+            e.offset = offset;
+            offset += e.storedSize;
+            if (e.flags & BLOCK_FLAG_RAW) stats.rawBlocks++;
+            if (e.storedSize > 0) ok = fwrite(packed[w].data(), e.storedSize, 1, f) == 1;
+        }
+    }
+
+    // Index rata 8 byte
+    static const uint8_t zeros[8] = {0};
+    size_t pad = (8 - offset % 8) % 8;
+    if (ok && pad > 0) ok = fwrite(zeros, 1, pad, f) == pad;
+    offset += pad;
+
+    header.indexOffset = offset;
+    if (ok && blockCount > 0) {
+        ok = fwrite(index.data(), sizeof(BlockIndexEntry), index.size(), f) == index.size();
+    }
+    ok = ok && fseek(f, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, f) == 1;
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) {
+        remove(tmpPath);
+        return false;
+    }
+
+    stats.originalBytes = size;
+    stats.compressedBytes = offset + index.size() * sizeof(BlockIndexEntry);
+    stats.blocks = blockCount;
+    remove(path);
+    return rename(tmpPath, path) == 0;
+}
+
+// Kompresi file src ke dst (.hz)
+inline bool compressFile(const char* src, const char* dst, bool lines,
+                         BlockCompressStats& stats, uint32_t blockSize = BLOCK_SIZE) {
+    MappedFile file;
+    if (!file.open(src)) return false;
+    return compressToFile(file.data(), file.size(), dst, lines, stats, blockSize);
+}
+
+// ---- Pembaca file .hz (mmap, akses acak per blok) ----
+class BlockFileReader {
+private:
+    MappedFile file;
+    const BlockFileHeader* header;
+    const BlockIndexEntry* index;
+
+public:
+    BlockFileReader() : header(NULL), index(NULL) {}
+
+    bool open(const char* path) {
+        close();
+        if (!file.open(path) || file.size() < sizeof(BlockFileHeader)) {
+            file.close();
+            return false;
+        }
+
+        const BlockFileHeader* h = (const BlockFileHeader*)file.data();
+        bool ok = memcmp(h->magic, "EWHUFBK", 7) == 0 && h->version == BLOCK_FILE_VERSION &&
+                  h->indexOffset <= file.size() &&
+                  h->blockCount <= (file.size() - h->indexOffset) / sizeof(BlockIndexEntry);
+        const BlockIndexEntry* entries = (const BlockIndexEntry*)(file.data() + (ok ? h->indexOffset : 0));
+        uint64_t expected = 0;
+        for (uint64_t b = 0; ok && b < h->blockCount; b++) {
+            const BlockIndexEntry& e = entries[b];
+            ok = e.originalOffset == expected && e.offset + e.storedSize <= h->indexOffset;
+            expected += e.originalSize;
+        }
+        if (!ok || expected != h->originalSize) {
+            cout << "Error: Format file kompresi tidak dikenali: " << path << "\n";
+            file.close();
+            return false;
+        }
+
+        header = h;
+        index = entries;
+        return true;
+    }
+
+    void close() {
+        file.close();
+        header = NULL;
+        index = NULL;
+    }
+
+    bool isOpen() const { return header != NULL; }
+    bool lineAligned() const { return (header->flags & BLOCK_FILE_LINES) != 0; }
+    uint64_t blockCount() const { return header ? header->blockCount : 0; }
+    uint64_t originalSize() const { return header ? header->originalSize : 0; }
+    uint64_t fileSize() const { return file.size(); }
+    const BlockIndexEntry& block(uint64_t b) const { return index[b]; }
+
+    // Blok yang berisi byte ke-originalOffset file asli (binary search)
+    uint64_t findBlock(uint64_t originalOffset) const {
+        uint64_t lo = 0, hi = blockCount();
+        while (hi - lo > 1) {
+            uint64_t mid = (lo + hi) / 2;
+            if (index[mid].originalOffset <= originalOffset) lo = mid;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // Decode 1 blok (out = minimal block(b).originalSize byte)
+    bool readBlock(uint64_t b, char* out) const {
+        const BlockIndexEntry& e = index[b];
+        return decompressBlock((const uint8_t*)file.data() + e.offset, e, out);
+    }
+
+    bool readBlock(uint64_t b, vector<char>& out) const {
+        out.resize(index[b].originalSize);
+        return readBlock(b, out.data());
+    }
+
+    // Seluruh isi asli: semua blok di-decode paralel ke posisinya
+    bool readAll(vector<char>& out) const {
+        out.resize((size_t)originalSize());
+        atomic<bool> ok(true);
+        parallelFor((int)blockCount(), [&](int b) {
+            if (!readBlock(b, out.data() + index[b].originalOffset)) ok = false;
+        });
+        return ok.load();
+    }
+
+    // Dekompresi ke file per gelombang blok (tmp + rename)
+    bool decompressTo(const char* path) const {
+        char tmpPath[260];
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+        FILE* f = fopen(tmpPath, "wb");
+        if (f == NULL) return false;
+
+        int blocks = (int)blockCount();
+        int wave = blockWaveSize();
+        vector< vector<char> > text(wave < blocks ? wave : blocks);
+        atomic<bool> ok(true);
+        for (int first = 0; ok && first < blocks; first += wave) {
+            int count = blocks - first < wave ? blocks - first : wave;
+            parallelFor(count, [&](int w) {
+                if (!readBlock(first + w, text[w])) ok = false;
+            });
+            for (int w = 0; ok && w < count; w++) {
+                if (!text[w].empty()) ok = fwrite(text[w].data(), text[w].size(), 1, f) == 1;
+            }
+        }
+        bool closed = fclose(f) == 0;
+        if (!closed || !ok) {
+            remove(tmpPath);
+            return false;
+        }
+        remove(path);
+        return rename(tmpPath, path) == 0;
+    }
+};
+
+#endif
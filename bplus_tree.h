@@ -0,0 +1,612 @@
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <iostream>
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+#include "data_structures.h"
+#include "node_pool.h"
+
+using namespace std;
+
+// =================================================================
+// B+ TREE - Index Jumlah Transaksi yang Ramah Cache
+// =================================================================
+/*
+ * Alternatif AVLTree untuk data besar. Di AVL setiap level = 1 node
+ * kecil di alamat acak -> begitu tree lebih besar dari cache, setiap
+ * level pencarian adalah 1 cache miss (~24 level untuk 1 juta data).
+ *
+ * KONSEP:
+ * - Key = (jumlah, nomor record). Nomor record menjadi tiebreaker:
+ *   setiap key unik dan jumlah yang sama tetap urut sesuai urutan masuk
+ * - Leaf berisi 64 key: array jumlah[] dan rec[] terpisah (768 byte =
+ *   12 cache line) + pointer ke leaf berikutnya
+ * - Internal node berisi 64 separator + 65 anak
+ *   -> 1 juta transaksi hanya 4 level
+ * - Pencarian di dalam node = binary search pada array berurutan
+ * - Range query = 1x turun ke leaf pertama, lalu jalan berurutan
+ *   di leaf yang tersambung (tanpa kembali ke atas)
+ * - Cursor cukup (leaf, posisi): next() tidak pernah naik ke parent
+ *
+ * ORDER STATISTIC:
+ * - Internal node menyimpan banyak key dan total jumlah setiap anak
+ * - countInRange / sumInRange cukup menjumlahkan agregat anak di jalur
+ *   pencarian, kth turun memakai banyak key per anak: O(log n)
+ *
+ * Node tidak pernah dihapus (store append-only), jadi tidak ada merge.
+ */
+const int BPLUS_LEAF_KEYS = 64;
+const int BPLUS_INNER_KEYS = 64;
+
+struct BPlusNode {
+    int count;          // Jumlah key di node
+};
+
+struct BPlusLeaf : BPlusNode {
+    double keys[BPLUS_LEAF_KEYS];
+    uint32_t recs[BPLUS_LEAF_KEYS];
+    BPlusLeaf* next;
+};
+
+struct BPlusInner : BPlusNode {
+    double keys[BPLUS_INNER_KEYS];      // keys[i]/recs[i] = key terkecil di children[i + 1]
+    uint32_t recs[BPLUS_INNER_KEYS];
+    BPlusNode* children[BPLUS_INNER_KEYS + 1];
+    uint32_t counts[BPLUS_INNER_KEYS + 1];      // Banyak key di subtree children[i]
+    double sums[BPLUS_INNER_KEYS + 1];          // Total key di subtree children[i]
+};
+
+class BPlusTree {
+public:
+    class Cursor {
+    private:
+        friend class BPlusTree;
+        const BPlusTree* tree;
+        const BPlusLeaf* leaf;
+        int pos;
+        
+    public:
+        Cursor() : tree(NULL), leaf(NULL), pos(0) {}
+
+        bool valid() const { return leaf != NULL; }
+        double key() const { return leaf->keys[pos]; }
+        uint32_t rec() const { return leaf->recs[pos]; }
+        const TransaksiRecord& record() const { return tree->store[rec()]; }
+        PageToken token() const { return PageToken(key(), rec()); }
+
+        void next() {
+            if (++pos >= leaf->count) {
+                leaf = leaf->next;
+                pos = 0;
+            }
+        }
+    };
+
+private:
+    BPlusNode* root;
+    BPlusLeaf* firstLeaf;
+    int height;         // Jumlah level (0 = kosong, 1 = root berupa leaf)
+    int nodeCount;      // Jumlah transaksi ter-index
+    int leafCount;
+    int innerCount;
+    TransactionStore& store;
+    NodePool<BPlusLeaf> leafPool;
+    NodePool<BPlusInner> innerPool;
+
+    BPlusTree(const BPlusTree&);
+    BPlusTree& operator=(const BPlusTree&);
+
+    // Jumlah key di node yang <= (key, rec)
+    template <typename Node>
+    static int nodeUpperBound(const Node* node, double key, uint32_t rec) {
+        int lo = 0, hi = node->count;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (indexKeyLess(key, rec, node->keys[mid], node->recs[mid])) hi = mid;
+            else lo = mid + 1;
+        }
+        return lo;
+    }
+
+    // Posisi key pertama di leaf yang >= (key, rec)
+    static int leafLowerBound(const BPlusLeaf* leaf, double key, uint32_t rec) {
+        int lo = 0, hi = leaf->count;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (indexKeyLess(leaf->keys[mid], leaf->recs[mid], key, rec)) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // Banyak key dan total key di subtree (dari isi node itu sendiri)
+    static void subtreeTotals(const BPlusNode* node, int level, uint32_t& count, double& sum) {
+        count = 0;
+        sum = 0.0;
+        if (level == 0) {
+            const BPlusLeaf* leaf = (const BPlusLeaf*)node;
+            count = leaf->count;
+            for (int i = 0; i < leaf->count; i++) sum += leaf->keys[i];
+            return;
+        }
+        const BPlusInner* inner = (const BPlusInner*)node;
+        for (int i = 0; i <= inner->count; i++) {
+            count += inner->counts[i];
+            sum += inner->sums[i];
+        }
+    }
+
+    // Pasang anak ke-i beserta agregat subtree-nya
+    static void setChild(BPlusInner* inner, int i, BPlusNode* child, int childLevel) {
+        inner->children[i] = child;
+        subtreeTotals(child, childLevel, inner->counts[i], inner->sums[i]);
+    }
+
+    BPlusLeaf* newLeaf() {
+        leafCount++;
+        BPlusLeaf* leaf = leafPool.create();
+        leaf->count = 0;
+        leaf->next = NULL;
+        return leaf;
+    }
+
+    BPlusInner* newInner() {
+        innerCount++;
+        BPlusInner* inner = innerPool.create();
+        inner->count = 0;
+        return inner;
+    }
+
+    /*
+     * Sisipkan ke leaf. Jika penuh, leaf dipecah dan node kanan yang
+     * baru dikembalikan (sep = key terkecilnya). Sisipan di ujung kanan
+     * (data masuk berurutan) tidak membagi dua: leaf lama tetap penuh.
+     */
+    BPlusNode* insertLeaf(BPlusLeaf* leaf, double key, uint32_t rec,
+                          double& sepKey, uint32_t& sepRec) {
+        int pos = nodeUpperBound(leaf, key, rec);
+        BPlusLeaf* target = leaf;
+        BPlusLeaf* right = NULL;
+
+        if (leaf->count == BPLUS_LEAF_KEYS) {
+            int half = pos == BPLUS_LEAF_KEYS ? BPLUS_LEAF_KEYS : BPLUS_LEAF_KEYS / 2;
+            right = newLeaf();
+            right->count = BPLUS_LEAF_KEYS - half;
+            for (int i = half; i < BPLUS_LEAF_KEYS; i++) {
+                right->keys[i - half] = leaf->keys[i];
+                right->recs[i - half] = leaf->recs[i];
+            }
+            leaf->count = half;
+            right->next = leaf->next;
+            leaf->next = right;
+
+            if (pos >= half) {
+                target = right;
+                pos -= half;
+            }
+        }
+
+        for (int i = target->count; i > pos; i--) {
+            target->keys[i] = target->keys[i - 1];
+            target->recs[i] = target->recs[i - 1];
+        }
+        target->keys[pos] = key;
+        target->recs[pos] = rec;
+        target->count++;
+
+        if (right != NULL) {
+            sepKey = right->keys[0];
+            sepRec = right->recs[0];
+        }
+        return right;
+    }
+
+    BPlusNode* insertRec(BPlusNode* node, int level, double key, uint32_t rec,
+                         double& sepKey, uint32_t& sepRec) {
+        if (level == 0) {
+            return insertLeaf((BPlusLeaf*)node, key, rec, sepKey, sepRec);
+        }
+
+        BPlusInner* inner = (BPlusInner*)node;
+        int c = nodeUpperBound(inner, key, rec);
+        double childSep;
+        uint32_t childSepRec;
+        BPlusNode* split = insertRec(inner->children[c], level - 1, key, rec, childSep, childSepRec);
+        if (split == NULL) {
+            inner->counts[c]++;
+            inner->sums[c] += key;
+            return NULL;
+        }
+        setChild(inner, c, inner->children[c], level - 1);
+
+        if (inner->count < BPLUS_INNER_KEYS) {
+            for (int i = inner->count; i > c; i--) {
+                inner->keys[i] = inner->keys[i - 1];
+                inner->recs[i] = inner->recs[i - 1];
+                inner->children[i + 1] = inner->children[i];
+                inner->counts[i + 1] = inner->counts[i];
+                inner->sums[i + 1] = inner->sums[i];
+            }
+            inner->keys[c] = childSep;
+            inner->recs[c] = childSepRec;
+            setChild(inner, c + 1, split, level - 1);
+            inner->count++;
+            return NULL;
+        }
+
+        // Internal node penuh: gabung sementara (65 key, 66 anak) lalu bagi dua,
+        // key tengah naik ke parent
+        double keys[BPLUS_INNER_KEYS + 1];
+        uint32_t recs[BPLUS_INNER_KEYS + 1];
+        BPlusNode* children[BPLUS_INNER_KEYS + 2];
+        uint32_t counts[BPLUS_INNER_KEYS + 2];
+        double sums[BPLUS_INNER_KEYS + 2];
+        for (int i = 0, j = 0; i <= BPLUS_INNER_KEYS; i++) {
+            if (i == c) {
+                keys[i] = childSep;
+                recs[i] = childSepRec;
+            } else {
+                keys[i] = inner->keys[j];
+                recs[i] = inner->recs[j];
+                j++;
+            }
+        }
+        for (int i = 0, j = 0; i <= BPLUS_INNER_KEYS + 1; i++) {
+            if (i == c + 1) {
+                children[i] = split;
+                subtreeTotals(split, level - 1, counts[i], sums[i]);
+            } else {
+                children[i] = inner->children[j];
+                counts[i] = inner->counts[j];
+                sums[i] = inner->sums[j];
+                j++;
+            }
+        }
+
+        int mid = (BPLUS_INNER_KEYS + 1) / 2;
+        BPlusInner* right = newInner();
+        inner->count = mid;
+        right->count = BPLUS_INNER_KEYS - mid;
+        for (int i = 0; i < mid; i++) {
+            inner->keys[i] = keys[i];
+            inner->recs[i] = recs[i];
+        }
+        for (int i = 0; i <= mid; i++) {
+            inner->children[i] = children[i];
+            inner->counts[i] = counts[i];
+            inner->sums[i] = sums[i];
+        }
+        for (int i = 0; i < right->count; i++) {
+            right->keys[i] = keys[mid + 1 + i];
+            right->recs[i] = recs[mid + 1 + i];
+        }
+        for (int i = 0; i <= right->count; i++) {
+            right->children[i] = children[mid + 1 + i];
+            right->counts[i] = counts[mid + 1 + i];
+            right->sums[i] = sums[mid + 1 + i];
+        }
+
+        sepKey = keys[mid];
+        sepRec = recs[mid];
+        return right;
+    }
+
+    // Leaf yang memuat key pertama >= (key, rec)
+    const BPlusLeaf* descend(double key, uint32_t rec) const {
+        const BPlusNode* node = root;
+        for (int level = height - 1; level > 0; level--) {
+            const BPlusInner* inner = (const BPlusInner*)node;
+            node = inner->children[nodeUpperBound(inner, key, rec)];
+        }
+        return (const BPlusLeaf*)node;
+    }
+
+    // Banyak key dengan jumlah < x (dan total jumlahnya)
+    void countBelow(double x, uint32_t& count, double& sum) const {
+        count = 0;
+        sum = 0.0;
+        if (root == NULL) return;
+
+        const BPlusNode* node = root;
+        for (int level = height - 1; level > 0; level--) {
+            const BPlusInner* inner = (const BPlusInner*)node;
+            int c = nodeUpperBound(inner, x, 0);
+            for (int i = 0; i < c; i++) {
+                count += inner->counts[i];
+                sum += inner->sums[i];
+            }
+            node = inner->children[c];
+        }
+
+        const BPlusLeaf* leaf = (const BPlusLeaf*)node;
+        int pos = leafLowerBound(leaf, x, 0);
+        count += pos;
+        for (int i = 0; i < pos; i++) sum += leaf->keys[i];
+    }
+
+    // Leaf dan posisi key ke-k (0-based) dalam urutan jumlah
+    const BPlusLeaf* kthLeaf(uint32_t k, int& pos) const {
+        const BPlusNode* node = root;
+        for (int level = height - 1; level > 0; level--) {
+            const BPlusInner* inner = (const BPlusInner*)node;
+            int c = 0;
+            while (c < inner->count && k >= inner->counts[c]) {
+                k -= inner->counts[c];
+                c++;
+            }
+            node = inner->children[c];
+        }
+        pos = (int)k;
+        return (const BPlusLeaf*)node;
+    }
+
+    void visualizeRec(const BPlusNode* node, int level, int indent) const {
+        for (int i = 0; i < indent; i++) cout << " ";
+        if (level == 0) {
+            const BPlusLeaf* leaf = (const BPlusLeaf*)node;
+            cout << "Leaf [" << leaf->count << " key] Rp" << leaf->keys[0]
+                 << " .. Rp" << leaf->keys[leaf->count - 1] << "\n";
+            return;
+        }
+
+        const BPlusInner* inner = (const BPlusInner*)node;
+        cout << "Node [";
+        for (int i = 0; i < inner->count; i++) {
+            cout << (i ? " | " : "") << "Rp" << inner->keys[i];
+        }
+        cout << "]\n";
+        for (int i = 0; i <= inner->count; i++) {
+            visualizeRec(inner->children[i], level - 1, indent + 4);
+        }
+    }
+
+public:
+    explicit BPlusTree(TransactionStore& transactions)
+        : root(NULL), firstLeaf(NULL), height(0), nodeCount(0), leafCount(0),
+          innerCount(0), store(transactions) {}
+
+    // Simpan record ke store lalu index jumlahnya
+    void insert(const Transaksi& t) {
+        insertRecord(store.append(t), t.jumlah);
+    }
+
+    // Index record yang sudah ada di store
+    void insertRecord(uint32_t rec, double key) {
+        if (root == NULL) {
+            firstLeaf = newLeaf();
+            root = firstLeaf;
+            height = 1;
+        }
+
+        double sepKey;
+        uint32_t sepRec;
+        BPlusNode* split = insertRec(root, height - 1, key, rec, sepKey, sepRec);
+        nodeCount++;
+        if (split == NULL) return;
+
+        // Root terpecah -> tree bertambah 1 level
+        BPlusInner* newRoot = newInner();
+        newRoot->count = 1;
+        newRoot->keys[0] = sepKey;
+        newRoot->recs[0] = sepRec;
+        setChild(newRoot, 0, root, height - 1);
+        setChild(newRoot, 1, split, height - 1);
+        root = newRoot;
+        height++;
+    }
+
+    /*
+     * BULK BUILD - Bangun tree dari data yang SUDAH TERURUT (jumlah)
+     * - Leaf diisi penuh dari kiri ke kanan, lalu setiap level internal
+     *   dibangun dari key terkecil level di bawahnya: O(n)
+     * Hanya untuk tree kosong (dipakai saat load awal).
+     */
+    void buildFromSorted(const Transaksi* const* sorted, int n) {
+        if (root != NULL) {
+            for (int i = 0; i < n; i++) {
+                insert(*sorted[i]);
+            }
+            return;
+        }
+        if (n == 0) return;
+
+        vector<BPlusNode*> level;
+        vector<double> minKeys;
+        vector<uint32_t> minRecs;
+
+        BPlusLeaf* prev = NULL;
+        uint32_t firstRec = store.appendBulk(sorted, n);
+        for (int i = 0; i < n; i++) {
+            uint32_t rec = firstRec + i;
+            if (prev == NULL || prev->count == BPLUS_LEAF_KEYS) {
+                BPlusLeaf* leaf = newLeaf();
+                if (prev != NULL) prev->next = leaf;
+                else firstLeaf = leaf;
+                prev = leaf;
+                level.push_back(leaf);
+                minKeys.push_back(sorted[i]->jumlah);
+                minRecs.push_back(rec);
+            }
+            prev->keys[prev->count] = sorted[i]->jumlah;
+            prev->recs[prev->count] = rec;
+            prev->count++;
+        }
+        height = 1;
+
+        while (level.size() > 1) {
+            vector<BPlusNode*> parents;
+            vector<double> parentKeys;
+            vector<uint32_t> parentRecs;
+
+            for (size_t i = 0; i < level.size(); i += BPLUS_INNER_KEYS + 1) {
+                size_t end = i + BPLUS_INNER_KEYS + 1;
+                if (end > level.size()) end = level.size();
+
+                BPlusInner* inner = newInner();
+                setChild(inner, 0, level[i], height - 1);
+                for (size_t j = i + 1; j < end; j++) {
+                    inner->keys[inner->count] = minKeys[j];
+                    inner->recs[inner->count] = minRecs[j];
+                    inner->count++;
+                    setChild(inner, inner->count, level[j], height - 1);
+                }
+                parents.push_back(inner);
+                parentKeys.push_back(minKeys[i]);
+                parentRecs.push_back(minRecs[i]);
+            }
+
+            level.swap(parents);
+            minKeys.swap(parentKeys);
+            minRecs.swap(parentRecs);
+            height++;
+        }
+
+        root = level[0];
+        nodeCount = n;
+    }
+
+    void visualize() const {
+        if (root == NULL) {
+            cout << "      Tree kosong.\n";
+            return;
+        }
+        cout << "\n      Struktur B+ Tree (separator di node, rentang jumlah di leaf):\n";
+        visualizeRec(root, height - 1, 6);
+    }
+
+    void displayInfo() const {
+        cout << "\n      === Informasi B+ Tree ===\n";
+        cout << "      Total Key          : " << nodeCount << " transaksi\n";
+        cout << "      Tinggi Tree        : " << height << " level\n";
+        cout << "      Leaf / Internal    : " << leafCount << " / " << innerCount << " node\n";
+        if (leafCount > 0) {
+            cout << "      Rata-rata Isi Leaf : "
+                 << (int)(100.0 * nodeCount / ((double)leafCount * BPLUS_LEAF_KEYS) + 0.5) << "%\n";
+        }
+        cout << "\n      KONSEP B+ TREE:\n";
+        cout << "      - Setiap node memuat hingga " << BPLUS_LEAF_KEYS << " key (beberapa cache line)\n";
+        cout << "      - Semua data di leaf, leaf saling tersambung\n";
+        cout << "      - Range query: 1x turun ke leaf, lalu baca leaf berurutan\n";
+    }
+
+    bool isEmpty() const {
+        return root == NULL;
+    }
+
+    int getNodeCount() const {
+        return nodeCount;
+    }
+
+    int getHeight() const {
+        return height;
+    }
+
+    const TransactionStore& getStore() const {
+        return store;
+    }
+
+    // Memori yang dipakai node index (tidak termasuk store)
+    size_t indexBytes() const {
+        return leafPool.reservedBytes() + innerPool.reservedBytes();
+    }
+
+    // ---- Cursor ----
+
+    Cursor begin() const {
+        Cursor c;
+        c.tree = this;
+        c.leaf = nodeCount > 0 ? firstLeaf : NULL;
+        return c;
+    }
+
+    // Cursor di key pertama >= (key, rec)
+    Cursor seek(const PageToken& token) const {
+        Cursor c;
+        c.tree = this;
+        if (root == NULL) return c;
+
+        c.leaf = descend(token.key, token.rec);
+        c.pos = leafLowerBound(c.leaf, token.key, token.rec);
+        if (c.pos >= c.leaf->count) {
+            c.leaf = c.leaf->next;
+            c.pos = 0;
+        }
+        return c;
+    }
+
+    // Cursor di transaksi pertama dengan jumlah >= amount
+    Cursor lowerBound(double amount) const {
+        return seek(PageToken(amount, 0));
+    }
+
+    // Cursor di transaksi pertama dengan jumlah > amount
+    Cursor upperBound(double amount) const {
+        return seek(PageToken(nextafter(amount, DBL_MAX), 0));
+    }
+
+    // Kunjungi semua transaksi secara inorder (urut jumlah)
+    template <typename Fn>
+    void forEachInorder(Fn fn) const {
+        for (Cursor c = begin(); c.valid(); c.next()) {
+            fn(c.record());
+        }
+    }
+
+    // Banyak transaksi dengan jumlah di [min, max]: O(log n)
+    int countInRange(double min, double max) const {
+        if (max < min) return 0;
+        uint32_t upper, lower;
+        double upperSum, lowerSum;
+        countBelow(nextafter(max, DBL_MAX), upper, upperSum);
+        countBelow(min, lower, lowerSum);
+        return (int)(upper - lower);
+    }
+
+    // Total jumlah transaksi dengan jumlah di [min, max]: O(log n)
+    double sumInRange(double min, double max) const {
+        if (max < min) return 0.0;
+        uint32_t upper, lower;
+        double upperSum, lowerSum;
+        countBelow(nextafter(max, DBL_MAX), upper, upperSum);
+        countBelow(min, lower, lowerSum);
+        return upperSum - lowerSum;
+    }
+
+    // Transaksi ke-k (0-based, urut jumlah), NULL jika k di luar jangkauan
+    const TransaksiRecord* kth(int k) const {
+        if (k < 0 || k >= nodeCount) return NULL;
+        int pos;
+        const BPlusLeaf* leaf = kthLeaf((uint32_t)k, pos);
+        return &store[leaf->recs[pos]];
+    }
+
+    // Jumlah pada persentil p (0-100, nearest rank), 0 jika tree kosong
+    double percentile(double p) const {
+        if (nodeCount == 0) return 0.0;
+        int k = (int)ceil(p / 100.0 * nodeCount) - 1;
+        if (k < 0) k = 0;
+        if (k >= nodeCount) k = nodeCount - 1;
+        int pos;
+        const BPlusLeaf* leaf = kthLeaf((uint32_t)k, pos);
+        return leaf->keys[pos];
+    }
+
+    // Kunjungi nomor record dengan jumlah di [min, max] tanpa membaca record
+    template <typename Fn>
+    void forEachRecInRange(double min, double max, Fn fn) const {
+        for (Cursor c = lowerBound(min); c.valid() && c.key() <= max; c.next()) {
+            fn(c.rec());
+        }
+    }
+
+    // Kunjungi transaksi dengan jumlah di [min, max] secara inorder
+    template <typename Fn>
+    void forEachInRange(double min, double max, Fn fn) const {
+        forEachRecInRange(min, max, [&](uint32_t rec) { fn(store[rec]); });
+    }
+};
+
+#endif
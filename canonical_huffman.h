@@ -0,0 +1,522 @@
+#ifndef CANONICAL_HUFFMAN_H
+#define CANONICAL_HUFFMAN_H
+
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// =================================================================
+// CANONICAL HUFFMAN - Kode Huffman Kanonik & Bit Stream Padat
+// =================================================================
+/*
+ * SEBELUMNYA: hasil encode berupa string '0'/'1' (1 byte per bit)
+ * -> 8x lebih besar dari data "terkompresi" yang dilaporkan.
+ *
+ * KODE KANONIK:
+ * - Yang disimpan hanya PANJANG kode per simbol (maks. 15 bit)
+ * - Kode diberikan ulang secara deterministik: urut (panjang, simbol),
+ *   kode berikutnya = (kode sebelumnya + 1) << (selisih panjang)
+ *   -> encoder & decoder mendapat kode yang sama dari panjangnya saja
+ *
+ * FORMAT STREAM: [panjang teks: varint][tabel panjang kode][bit kode]
+ * - Tabel sparse: [n][n simbol urut][n/2 byte panjang (4 bit)]
+ *   atau dense (banyak simbol): [0][128 byte panjang 4 bit]
+ * - Bit kode ditulis MSB-first lewat akumulator 64-bit, dikeluarkan
+ *   per 32 bit (bukan per bit / per byte)
+ *
+ * DECODE (HuffmanDecoder):
+ * - Tabel lookup 2^11 entry diindeks 11 bit berikutnya; 1 entry berisi
+ *   hingga 4 simbol yang kodenya muat utuh di 11 bit itu -> beberapa
+ *   simbol per lookup (stream pendek: tabel lebih kecil)
+ * - Kode yang lebih panjang dari 11 bit (jarang): batas kode kanonik per
+ *   panjang (first code + jumlah kode), tanpa menelusuri pohon
+ */
+const int HUFFMAN_MAX_CODE_LENGTH = 15;
+const int HUFFMAN_TABLE_BITS = 11;
+const int HUFFMAN_SYMBOLS_PER_ENTRY = 4;
+const size_t HUFFMAN_DENSE_TABLE_BYTES = 128;
+
+// ---- Varint (7 bit per byte, bit 8 = lanjut) ----
+inline void putVarint(vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t b = *p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+// Penulis bit MSB-first dengan akumulator 64-bit
+class BitWriter {
+private:
+    vector<uint8_t>& out;
+    uint64_t acc;
+    int bits;                       // Bit yang belum ditulis di acc (< 32)
+
+public:
+    explicit BitWriter(vector<uint8_t>& target) : out(target), acc(0), bits(0) {}
+
+    // Tulis len bit terbawah code (len <= 32)
+    void put(uint32_t code, int len) {
+        acc = (acc << len) | code;
+        bits += len;
+        if (bits >= 32) {
+            bits -= 32;
+            uint32_t word = (uint32_t)(acc >> bits);
+            uint8_t bytes[4] = {(uint8_t)(word >> 24), (uint8_t)(word >> 16),
+                                (uint8_t)(word >> 8), (uint8_t)word};
+            out.insert(out.end(), bytes, bytes + 4);
+        }
+    }
+
+    // Keluarkan sisa bit, byte terakhir diisi 0
+    void flush() {
+        while (bits > 0) {
+            int take = bits >= 8 ? 8 : bits;
+            out.push_back((uint8_t)((acc >> (bits - take)) << (8 - take)));
+            bits -= take;
+        }
+        acc = 0;
+    }
+};
+
+struct CanonicalHuffman {
+    uint8_t length[256];            // 0 = simbol tidak dipakai
+    uint32_t code[256];
+
+    CanonicalHuffman() {
+        clear();
+    }
+
+    void clear() {
+        memset(length, 0, sizeof(length));
+        memset(code, 0, sizeof(code));
+    }
+
+    int symbolCount() const {
+        int n = 0;
+        for (int s = 0; s < 256; s++) {
+            if (length[s] > 0) n++;
+        }
+        return n;
+    }
+
+    /*
+     * Panjang kode Huffman langsung dari frekuensi, tanpa node pohon:
+     * leaf urut frekuensi + antrian node gabungan (selalu terbentuk urut
+     * naik) -> 2 node terkecil selalu ada di depan salah satu antrian.
+     * Lebih dari 15 bit: frekuensi dibagi 2 (minimal 1) lalu diulang.
+     */
+    void buildFromFrequencies(const uint64_t* frequencies) {
+        clear();
+        uint64_t freq[256];
+        memcpy(freq, frequencies, sizeof(freq));
+
+        while (true) {
+            int symbols[256], n = 0;
+            for (int s = 0; s < 256; s++) {
+                if (freq[s] > 0) symbols[n++] = s;
+            }
+            if (n == 0) return;
+            if (n == 1) {
+                length[symbols[0]] = 1;
+                break;
+            }
+            sort(symbols, symbols + n, [&](int a, int b) {
+                return freq[a] < freq[b] || (freq[a] == freq[b] && a < b);
+            });
+
+            // Node 0..n-1 = leaf, n..2n-2 = gabungan (parent selalu > anak)
+            uint64_t weight[511];
+            int parent[511];
+            for (int i = 0; i < n; i++) weight[i] = freq[symbols[i]];
+            int leaf = 0, merged = n;
+            for (int next = n; next < 2 * n - 1; next++) {
+                int pick[2];
+                for (int k = 0; k < 2; k++) {
+                    bool useLeaf = leaf < n && (merged >= next || weight[leaf] <= weight[merged]);
+                    pick[k] = useLeaf ? leaf++ : merged++;
+                }
+                weight[next] = weight[pick[0]] + weight[pick[1]];
+                parent[pick[0]] = parent[pick[1]] = next;
+            }
+
+            int depth[511];
+            int maxDepth = 0;
+            depth[2 * n - 2] = 0;
+            for (int i = 2 * n - 3; i >= 0; i--) {
+                depth[i] = depth[parent[i]] + 1;
+                if (i < n && depth[i] > maxDepth) maxDepth = depth[i];
+            }
+            if (maxDepth <= HUFFMAN_MAX_CODE_LENGTH) {
+                for (int i = 0; i < n; i++) length[symbols[i]] = (uint8_t)depth[i];
+                break;
+            }
+            for (int s = 0; s < 256; s++) {
+                if (freq[s] > 0) freq[s] = (freq[s] >> 1) | 1;
+            }
+        }
+        assignCodes();
+    }
+
+    // Beri kode kanonik dari panjang kode: urut (panjang, simbol)
+    void assignCodes() {
+        int lengthCount[HUFFMAN_MAX_CODE_LENGTH + 1] = {0};
+        for (int s = 0; s < 256; s++) {
+            lengthCount[length[s]]++;
+        }
+        lengthCount[0] = 0;
+
+        uint32_t next[HUFFMAN_MAX_CODE_LENGTH + 2];
+        uint32_t c = 0;
+        for (int len = 1; len <= HUFFMAN_MAX_CODE_LENGTH; len++) {
+            c = (c + lengthCount[len - 1]) << 1;
+            next[len] = c;
+        }
+        for (int s = 0; s < 256; s++) {
+            if (length[s] > 0) code[s] = next[length[s]]++;
+        }
+    }
+
+    // Serialisasi tabel (hanya panjang kode), return jumlah byte
+    size_t writeTable(vector<uint8_t>& out) const {
+        size_t start = out.size();
+        int n = symbolCount();
+        size_t sparseBytes = 1 + n + (n + 1) / 2;
+
+        if (n > 0 && sparseBytes <= 1 + HUFFMAN_DENSE_TABLE_BYTES) {
+            out.push_back((uint8_t)n);
+            uint8_t symbols[256], lengths[256];
+            int k = 0;
+            for (int s = 0; s < 256; s++) {
+                if (length[s] > 0) {
+                    symbols[k] = (uint8_t)s;
+                    lengths[k] = length[s];
+                    k++;
+                }
+            }
+            out.insert(out.end(), symbols, symbols + n);
+            for (int i = 0; i < n; i += 2) {
+                uint8_t hi = lengths[i];
+                uint8_t lo = i + 1 < n ? lengths[i + 1] : 0;
+                out.push_back((uint8_t)(hi << 4 | lo));
+            }
+        } else {
+            out.push_back(0);
+            for (int s = 0; s < 256; s += 2) {
+                out.push_back((uint8_t)(length[s] << 4 | length[s + 1]));
+            }
+        }
+        return out.size() - start;
+    }
+
+    // Baca tabel lalu hitung ulang kode kanonik
+    bool readTable(const uint8_t*& p, const uint8_t* end) {
+        clear();
+        if (p >= end) return false;
+
+        int n = *p++;
+        if (n > 0) {
+            size_t need = n + (n + 1) / 2;
+            if ((size_t)(end - p) < need) return false;
+            const uint8_t* symbols = p;
+            const uint8_t* lengths = p + n;
+            for (int i = 0; i < n; i++) {
+                uint8_t packed = lengths[i / 2];
+                length[symbols[i]] = (i % 2 == 0) ? packed >> 4 : packed & 0x0F;
+            }
+            p += need;
+        } else {
+            if ((size_t)(end - p) < HUFFMAN_DENSE_TABLE_BYTES) return false;
+            for (int s = 0; s < 256; s += 2) {
+                length[s] = p[s / 2] >> 4;
+                length[s + 1] = p[s / 2] & 0x0F;
+            }
+            p += HUFFMAN_DENSE_TABLE_BYTES;
+        }
+        assignCodes();
+        return true;
+    }
+
+    // Tulis bit kode untuk n byte teks (tanpa header/tabel)
+    void encodeBits(const char* text, size_t n, BitWriter& writer) const {
+        for (size_t i = 0; i < n; i++) {
+            unsigned char s = (unsigned char)text[i];
+            writer.put(code[s], length[s]);
+        }
+    }
+
+    // Jumlah bit kode untuk teks (tanpa header/tabel)
+    uint64_t encodedBits(const char* text, size_t n) const {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < n; i++) {
+            bits += length[(unsigned char)text[i]];
+        }
+        return bits;
+    }
+
+    /*
+     * Stream lengkap: [panjang][tabel][bit]. Return jumlah byte yang
+     * ditulis, 0 jika ada simbol teks yang tidak punya kode.
+     */
+    size_t encode(const char* text, size_t n, vector<uint8_t>& out) const {
+        for (size_t i = 0; i < n; i++) {
+            if (length[(unsigned char)text[i]] == 0) return 0;
+        }
+        size_t start = out.size();
+        putVarint(out, n);
+        writeTable(out);
+        BitWriter writer(out);
+        encodeBits(text, n, writer);
+        writer.flush();
+        return out.size() - start;
+    }
+
+    /*
+     * Decode referensi: bit demi bit dengan batas kode kanonik per
+     * panjang (first code + jumlah kode). Dipakai untuk verifikasi dan
+     * pembanding benchmark; jalur utama = HuffmanDecoder. out diisi
+     * teks + '\0'. Return false jika stream rusak atau out terlalu kecil.
+     */
+    static bool decodeBitwise(const uint8_t* data, size_t size, char* out, size_t outSize) {
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        uint64_t n;
+        CanonicalHuffman table;
+        if (!getVarint(p, end, n) || n >= outSize || !table.readTable(p, end)) return false;
+
+        // Simbol urut (panjang, simbol) = urut kode kanonik
+        int lengthCount[HUFFMAN_MAX_CODE_LENGTH + 1] = {0};
+        uint8_t sorted[256];
+        int k = 0;
+        for (int len = 1; len <= HUFFMAN_MAX_CODE_LENGTH; len++) {
+            for (int s = 0; s < 256; s++) {
+                if (table.length[s] == len) {
+                    sorted[k++] = (uint8_t)s;
+                    lengthCount[len]++;
+                }
+            }
+        }
+
+        uint64_t bitPos = 0, totalBits = (uint64_t)(end - p) * 8;
+        for (uint64_t i = 0; i < n; i++) {
+            uint32_t c = 0;
+            int first = 0, index = 0, len = 1;
+            for (; len <= HUFFMAN_MAX_CODE_LENGTH; len++) {
+                if (bitPos >= totalBits) return false;
+                c |= (p[bitPos >> 3] >> (7 - (bitPos & 7))) & 1;
+                bitPos++;
+                int count = lengthCount[len];
+                if ((int)c - first < count) break;
+                index += count;
+                first = (first + count) << 1;
+                c <<= 1;
+            }
+            if (len > HUFFMAN_MAX_CODE_LENGTH) return false;
+            out[i] = (char)sorted[index + (c - first)];
+        }
+        out[n] = '\0';
+        return true;
+    }
+};
+
+struct HuffmanTableEntry {
+    uint8_t symbols[HUFFMAN_SYMBOLS_PER_ENTRY];
+    uint8_t count;                  // 0 = kode lebih panjang dari tableBits
+    uint8_t bits;                   // Total bit semua simbol di entry
+    uint8_t firstBits;              // Bit simbol pertama saja
+    uint8_t reserved;
+};
+
+class HuffmanDecoder {
+private:
+    int tableBits;
+    int maxLength;
+    vector<HuffmanTableEntry> table;
+    int lengthCount[HUFFMAN_MAX_CODE_LENGTH + 1];
+    uint32_t firstCode[HUFFMAN_MAX_CODE_LENGTH + 1];
+    int firstIndex[HUFFMAN_MAX_CODE_LENGTH + 1];
+    uint8_t sorted[256];            // Simbol urut kode kanonik
+
+    // Simbol dengan kode code sepanjang len, -1 jika bukan kode valid
+    int symbolOf(uint32_t code, int len) const {
+        uint32_t offset = code - firstCode[len];
+        return offset < (uint32_t)lengthCount[len] ? sorted[firstIndex[len] + offset] : -1;
+    }
+
+    // Decode 1 simbol dari awal window (width bit, MSB-first) dengan kode <= width bit
+    int matchPrefix(uint32_t window, int width, int& len) const {
+        int limit = width < maxLength ? width : maxLength;
+        for (len = 1; len <= limit; len++) {
+            int s = symbolOf(window >> (width - len), len);
+            if (s >= 0) return s;
+        }
+        return -1;
+    }
+
+public:
+    HuffmanDecoder() : tableBits(0), maxLength(0) {}
+
+    explicit HuffmanDecoder(const CanonicalHuffman& code, size_t expectedSymbols = 0)
+        : tableBits(0), maxLength(0) {
+        init(code, expectedSymbols);
+    }
+
+    /*
+     * Siapkan tabel dari panjang kode (kode kanonik sama dengan encoder).
+     * expectedSymbols > 0 (stream pendek): tabel diperkecil sampai
+     * panjang kode maks. agar biaya membangunnya tidak melebihi decode.
+     */
+    void init(const CanonicalHuffman& code, size_t expectedSymbols = 0) {
+        memset(lengthCount, 0, sizeof(lengthCount));
+        maxLength = 0;
+        for (int s = 0; s < 256; s++) {
+            lengthCount[code.length[s]]++;
+            if (code.length[s] > maxLength) maxLength = code.length[s];
+        }
+        lengthCount[0] = 0;
+
+        uint32_t c = 0;
+        int index = 0;
+        firstCode[0] = 0;
+        firstIndex[0] = 0;
+        for (int len = 1; len <= HUFFMAN_MAX_CODE_LENGTH; len++) {
+            c = (c + lengthCount[len - 1]) << 1;
+            firstCode[len] = c;
+            firstIndex[len] = index;
+            index += lengthCount[len];
+        }
+
+        // Simbol urut (panjang, simbol) = urut kode kanonik (counting sort)
+        int next[HUFFMAN_MAX_CODE_LENGTH + 1];
+        memcpy(next, firstIndex, sizeof(next));
+        for (int s = 0; s < 256; s++) {
+            if (code.length[s] > 0) sorted[next[code.length[s]]++] = (uint8_t)s;
+        }
+
+        tableBits = HUFFMAN_TABLE_BITS;
+        while (expectedSymbols > 0 && tableBits > 1 && tableBits > maxLength &&
+               ((size_t)1 << tableBits) > expectedSymbols) {
+            tableBits--;
+        }
+        table.assign((size_t)1 << tableBits, HuffmanTableEntry());
+
+        // Setiap entry: decode serakah selama kode berikutnya muat di sisa bit
+        for (uint32_t i = 0; i < table.size(); i++) {
+            HuffmanTableEntry& e = table[i];
+            int used = 0;
+            while (e.count < HUFFMAN_SYMBOLS_PER_ENTRY) {
+                int rest = tableBits - used;
+                if (rest <= 0) break;
+                int len;
+                int s = matchPrefix(i & ((1u << rest) - 1), rest, len);
+                if (s < 0) break;
+                e.symbols[e.count++] = (uint8_t)s;
+                if (e.count == 1) e.firstBits = (uint8_t)len;
+                used += len;
+            }
+            e.bits = (uint8_t)used;
+        }
+    }
+
+    /*
+     * Decode tepat n simbol dari bit stream data[0..size) ke out
+     * (kapasitas minimal n). Return false jika stream rusak/terpotong.
+     */
+    bool decode(const uint8_t* data, size_t size, size_t n, char* out) const {
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        uint64_t buf = 0;               // Bit berikutnya di posisi MSB
+        int avail = 0;
+        uint64_t consumed = 0, totalBits = (uint64_t)size * 8;
+        size_t produced = 0;
+        int shift = 64 - tableBits;
+
+        while (produced < n) {
+            // Isi ulang buffer: selalu >= 57 bit (atau sisa stream + nol)
+            if (avail <= 56) {
+                if (end - p >= 8) {
+                    uint64_t word = 0;
+                    for (int i = 0; i < 8; i++) word = word << 8 | p[i];
+                    // Bit setelah byte yang diambil ikut terisi bit stream
+                    // yang benar -> OR berikutnya tidak mengubahnya
+                    int take = (63 - avail) >> 3;
+                    buf |= word >> avail;
+                    p += take;
+                    avail += take * 8;
+                } else {
+                    while (avail <= 56) {
+                        if (p < end) buf |= (uint64_t)*p++ << (56 - avail);
+                        avail += 8;
+                    }
+                }
+            }
+
+            const HuffmanTableEntry& e = table[buf >> shift];
+            if (e.count > 0) {
+                if (n - produced >= HUFFMAN_SYMBOLS_PER_ENTRY) {
+                    memcpy(out + produced, e.symbols, HUFFMAN_SYMBOLS_PER_ENTRY);
+                    produced += e.count;
+                    buf <<= e.bits;
+                    avail -= e.bits;
+                    consumed += e.bits;
+                } else {
+                    out[produced++] = (char)e.symbols[0];
+                    buf <<= e.firstBits;
+                    avail -= e.firstBits;
+                    consumed += e.firstBits;
+                }
+                continue;
+            }
+
+            // Kode lebih panjang dari tableBits
+            int len;
+            int s = -1;
+            for (len = tableBits + 1; len <= maxLength && s < 0; len++) {
+                s = symbolOf((uint32_t)(buf >> (64 - len)), len);
+            }
+            if (s < 0) return false;
+            len--;
+            out[produced++] = (char)s;
+            buf <<= len;
+            avail -= len;
+            consumed += len;
+        }
+        return consumed <= totalBits;
+    }
+
+    /*
+     * Decode stream lengkap dari CanonicalHuffman::encode().
+     * out diisi teks + '\0'. Return false jika rusak/out terlalu kecil.
+     */
+    static bool decodeStream(const uint8_t* data, size_t size, char* out, size_t outSize) {
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        uint64_t n;
+        CanonicalHuffman code;
+        if (!getVarint(p, end, n) || n >= outSize || !code.readTable(p, end)) return false;
+
+        HuffmanDecoder decoder(code, (size_t)n);
+        if (!decoder.decode(p, end - p, (size_t)n, out)) return false;
+        out[n] = '\0';
+        return true;
+    }
+
+    int getTableBits() const { return tableBits; }
+    size_t tableBytes() const { return table.size() * sizeof(HuffmanTableEntry); }
+};
+
+#endif
@@ -0,0 +1,274 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include "data_structures.h"
+#include "account_store.h"
+#include "transaction_log.h"
+
+using namespace std;
+
+// =================================================================
+// CHECKPOINT - Snapshot Biner untuk Restart Cepat
+// =================================================================
+/*
+ * ISI CHECKPOINT:
+ * - Image semua akun (data User)
+ * - Semua transaksi di AVL Tree, sudah terurut (inorder)
+ * - Refund request di Stack dan tiket di Queue yang masih pending
+ * - LSN: posisi WAL yang sudah tercakup oleh checkpoint ini
+ *
+ * SAAT STARTUP:
+ * 1. Pilih checkpoint valid (CRC cocok) dengan LSN terbesar
+ * 2. Bangun AVL Tree langsung dari data terurut (tanpa parsing teks)
+ * 3. Replay hanya record WAL setelah LSN checkpoint
+ * -> Waktu restart tergantung aktivitas terbaru, bukan total riwayat
+ *
+ * Checkpoint ditulis bergantian ke 2 slot file (checkpoint.0.ckp dan
+ * checkpoint.1.ckp), sehingga jika penulisan terputus, checkpoint
+ * sebelumnya masih utuh.
+ *
+ * FORMAT: [CheckpointHeader][payload]
+ * Payload berisi string dengan prefix panjang (bukan char array penuh)
+ * agar ukurannya kompak.
+ */
+const uint32_t CHECKPOINT_VERSION = 2;     // v2: waktu transaksi = int64 epoch
+
+struct CheckpointHeader {
+    char magic[8];              // "EWCKPT\0\0"
+    uint32_t version;
+    uint32_t payloadCrc;
+    uint64_t payloadSize;
+    uint64_t lsn;               // Posisi WAL yang sudah tercakup
+    uint64_t legacySize;        // Ukuran transactions.txt saat checkpoint
+    uint64_t accountCount;
+    uint64_t transactionCount;
+    uint64_t refundCount;
+    uint64_t ticketCount;
+};
+
+// Penulis payload biner (little-endian, string dengan prefix panjang)
+class CheckpointWriter {
+private:
+    vector<char> buf;
+
+public:
+    void putRaw(const void* data, size_t len) {
+        buf.insert(buf.end(), (const char*)data, (const char*)data + len);
+    }
+
+    void putDouble(double v) { putRaw(&v, sizeof(v)); }
+    void putInt64(int64_t v) { putRaw(&v, sizeof(v)); }
+
+    void putString(const char* s) {
+        size_t len = strlen(s);
+        if (len > 65535) len = 65535;
+        uint16_t n = (uint16_t)len;
+        putRaw(&n, sizeof(n));
+        putRaw(s, len);
+    }
+
+    const vector<char>& data() const { return buf; }
+};
+
+// Pembaca payload; ok() menjadi false jika data terpotong
+class CheckpointReader {
+private:
+    const char* pos;
+    const char* end;
+    bool valid;
+
+public:
+    CheckpointReader(const char* begin, const char* finish)
+        : pos(begin), end(finish), valid(true) {}
+
+    bool ok() const { return valid; }
+
+    void getRaw(void* out, size_t len) {
+        if (!valid || (size_t)(end - pos) < len) {
+            valid = false;
+            memset(out, 0, len);
+            return;
+        }
+        memcpy(out, pos, len);
+        pos += len;
+    }
+
+    double getDouble() {
+        double v;
+        getRaw(&v, sizeof(v));
+        return v;
+    }
+
+    int64_t getInt64() {
+        int64_t v;
+        getRaw(&v, sizeof(v));
+        return v;
+    }
+
+    void getString(char* dest, size_t size) {
+        uint16_t n = 0;
+        getRaw(&n, sizeof(n));
+        if (!valid || (size_t)(end - pos) < n) {
+            valid = false;
+            dest[0] = '\0';
+            return;
+        }
+        size_t len = n < size - 1 ? n : size - 1;
+        memcpy(dest, pos, len);
+        dest[len] = '\0';
+        pos += n;
+    }
+};
+
+// ---- Encode / decode per jenis data ----
+inline void putAccount(CheckpointWriter& w, const AccountRecord& r) {
+    w.putDouble(r.saldo);
+    w.putString(r.username);
+    w.putString(r.password);
+    w.putString(r.pin);
+    w.putString(r.nik);
+    w.putString(r.namaLengkap);
+    w.putString(r.alamat);
+    w.putString(r.tanggalLahir);
+}
+
+inline void getAccount(CheckpointReader& r, AccountRecord& rec) {
+    memset(&rec, 0, sizeof(rec));
+    rec.saldo = r.getDouble();
+    r.getString(rec.username, sizeof(rec.username));
+    r.getString(rec.password, sizeof(rec.password));
+    r.getString(rec.pin, sizeof(rec.pin));
+    r.getString(rec.nik, sizeof(rec.nik));
+    r.getString(rec.namaLengkap, sizeof(rec.namaLengkap));
+    r.getString(rec.alamat, sizeof(rec.alamat));
+    r.getString(rec.tanggalLahir, sizeof(rec.tanggalLahir));
+}
+
+inline void putTransaksi(CheckpointWriter& w, const TransaksiBase& t, const char* keterangan) {
+    w.putString(t.id);
+    w.putInt64(t.waktu);
+    w.putString(t.jenis);
+    w.putString(t.dari);
+    w.putString(t.ke);
+    w.putDouble(t.jumlah);
+    w.putString(keterangan);
+}
+
+inline void putTransaksi(CheckpointWriter& w, const Transaksi& t) {
+    putTransaksi(w, t, t.keterangan);
+}
+
+inline void putTransaksi(CheckpointWriter& w, const TransaksiRecord& t) {
+    char keterangan[KETERANGAN_MAX_LENGTH];
+    putTransaksi(w, t, t.keteranganText(keterangan));
+}
+
+inline void getTransaksi(CheckpointReader& r, Transaksi& t) {
+    r.getString(t.id, sizeof(t.id));
+    t.waktu = r.getInt64();
+    r.getString(t.jenis, sizeof(t.jenis));
+    r.getString(t.dari, sizeof(t.dari));
+    r.getString(t.ke, sizeof(t.ke));
+    t.jumlah = r.getDouble();
+    r.getString(t.keterangan, sizeof(t.keterangan));
+}
+
+inline void putRefund(CheckpointWriter& w, const RefundRequest& req) {
+    w.putString(req.username);
+    w.putString(req.transactionId);
+    w.putString(req.alasan);
+    w.putDouble(req.jumlah);
+    w.putString(req.timestamp);
+    w.putString(req.status);
+}
+
+inline void getRefund(CheckpointReader& r, RefundRequest& req) {
+    r.getString(req.username, sizeof(req.username));
+    r.getString(req.transactionId, sizeof(req.transactionId));
+    r.getString(req.alasan, sizeof(req.alasan));
+    req.jumlah = r.getDouble();
+    r.getString(req.timestamp, sizeof(req.timestamp));
+    r.getString(req.status, sizeof(req.status));
+}
+
+inline void putTicket(CheckpointWriter& w, const CSTicket& ticket) {
+    w.putString(ticket.username);
+    w.putString(ticket.pesan);
+    w.putString(ticket.timestamp);
+    w.putString(ticket.status);
+}
+
+inline void getTicket(CheckpointReader& r, CSTicket& ticket) {
+    r.getString(ticket.username, sizeof(ticket.username));
+    r.getString(ticket.pesan, sizeof(ticket.pesan));
+    r.getString(ticket.timestamp, sizeof(ticket.timestamp));
+    r.getString(ticket.status, sizeof(ticket.status));
+}
+
+// ---- File checkpoint ----
+
+// Tulis header + payload ke file sementara, fsync, lalu rename
+inline bool writeCheckpointFile(const char* path, CheckpointHeader& header,
+                                const vector<char>& payload) {
+    memset(header.magic, 0, sizeof(header.magic));
+    memcpy(header.magic, "EWCKPT", 6);
+    header.version = CHECKPOINT_VERSION;
+    header.payloadSize = payload.size();
+    header.payloadCrc = crc32(payload.data(), payload.size());
+
+    char tmpPath[260];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+    FILE* f = fopen(tmpPath, "wb");
+    if (f == NULL) return false;
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+              (payload.empty() || fwrite(payload.data(), payload.size(), 1, f) == 1) &&
+              fflush(f) == 0;
+#ifndef _WIN32
+    if (ok) ok = fsync(fileno(f)) == 0;
+#endif
+    fclose(f);
+
+    if (!ok) {
+        remove(tmpPath);
+        return false;
+    }
+    remove(path);
+    return rename(tmpPath, path) == 0;
+}
+
+// Baca checkpoint dan cek magic, versi dan CRC payload
+inline bool readCheckpointFile(const char* path, CheckpointHeader& header, vector<char>& payload) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return false;
+
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+              memcmp(header.magic, "EWCKPT", 6) == 0 &&
+              header.version == CHECKPOINT_VERSION;
+    if (ok) {
+        payload.resize(header.payloadSize);
+        ok = header.payloadSize == 0 || fread(payload.data(), header.payloadSize, 1, f) == 1;
+    }
+    fclose(f);
+
+    return ok && crc32(payload.data(), payload.size()) == header.payloadCrc;
+}
+
+// Hanya baca header (untuk memilih checkpoint terbaru)
+inline bool readCheckpointHeader(const char* path, CheckpointHeader& header) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return false;
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+              memcmp(header.magic, "EWCKPT", 6) == 0 &&
+              header.version == CHECKPOINT_VERSION;
+    fclose(f);
+    return ok;
+}
+
+#endif
@@ -0,0 +1,442 @@
+#ifndef CODEC_H
+#define CODEC_H
+
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+#include <algorithm>
+#include "canonical_huffman.h"
+
+using namespace std;
+
+// =================================================================
+// CODEC - Interface Kompresi per Kolom
+// =================================================================
+/*
+ * SEBELUMNYA: satu-satunya kompresi adalah HuffmanCoding (entropi per
+ * karakter). Keterangan transaksi sangat berulang (kalimat yang sama
+ * ribuan kali) -> kompresi kamus/LZ atau entropy coder pecahan bit
+ * (rANS) bisa jauh lebih hemat, tergantung kolomnya.
+ *
+ * INTERFACE:
+ * - train()      : latih model/kamus bersama dari contoh nilai kolom
+ *                  (disimpan sekali per kolom, tidak di setiap stream)
+ * - compress()   : 1 nilai -> stream [panjang: varint][isi]
+ * - decompress() : stream -> teks + '\0' (codec yang dilatih sama)
+ * Setiap nilai tetap bisa di-decode sendiri (akses acak per baris).
+ *
+ * CODEC:
+ * - stored  : tanpa kompresi (pembanding)
+ * - huffman : HuffmanCoding (data_structures.h), kode kanonik bersama
+ * - lz-dict : LZ77 dengan kamus nilai yang sering muncul
+ * - rans    : rANS order-0, frekuensi 12 bit bersama (per nilai kalah
+ *             dari huffman karena state 3 byte, lihat RansCodec)
+ */
+class Codec {
+public:
+    virtual ~Codec() {}
+
+    virtual const char* name() const = 0;
+
+    // Latih dari count contoh (string NUL-terminated). Default: tidak perlu.
+    virtual void train(const char* const* samples, size_t count) {
+        (void)samples;
+        (void)count;
+    }
+
+    // Tambahkan stream n byte teks ke out. Return jumlah byte, 0 jika tidak bisa.
+    virtual size_t compress(const char* text, size_t n, vector<uint8_t>& out) const = 0;
+
+    // out diisi teks + '\0'. Return false jika rusak / out terlalu kecil.
+    virtual bool decompress(const uint8_t* data, size_t size, char* out, size_t outSize) const = 0;
+};
+
+// Frekuensi byte semua contoh
+inline void countSampleBytes(const char* const* samples, size_t count, uint64_t* frequencies) {
+    memset(frequencies, 0, 256 * sizeof(uint64_t));
+    for (size_t i = 0; i < count; i++) {
+        for (const char* p = samples[i]; *p != '\0'; p++) {
+            frequencies[(unsigned char)*p]++;
+        }
+    }
+}
+
+// ---- stored: [panjang][byte asli] ----
+class StoredCodec : public Codec {
+public:
+    const char* name() const { return "stored"; }
+
+    size_t compress(const char* text, size_t n, vector<uint8_t>& out) const {
+        size_t start = out.size();
+        putVarint(out, n);
+        out.insert(out.end(), (const uint8_t*)text, (const uint8_t*)text + n);
+        return out.size() - start;
+    }
+
+    bool decompress(const uint8_t* data, size_t size, char* out, size_t outSize) const {
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        uint64_t n;
+        if (!getVarint(p, end, n) || n >= outSize || n != (uint64_t)(end - p)) return false;
+        memcpy(out, p, (size_t)n);
+        out[n] = '\0';
+        return true;
+    }
+};
+
+// =================================================================
+// LZ-DICT - LZ77 dengan Kamus Bersama
+// =================================================================
+/*
+ * Kamus = gabungan nilai kolom yang paling sering berulang (maks. 32 KB,
+ * nilai paling menguntungkan di ujung kamus -> offset paling kecil).
+ * Setiap nilai di-encode seolah-olah ditulis tepat setelah kamus:
+ * "Pembayaran Listrik PLN" yang ada di kamus = 1 match (2-4 byte).
+ *
+ * SEQUENCE (mirip LZ4):
+ * [token: 4 bit jumlah literal | 4 bit panjang match - 4]
+ * [literal...][offset: varint][tambahan panjang: varint jika nibble 15]
+ * Sequence terakhir hanya literal (berhenti saat panjang teks tercapai).
+ *
+ * Match dicari lewat hash 4 byte di kamus (rantai maks. 32 kandidat)
+ * dan 64 posisi sebelumnya di teks itu sendiri.
+ */
+const size_t LZ_DICT_MAX = 32 * 1024;
+const size_t LZ_DICT_UNIQUE_MAX = 4 * 1024;     // Nilai yang tidak berulang (mis. ID)
+const int LZ_MIN_MATCH = 4;
+const int LZ_HASH_BITS = 15;
+const int LZ_MAX_CHAIN = 32;
+const int LZ_LOCAL_WINDOW = 64;
+
+class LzDictCodec : public Codec {
+private:
+    vector<char> dict;
+    vector<int32_t> head;           // Hash 4 byte -> posisi terakhir di kamus
+    vector<int32_t> chain;          // Posisi sebelumnya dengan hash sama
+
+    static uint32_t hash4(const char* p) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+    }
+
+    static size_t matchLength(const char* a, const char* b, size_t limit) {
+        size_t len = 0;
+        while (len < limit && a[len] == b[len]) len++;
+        return len;
+    }
+
+    static void putLength(vector<uint8_t>& out, size_t value) {
+        if (value >= 15) putVarint(out, value - 15);
+    }
+
+    static bool getLength(const uint8_t*& p, const uint8_t* end, size_t& value) {
+        if (value < 15) return true;
+        uint64_t extra;
+        if (!getVarint(p, end, extra)) return false;
+        value += (size_t)extra;
+        return true;
+    }
+
+    void emit(vector<uint8_t>& out, const char* literals, size_t literalCount,
+              size_t offset, size_t length) const {
+        size_t extra = length > 0 ? length - LZ_MIN_MATCH : 0;
+        out.push_back((uint8_t)((min(literalCount, (size_t)15) << 4) | min(extra, (size_t)15)));
+        putLength(out, literalCount);
+        out.insert(out.end(), (const uint8_t*)literals, (const uint8_t*)literals + literalCount);
+        if (length > 0) {
+            putVarint(out, offset);
+            putLength(out, extra);
+        }
+    }
+
+public:
+    LzDictCodec() : head((size_t)1 << LZ_HASH_BITS, -1) {}
+
+    const char* name() const { return "lz-dict"; }
+    size_t dictBytes() const { return dict.size(); }
+
+    void train(const char* const* samples, size_t count) {
+        unordered_map<string_view, uint64_t> seen;
+        vector<string_view> order;
+        for (size_t i = 0; i < count; i++) {
+            string_view v(samples[i]);
+            if (v.size() < (size_t)LZ_MIN_MATCH) continue;
+            uint64_t& c = seen[v];
+            if (c++ == 0) order.push_back(v);
+        }
+
+        // Nilai berulang: urut penghematan (kemunculan tambahan x panjang)
+        vector<string_view> repeated, unique;
+        for (size_t i = 0; i < order.size(); i++) {
+            (seen[order[i]] > 1 ? repeated : unique).push_back(order[i]);
+        }
+        stable_sort(repeated.begin(), repeated.end(), [&](string_view a, string_view b) {
+            return (seen[a] - 1) * a.size() > (seen[b] - 1) * b.size();
+        });
+
+        // Isi kamus: nilai unik (sedikit) lalu nilai berulang, terbaik di ujung
+        vector<string_view> chosen;
+        size_t total = 0;
+        for (size_t i = 0; i < repeated.size(); i++) {
+            if (total + repeated[i].size() > LZ_DICT_MAX) continue;
+            chosen.push_back(repeated[i]);
+            total += repeated[i].size();
+        }
+        reverse(chosen.begin(), chosen.end());
+        size_t uniqueBytes = 0;
+        size_t uniqueCount = 0;
+        while (uniqueCount < unique.size() &&
+               uniqueBytes + unique[uniqueCount].size() <= LZ_DICT_UNIQUE_MAX &&
+               total + unique[uniqueCount].size() <= LZ_DICT_MAX) {
+            uniqueBytes += unique[uniqueCount].size();
+            total += unique[uniqueCount].size();
+            uniqueCount++;
+        }
+        chosen.insert(chosen.begin(), unique.begin(), unique.begin() + uniqueCount);
+
+        dict.clear();
+        dict.reserve(total);
+        for (size_t i = 0; i < chosen.size(); i++) {
+            dict.insert(dict.end(), chosen[i].begin(), chosen[i].end());
+        }
+
+        fill(head.begin(), head.end(), -1);
+        chain.assign(dict.size(), -1);
+        for (size_t pos = 0; pos + LZ_MIN_MATCH <= dict.size(); pos++) {
+            uint32_t h = hash4(&dict[pos]);
+            chain[pos] = head[h];
+            head[h] = (int32_t)pos;
+        }
+    }
+
+    size_t compress(const char* text, size_t n, vector<uint8_t>& out) const {
+        size_t start = out.size();
+        putVarint(out, n);
+
+        size_t literalStart = 0, i = 0;
+        while (i + LZ_MIN_MATCH <= n) {
+            size_t bestLength = 0, bestOffset = 0;
+            size_t limit = n - i;
+
+            // Kamus (match berhenti di ujung kamus)
+            for (int32_t c = head[hash4(text + i)], steps = 0; c >= 0 && steps < LZ_MAX_CHAIN;
+                 c = chain[c], steps++) {
+                size_t len = matchLength(&dict[c], text + i, min(limit, dict.size() - c));
+                if (len > bestLength) {
+                    bestLength = len;
+                    bestOffset = dict.size() - c + i;
+                }
+            }
+            // Teks sendiri (boleh tumpang tindih)
+            size_t from = i > (size_t)LZ_LOCAL_WINDOW ? i - LZ_LOCAL_WINDOW : 0;
+            for (size_t j = from; j < i; j++) {
+                size_t len = matchLength(text + j, text + i, limit);
+                if (len > bestLength) {
+                    bestLength = len;
+                    bestOffset = i - j;
+                }
+            }
+
+            // Match harus lebih hemat dari literal: token + offset + minimal 1 byte
+            size_t offsetBytes = 1;
+            for (size_t o = bestOffset; o >= 0x80; o >>= 7) offsetBytes++;
+            if (bestLength < (size_t)LZ_MIN_MATCH || bestLength < offsetBytes + 2) {
+                i++;
+                continue;
+            }
+            emit(out, text + literalStart, i - literalStart, bestOffset, bestLength);
+            i += bestLength;
+            literalStart = i;
+        }
+        if (literalStart < n) {
+            emit(out, text + literalStart, n - literalStart, 0, 0);
+        }
+        return out.size() - start;
+    }
+
+    bool decompress(const uint8_t* data, size_t size, char* out, size_t outSize) const {
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        uint64_t total;
+        if (!getVarint(p, end, total) || total >= outSize) return false;
+        size_t n = (size_t)total, produced = 0;
+
+        while (produced < n) {
+            if (p >= end) return false;
+            uint8_t token = *p++;
+            size_t literals = token >> 4, length = token & 15;
+            if (!getLength(p, end, literals) || literals > n - produced ||
+                literals > (size_t)(end - p)) {
+                return false;
+            }
+            memcpy(out + produced, p, literals);
+            p += literals;
+            produced += literals;
+            if (produced == n) break;
+
+            uint64_t offset;
+            if (!getVarint(p, end, offset) || !getLength(p, end, length)) return false;
+            length += LZ_MIN_MATCH;
+            if (offset == 0 || offset > dict.size() + produced || length > n - produced) return false;
+
+            // Posisi virtual: [kamus][teks]; bagian dari kamus disalin dulu
+            size_t src = dict.size() + produced - (size_t)offset;
+            while (length > 0 && src < dict.size()) {
+                out[produced++] = dict[src++];
+                length--;
+            }
+            for (src -= dict.size(); length > 0; length--) {
+                out[produced++] = out[src++];
+            }
+        }
+        out[n] = '\0';
+        return p == end;
+    }
+};
+
+// =================================================================
+// RANS - Range Asymmetric Numeral System (order-0)
+// =================================================================
+/*
+ * Seperti Huffman (1 model frekuensi bersama per kolom), tetapi simbol
+ * memakai pecahan bit: frekuensi dikuantisasi ke total 4096 (12 bit),
+ * simbol dengan peluang 90% memakai ~0.15 bit, bukan minimal 1 bit.
+ *
+ * STATE 24-bit, renormalisasi per byte:
+ * - Encode dari simbol terakhir ke pertama, byte ditulis mundur
+ * - Stream: [panjang: varint][state akhir: 3 byte][byte renormalisasi]
+ * - State akhir SELALU ditulis 3 byte, berapa pun panjang nilainya.
+ *   Karena setiap nilai di-encode sendiri, biaya tetap ini dibayar per
+ *   nilai dan menghapus keuntungan pecahan bit: pada kolom transaksi
+ *   (nilai 5-30 byte) rans lebih besar dari huffman di semua kolom
+ *   (lihat ./benchmark codec). rANS baru kompetitif jika 1 state
+ *   dipakai bersama untuk 1 blok / 1 kolom (akses acak per baris hilang).
+ * - Decode maju: slot = state & 4095 -> simbol (tabel 4096 entry)
+ * - State setelah simbol terakhir harus kembali ke nilai awal
+ *   (pemeriksaan integritas gratis)
+ * Semua byte 1..255 punya frekuensi minimal 1 -> teks apa pun bisa
+ * di-encode tanpa melatih ulang.
+ */
+const int RANS_SCALE_BITS = 12;
+const uint32_t RANS_SCALE = 1u << RANS_SCALE_BITS;
+const uint32_t RANS_LOWER = 1u << 16;          // State di [2^16, 2^24) -> flush 3 byte
+
+class RansCodec : public Codec {
+private:
+    uint32_t freq[256];
+    uint32_t cumulative[256];
+    uint8_t slotSymbol[RANS_SCALE];
+
+public:
+    RansCodec() {
+        uint64_t uniform[256] = {0};
+        trainFrequencies(uniform);
+    }
+
+    const char* name() const { return "rans"; }
+
+    // Kuantisasi frekuensi (+1 untuk byte 1..255) ke total 4096
+    void trainFrequencies(const uint64_t* frequencies) {
+        uint64_t total = 0;
+        uint64_t smoothed[256];
+        for (int s = 0; s < 256; s++) {
+            smoothed[s] = s == 0 ? 0 : frequencies[s] + 1;
+            total += smoothed[s];
+        }
+
+        int64_t sum = 0;
+        for (int s = 0; s < 256; s++) {
+            freq[s] = 0;
+            if (smoothed[s] == 0) continue;
+            uint64_t q = smoothed[s] * RANS_SCALE / total;
+            freq[s] = q == 0 ? 1 : (uint32_t)q;
+            sum += freq[s];
+        }
+
+        // Sisa pembulatan: tambah/kurangi dari simbol terbesar
+        while (sum != (int64_t)RANS_SCALE) {
+            int largest = 1;
+            for (int s = 1; s < 256; s++) {
+                if (freq[s] > freq[largest]) largest = s;
+            }
+            int64_t delta = (int64_t)RANS_SCALE - sum;
+            if (delta < 0 && (int64_t)freq[largest] + delta < 1) delta = 1 - (int64_t)freq[largest];
+            freq[largest] = (uint32_t)((int64_t)freq[largest] + delta);
+            sum += delta;
+        }
+
+        uint32_t c = 0;
+        for (int s = 0; s < 256; s++) {
+            cumulative[s] = c;
+            for (uint32_t k = 0; k < freq[s]; k++) slotSymbol[c + k] = (uint8_t)s;
+            c += freq[s];
+        }
+    }
+
+    void train(const char* const* samples, size_t count) {
+        uint64_t frequencies[256];
+        countSampleBytes(samples, count, frequencies);
+        trainFrequencies(frequencies);
+    }
+
+    size_t compress(const char* text, size_t n, vector<uint8_t>& out) const {
+        for (size_t i = 0; i < n; i++) {
+            if (freq[(unsigned char)text[i]] == 0) return 0;
+        }
+        size_t start = out.size();
+        putVarint(out, n);
+
+        // Maks. 12 bit per simbol (frekuensi >= 1/4096) + 3 byte state
+        size_t body = out.size();
+        size_t bound = n * 2 + 3;
+        out.resize(body + bound);
+        uint8_t* last = out.data() + body + bound;
+        uint8_t* ptr = last;
+
+        uint32_t x = RANS_LOWER;
+        for (size_t i = n; i-- > 0;) {
+            unsigned char s = (unsigned char)text[i];
+            uint32_t f = freq[s];
+            uint32_t xMax = ((RANS_LOWER >> RANS_SCALE_BITS) << 8) * f;
+            while (x >= xMax) {
+                *--ptr = (uint8_t)(x & 0xFF);
+                x >>= 8;
+            }
+            x = ((x / f) << RANS_SCALE_BITS) + (x % f) + cumulative[s];
+        }
+        ptr -= 3;
+        for (int b = 0; b < 3; b++) ptr[b] = (uint8_t)(x >> (8 * b));
+
+        size_t len = last - ptr;
+        memmove(out.data() + body, ptr, len);
+        out.resize(body + len);
+        return out.size() - start;
+    }
+
+    bool decompress(const uint8_t* data, size_t size, char* out, size_t outSize) const {
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        uint64_t n;
+        if (!getVarint(p, end, n) || n >= outSize || end - p < 3) return false;
+
+        uint32_t x = (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16;
+        p += 3;
+        for (size_t i = 0; i < n; i++) {
+            uint32_t slot = x & (RANS_SCALE - 1);
+            uint8_t s = slotSymbol[slot];
+            out[i] = (char)s;
+            x = freq[s] * (x >> RANS_SCALE_BITS) + slot - cumulative[s];
+            while (x < RANS_LOWER) {
+                if (p >= end) return false;
+                x = (x << 8) | *p++;
+            }
+        }
+        out[n] = '\0';
+        return x == RANS_LOWER && p == end;
+    }
+};
+
+#endif
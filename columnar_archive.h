@@ -0,0 +1,593 @@
+#ifndef COLUMNAR_ARCHIVE_H
+#define COLUMNAR_ARCHIVE_H
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include "data_structures.h"
+#include "parallel_loader.h"
+#include "tokenizer.h"
+#include "time_util.h"
+#include "block_compressor.h"
+
+using namespace std;
+
+// =================================================================
+// COLUMNAR ARCHIVE - Arsip Transaksi Tertutup per Kolom
+// =================================================================
+/*
+ * Setiap Transaksi di memori memakai char array tetap (20+20+20+50+50+200
+ * byte), padahal "jenis" hanya punya 3 nilai dan "keterangan" biasanya
+ * salah satu dari beberapa kalimat standar. Untuk riwayat yang sudah
+ * tertutup (tidak berubah lagi), data disimpan PER KOLOM:
+ *
+ * - id          : angka setelah "TRX", bit-packed relatif ke ID minimum
+ *                 (kolom string jika ada ID dengan format lain)
+ * - waktu       : int64 epoch detik
+ * - jumlah      : dalam sen, bit-packed relatif ke jumlah minimum
+ * - jenis/dari/ke : dictionary string + ID integer bit-packed
+ * - keterangan  : dictionary untuk kalimat yang sering muncul +
+ *                 overflow heap untuk kalimat yang hanya muncul sekali
+ *
+ * KEUNTUNGAN:
+ * - Ukuran file jauh lebih kecil dari log teks
+ * - Analitik hanya membaca kolom yang dibutuhkan (file di-mmap, jadi
+ *   kolom lain tidak pernah disentuh / tidak dibaca dari disk)
+ */
+const uint32_t COLUMNAR_VERSION = 2;
+const uint32_t BLOOM_BITS_PER_ROW = 10;
+const uint32_t BLOOM_HASHES = 7;
+
+enum ColumnId {
+    COL_ID, COL_WAKTU, COL_JUMLAH, COL_JENIS, COL_DARI, COL_KE, COL_KETERANGAN,
+    COL_COUNT
+};
+
+struct ColumnInfo {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct ColumnarHeader {
+    char magic[8];          // "EWCOLAR\0"
+    uint32_t version;
+    uint32_t idBits;        // 0 = ID disimpan sebagai kolom string
+    uint64_t rowCount;
+    uint64_t sourceSize;    // Ukuran file sumber (untuk deteksi arsip basi)
+    int64_t idBase;
+    int64_t amountBase;     // Jumlah minimum dalam sen
+    uint32_t amountBits;
+    uint32_t reserved;
+    ColumnInfo columns[COL_COUNT];
+};
+
+/*
+ * FOOTER ZONE MAP (di akhir file)
+ * Ringkasan kecil setiap arsip/segmen: rentang waktu, rentang jumlah,
+ * jumlah baris dan bloom filter ID transaksi. Query rentang dan
+ * pencarian ID cukup membaca footer untuk memutuskan apakah segmen
+ * perlu dibaca atau bisa dilewati seluruhnya.
+ */
+struct SegmentFooter {
+    char magic[8];          // "EWZONE\0\0"
+    uint64_t baseLsn;       // Rentang LSN WAL yang ditutup segmen ini
+    uint64_t endLsn;
+    int64_t minTime;
+    int64_t maxTime;
+    double minAmount;
+    double maxAmount;
+    uint64_t rowCount;
+    uint64_t bloomOffset;
+    uint64_t bloomBits;     // Kelipatan 64
+    uint32_t bloomHashes;
+    uint32_t reserved;
+};
+
+// Hash 64-bit FNV-1a untuk bloom filter ID
+inline uint64_t bloomHash(string_view s) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < s.size(); i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Posisi bit ke-k (double hashing: h1 + k*h2)
+inline uint64_t bloomBit(uint64_t hash, uint32_t k, uint64_t bits) {
+    uint64_t h1 = hash & 0xFFFFFFFFu;
+    uint64_t h2 = (hash >> 32) | 1;
+    return (h1 + k * h2) % bits;
+}
+
+// Header blok kolom string (dictionary + overflow heap)
+struct StringColumnHeader {
+    uint32_t dictCount;     // Entry 0..dictCount-1 : dictionary
+    uint32_t overflowCount; // Entry berikutnya     : overflow heap (1 per baris)
+    uint32_t bits;          // Lebar kode per baris
+    uint32_t reserved;
+    uint64_t heapSize;
+};
+
+// ---- Bit packing ----
+inline uint32_t bitsFor(uint64_t maxValue) {
+    uint32_t bits = 1;
+    while (bits < 64 && (maxValue >> bits) != 0) bits++;
+    return bits;
+}
+
+inline uint64_t unpackBits(const uint64_t* words, uint64_t index, uint32_t bits) {
+    uint64_t bitPos = index * bits;
+    uint64_t w = bitPos >> 6;
+    uint32_t shift = (uint32_t)(bitPos & 63);
+    uint64_t v = words[w] >> shift;
+    if (shift + bits > 64) {
+        v |= words[w + 1] << (64 - shift);
+    }
+    return bits == 64 ? v : (v & ((1ULL << bits) - 1));
+}
+
+class BitPacker {
+private:
+    vector<uint64_t> words;
+    uint64_t bitPos;
+    uint32_t bits;
+
+public:
+    explicit BitPacker(uint32_t width) : bitPos(0), bits(width) {}
+
+    void add(uint64_t v) {
+        uint64_t w = bitPos >> 6;
+        uint32_t shift = (uint32_t)(bitPos & 63);
+        if (words.size() < w + 2) words.resize(w + 2, 0);
+        words[w] |= v << shift;
+        if (shift + bits > 64) {
+            words[w + 1] |= v >> (64 - shift);
+        }
+        bitPos += bits;
+    }
+
+    const vector<uint64_t>& data() const { return words; }
+};
+
+// ---- Penulis arsip ----
+class ColumnarWriter {
+private:
+    vector<char> out;
+
+    void align8() {
+        while (out.size() % 8 != 0) out.push_back('\0');
+    }
+
+    void putRaw(const void* data, size_t len) {
+        out.insert(out.end(), (const char*)data, (const char*)data + len);
+    }
+
+    void putWords(const vector<uint64_t>& words) {
+        putRaw(words.data(), words.size() * sizeof(uint64_t));
+    }
+
+    // Tulis 1 kolom string: kalimat yang muncul >= 2x masuk dictionary
+    void putStringColumn(const vector<string_view>& values) {
+        unordered_map<string_view, uint32_t> freq;
+        for (size_t i = 0; i < values.size(); i++) freq[values[i]]++;
+
+        vector<string_view> dict;
+        for (auto it = freq.begin(); it != freq.end(); ++it) {
+            if (it->second >= 2) dict.push_back(it->first);
+        }
+        sort(dict.begin(), dict.end(), [&](string_view a, string_view b) {
+            return freq[a] != freq[b] ? freq[a] > freq[b] : a < b;
+        });
+
+        unordered_map<string_view, uint32_t> code;
+        for (size_t i = 0; i < dict.size(); i++) code[dict[i]] = (uint32_t)i;
+
+        vector<string_view> entries(dict);
+        vector<uint32_t> rowCodes(values.size());
+        for (size_t i = 0; i < values.size(); i++) {
+            auto it = code.find(values[i]);
+            if (it != code.end()) {
+                rowCodes[i] = it->second;
+            } else {
+                rowCodes[i] = (uint32_t)entries.size();
+                entries.push_back(values[i]);
+            }
+        }
+
+        StringColumnHeader h;
+        memset(&h, 0, sizeof(h));
+        h.dictCount = (uint32_t)dict.size();
+        h.overflowCount = (uint32_t)(entries.size() - dict.size());
+        h.bits = bitsFor(entries.empty() ? 0 : entries.size() - 1);
+
+        vector<uint32_t> offsets(entries.size() + 1);
+        uint64_t heapSize = 0;
+        for (size_t i = 0; i < entries.size(); i++) {
+            offsets[i] = (uint32_t)heapSize;
+            heapSize += entries[i].size();
+        }
+        offsets[entries.size()] = (uint32_t)heapSize;
+        h.heapSize = heapSize;
+
+        putRaw(&h, sizeof(h));
+        putRaw(offsets.data(), offsets.size() * sizeof(uint32_t));
+        for (size_t i = 0; i < entries.size(); i++) {
+            putRaw(entries[i].data(), entries[i].size());
+        }
+        align8();
+
+        BitPacker packer(h.bits);
+        for (size_t i = 0; i < rowCodes.size(); i++) packer.add(rowCodes[i]);
+        putWords(packer.data());
+    }
+
+    static bool numericId(const char* id, int64_t& value) {
+        if (strncmp(id, "TRX", 3) != 0 || id[3] == '\0' || strlen(id + 3) > 18) return false;
+        if (id[3] == '0' && id[4] != '\0') return false;   // Nol di depan tidak bisa dipulihkan
+        value = 0;
+        for (const char* p = id + 3; *p; p++) {
+            if (*p < '0' || *p > '9') return false;
+            value = value * 10 + (*p - '0');
+        }
+        return true;
+    }
+
+public:
+    /*
+     * Bangun arsip dari daftar transaksi (urutan baris dipertahankan)
+     * lalu tulis ke path (via file .tmp + rename).
+     */
+    bool write(const char* path, const Transaksi* const* rows, size_t rowCount, uint64_t sourceSize,
+               uint64_t baseLsn = 0, uint64_t endLsn = 0) {
+        out.clear();
+
+        ColumnarHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, "EWCOLAR", 7);
+        h.version = COLUMNAR_VERSION;
+        h.rowCount = rowCount;
+        h.sourceSize = sourceSize;
+        putRaw(&h, sizeof(h));
+
+        // Kolom ID: numerik jika semua berformat TRX<angka>
+        vector<int64_t> ids(rowCount);
+        bool allNumeric = true;
+        int64_t idMin = 0, idMax = 0;
+        for (size_t i = 0; i < rowCount && allNumeric; i++) {
+            allNumeric = numericId(rows[i]->id, ids[i]);
+            if (i == 0 || ids[i] < idMin) idMin = ids[i];
+            if (i == 0 || ids[i] > idMax) idMax = ids[i];
+        }
+
+        align8();
+        h.columns[COL_ID].offset = out.size();
+        if (allNumeric) {
+            h.idBase = idMin;
+            h.idBits = bitsFor((uint64_t)(idMax - idMin));
+            BitPacker packer(h.idBits);
+            for (size_t i = 0; i < rowCount; i++) packer.add((uint64_t)(ids[i] - idMin));
+            putWords(packer.data());
+        } else {
+            vector<string_view> values(rowCount);
+            for (size_t i = 0; i < rowCount; i++) values[i] = rows[i]->id;
+            putStringColumn(values);
+        }
+        h.columns[COL_ID].size = out.size() - h.columns[COL_ID].offset;
+
+        // Kolom waktu: int64 epoch
+        align8();
+        h.columns[COL_WAKTU].offset = out.size();
+        for (size_t i = 0; i < rowCount; i++) {
+            putRaw(&rows[i]->waktu, sizeof(rows[i]->waktu));
+        }
+        h.columns[COL_WAKTU].size = out.size() - h.columns[COL_WAKTU].offset;
+
+        // Kolom jumlah: sen, bit-packed relatif ke minimum
+        vector<int64_t> cents(rowCount);
+        int64_t centMin = 0, centMax = 0;
+        for (size_t i = 0; i < rowCount; i++) {
+            cents[i] = llround(rows[i]->jumlah * 100.0);
+            if (i == 0 || cents[i] < centMin) centMin = cents[i];
+            if (i == 0 || cents[i] > centMax) centMax = cents[i];
+        }
+        h.amountBase = centMin;
+        h.amountBits = bitsFor((uint64_t)(centMax - centMin));
+
+        align8();
+        h.columns[COL_JUMLAH].offset = out.size();
+        BitPacker amountPacker(h.amountBits);
+        for (size_t i = 0; i < rowCount; i++) amountPacker.add((uint64_t)(cents[i] - centMin));
+        putWords(amountPacker.data());
+        h.columns[COL_JUMLAH].size = out.size() - h.columns[COL_JUMLAH].offset;
+
+        // Kolom string: jenis, dari, ke, keterangan
+        const int stringCols[] = {COL_JENIS, COL_DARI, COL_KE, COL_KETERANGAN};
+        for (int c = 0; c < 4; c++) {
+            int col = stringCols[c];
+            vector<string_view> values(rowCount);
+            for (size_t i = 0; i < rowCount; i++) {
+                const Transaksi* t = rows[i];
+                values[i] = col == COL_JENIS ? t->jenis : col == COL_DARI ? t->dari :
+                            col == COL_KE ? t->ke : t->keterangan;
+            }
+            align8();
+            h.columns[col].offset = out.size();
+            putStringColumn(values);
+            h.columns[col].size = out.size() - h.columns[col].offset;
+        }
+
+        memcpy(out.data(), &h, sizeof(h));
+
+        // Footer: zone map + bloom filter ID
+        SegmentFooter footer;
+        memset(&footer, 0, sizeof(footer));
+        memcpy(footer.magic, "EWZONE", 6);
+        footer.baseLsn = baseLsn;
+        footer.endLsn = endLsn;
+        footer.rowCount = rowCount;
+        footer.minAmount = (double)centMin / 100.0;
+        footer.maxAmount = (double)centMax / 100.0;
+        for (size_t i = 0; i < rowCount; i++) {
+            int64_t epoch = ((const int64_t*)(out.data() + h.columns[COL_WAKTU].offset))[i];
+            if (i == 0 || epoch < footer.minTime) footer.minTime = epoch;
+            if (i == 0 || epoch > footer.maxTime) footer.maxTime = epoch;
+        }
+
+        footer.bloomHashes = BLOOM_HASHES;
+        footer.bloomBits = ((rowCount * BLOOM_BITS_PER_ROW + 63) / 64) * 64;
+        if (footer.bloomBits < 64) footer.bloomBits = 64;
+        vector<uint64_t> bloom(footer.bloomBits / 64, 0);
+        for (size_t i = 0; i < rowCount; i++) {
+            uint64_t hash = bloomHash(rows[i]->id);
+            for (uint32_t k = 0; k < footer.bloomHashes; k++) {
+                uint64_t bit = bloomBit(hash, k, footer.bloomBits);
+                bloom[bit >> 6] |= 1ULL << (bit & 63);
+            }
+        }
+        align8();
+        footer.bloomOffset = out.size();
+        putWords(bloom);
+        putRaw(&footer, sizeof(footer));
+
+        char tmpPath[260];
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+        FILE* f = fopen(tmpPath, "wb");
+        if (f == NULL) return false;
+        bool ok = fwrite(out.data(), out.size(), 1, f) == 1;
+        ok = (fclose(f) == 0) && ok;
+        if (!ok) {
+            remove(tmpPath);
+            return false;
+        }
+        remove(path);
+        return rename(tmpPath, path) == 0;
+    }
+};
+
+// ---- Pembaca arsip (mmap, zero-copy) ----
+class ColumnarArchive {
+private:
+    MappedFile file;
+    vector<char> inflated;          // Isi arsip dari <path>.hz (arsip dingin)
+    const char* bytes;              // Isi arsip: mmap file atau inflated
+    uint64_t byteCount;
+    uint64_t diskBytes;
+    const ColumnarHeader* header;
+    const SegmentFooter* zone;
+
+    struct StringColumn {
+        const StringColumnHeader* h;
+        const uint32_t* offsets;
+        const char* heap;
+        const uint64_t* codes;
+    };
+    StringColumn strings[COL_COUNT];
+
+    bool openStringColumn(int col) {
+        const ColumnInfo& info = header->columns[col];
+        if (info.offset + info.size > byteCount || info.size < sizeof(StringColumnHeader)) return false;
+
+        StringColumn& sc = strings[col];
+        const char* p = bytes + info.offset;
+        sc.h = (const StringColumnHeader*)p;
+        p += sizeof(StringColumnHeader);
+        sc.offsets = (const uint32_t*)p;
+        p += (sc.h->dictCount + sc.h->overflowCount + 1) * sizeof(uint32_t);
+        sc.heap = p;
+        p += sc.h->heapSize;
+        size_t pad = (size_t)(p - bytes) % 8;
+        if (pad) p += 8 - pad;
+        sc.codes = (const uint64_t*)p;
+        return p <= bytes + info.offset + info.size;
+    }
+
+    const uint64_t* words(int col) const {
+        return (const uint64_t*)(bytes + header->columns[col].offset);
+    }
+
+public:
+    ColumnarArchive() : bytes(NULL), byteCount(0), diskBytes(0), header(NULL), zone(NULL) {
+        memset(strings, 0, sizeof(strings));
+    }
+
+    /*
+     * Buka arsip (mmap). Jika <path> tidak ada tetapi <path>.hz ada
+     * (arsip dingin yang sudah dikompresi), isinya didekompresi ke memori.
+     */
+    bool open(const char* path) {
+        close();
+        if (file.open(path)) {
+            bytes = file.data();
+            byteCount = diskBytes = file.size();
+        } else {
+            char packedPath[260];
+            snprintf(packedPath, sizeof(packedPath), "%s%s", path, BLOCK_FILE_SUFFIX);
+            BlockFileReader reader;
+            if (!reader.open(packedPath)) return false;
+            if (!reader.readAll(inflated)) {
+                cout << "Error: Blok rusak di " << packedPath << "\n";
+                close();
+                return false;
+            }
+            bytes = inflated.data();
+            byteCount = inflated.size();
+            diskBytes = reader.fileSize();
+        }
+        if (byteCount < sizeof(ColumnarHeader)) {
+            close();
+            return false;
+        }
+
+        header = (const ColumnarHeader*)bytes;
+        if (header->version != COLUMNAR_VERSION) {
+            // Arsip versi lama: dibangun ulang oleh pemanggil
+            close();
+            return false;
+        }
+        bool ok = memcmp(header->magic, "EWCOLAR", 7) == 0 &&
+                  byteCount >= sizeof(ColumnarHeader) + sizeof(SegmentFooter);
+        if (ok) {
+            zone = (const SegmentFooter*)(bytes + byteCount - sizeof(SegmentFooter));
+            ok = memcmp(zone->magic, "EWZONE", 6) == 0 && zone->bloomBits >= 64 &&
+                 zone->bloomOffset + zone->bloomBits / 8 <= byteCount;
+        }
+        for (int col = 0; ok && col < COL_COUNT; col++) {
+            ok = header->columns[col].offset + header->columns[col].size <= byteCount;
+        }
+        if (ok && header->idBits == 0) ok = openStringColumn(COL_ID);
+        for (int col = COL_JENIS; ok && col < COL_COUNT; col++) {
+            ok = openStringColumn(col);
+        }
+
+        if (!ok) {
+            cout << "Error: Format arsip kolom tidak dikenali: " << path << "\n";
+            close();
+        }
+        return ok;
+    }
+
+    void close() {
+        file.close();
+        vector<char>().swap(inflated);
+        bytes = NULL;
+        byteCount = diskBytes = 0;
+        header = NULL;
+        zone = NULL;
+        memset(strings, 0, sizeof(strings));
+    }
+
+    bool isOpen() const { return header != NULL; }
+    uint64_t rowCount() const { return header ? header->rowCount : 0; }
+    uint64_t sourceSize() const { return header ? header->sourceSize : 0; }
+    uint64_t fileSize() const { return diskBytes; }
+    bool isCompressed() const { return !inflated.empty(); }
+    // Isi arsip mentah (setelah dekompresi jika dari .hz)
+    const char* data() const { return bytes; }
+    uint64_t byteSize() const { return byteCount; }
+    uint64_t columnSize(int col) const { return header->columns[col].size; }
+
+    const SegmentFooter& footer() const { return *zone; }
+
+    // ---- Zone map ----
+    bool overlapsTime(int64_t from, int64_t to) const {
+        return zone->rowCount > 0 && zone->maxTime >= from && zone->minTime <= to;
+    }
+
+    bool overlapsAmount(double minVal, double maxVal) const {
+        return zone->rowCount > 0 && zone->maxAmount >= minVal && zone->minAmount <= maxVal;
+    }
+
+    // false = ID pasti tidak ada di arsip ini
+    bool mayContainId(string_view id) const {
+        const uint64_t* bloom = (const uint64_t*)(bytes + zone->bloomOffset);
+        uint64_t hash = bloomHash(id);
+        for (uint32_t k = 0; k < zone->bloomHashes; k++) {
+            uint64_t bit = bloomBit(hash, k, zone->bloomBits);
+            if ((bloom[bit >> 6] & (1ULL << (bit & 63))) == 0) return false;
+        }
+        return true;
+    }
+
+    // Cari baris dengan ID tertentu (scan kolom ID saja)
+    bool findId(string_view id, uint64_t& rowOut) const {
+        if (header->idBits > 0) {
+            if (id.size() < 4 || id.size() > 21 || id.substr(0, 3) != "TRX") return false;
+            if (id[3] == '0' && id.size() > 4) return false;
+            int64_t value = 0;
+            for (size_t i = 3; i < id.size(); i++) {
+                if (id[i] < '0' || id[i] > '9') return false;
+                value = value * 10 + (id[i] - '0');
+            }
+            if (value < header->idBase) return false;
+            uint64_t target = (uint64_t)(value - header->idBase);
+            for (uint64_t i = 0; i < header->rowCount; i++) {
+                if (unpackBits(words(COL_ID), i, header->idBits) == target) {
+                    rowOut = i;
+                    return true;
+                }
+            }
+            return false;
+        }
+        for (uint64_t i = 0; i < header->rowCount; i++) {
+            if (text(COL_ID, i) == id) {
+                rowOut = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ---- Akses per kolom ----
+    double jumlah(uint64_t row) const {
+        uint64_t delta = unpackBits(words(COL_JUMLAH), row, header->amountBits);
+        return (double)(header->amountBase + (int64_t)delta) / 100.0;
+    }
+
+    int64_t waktu(uint64_t row) const {
+        return ((const int64_t*)words(COL_WAKTU))[row];
+    }
+
+    // Kode dictionary baris (hanya untuk kolom string)
+    uint32_t code(int col, uint64_t row) const {
+        return (uint32_t)unpackBits(strings[col].codes, row, strings[col].h->bits);
+    }
+
+    uint32_t dictCount(int col) const {
+        return strings[col].h->dictCount;
+    }
+
+    string_view entry(int col, uint32_t code) const {
+        const StringColumn& sc = strings[col];
+        return string_view(sc.heap + sc.offsets[code], sc.offsets[code + 1] - sc.offsets[code]);
+    }
+
+    string_view text(int col, uint64_t row) const {
+        return entry(col, code(col, row));
+    }
+
+    // Rekonstruksi 1 baris utuh
+    void row(uint64_t i, Transaksi& t) const {
+        if (header->idBits > 0) {
+            int64_t id = header->idBase + (int64_t)unpackBits(words(COL_ID), i, header->idBits);
+            snprintf(t.id, sizeof(t.id), "TRX%lld", (long long)id);
+        } else {
+            copyField(t.id, sizeof(t.id), text(COL_ID, i));
+        }
+        t.waktu = waktu(i);
+        t.jumlah = jumlah(i);
+        copyField(t.jenis, sizeof(t.jenis), text(COL_JENIS, i));
+        copyField(t.dari, sizeof(t.dari), text(COL_DARI, i));
+        copyField(t.ke, sizeof(t.ke), text(COL_KE, i));
+        copyField(t.keterangan, sizeof(t.keterangan), text(COL_KETERANGAN, i));
+    }
+};
+
+#endif
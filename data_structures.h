@@ -5,24 +5,171 @@
 #include <cstring>
 #include <ctime>
 #include <iomanip>
+#include <cstdio>
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "node_pool.h"
+#include "time_util.h"
+#include "transaction_clock.h"
+#include "canonical_huffman.h"
+#include "huffman_model.h"
+#include "codec.h"
 
 using namespace std;
 
+// =================================================================
+// KETERANGAN ARENA - Keterangan Transaksi Terkompresi (Huffman)
+// =================================================================
+/*
+ * SEBELUMNYA: setiap record transaksi di memori menyimpan keterangan
+ * di char[200], padahal isinya rata-rata 20-30 karakter.
+ *
+ * KONSEP:
+ * - Keterangan record yang tersimpan (TransactionStore) di-encode
+ *   dengan model Huffman bersama (huffman_model.h) lalu ditempel ke
+ *   arena: blok 1 MB append-only, tanpa alokasi per record
+ * - Record hanya menyimpan posisi 32-bit (blok << 20 | offset)
+ * - Stream membawa versi modelnya -> tetap terbaca setelah model
+ *   dilatih ulang
+ * - Decode hanya saat keterangan benar-benar dibaca (tampil/ekspor)
+ */
+const int KETERANGAN_BLOCK_BITS = 20;
+const uint32_t KETERANGAN_BLOCK_SIZE = 1u << KETERANGAN_BLOCK_BITS;
+const size_t KETERANGAN_MAX_LENGTH = 200;   // Termasuk '\0', sama dengan Transaksi::keterangan
+
+// Hasil encode 1 keterangan yang benar-benar disimpan di arena
+struct KeteranganEncoding {
+    uint32_t bytes;         // Ukuran stream [versi][panjang][bit]
+    uint32_t version;       // Versi model Huffman yang dipakai
+
+    KeteranganEncoding() : bytes(0), version(0) {}
+};
+
+class KeteranganArena {
+private:
+    vector<uint8_t*> blocks;
+    uint32_t used;                  // Byte terpakai di blok terakhir
+    size_t textBytes;               // Total keterangan asli (statistik)
+    vector<uint8_t> scratch;
+    KeteranganEncoding last;        // Encode terakhir (untuk struk transaksi)
+
+    KeteranganArena(const KeteranganArena&);
+    KeteranganArena& operator=(const KeteranganArena&);
+
+public:
+    KeteranganArena() : used(KETERANGAN_BLOCK_SIZE), textBytes(0) {}
+
+    ~KeteranganArena() {
+        for (size_t b = 0; b < blocks.size(); b++) {
+            free(blocks[b]);
+        }
+    }
+
+    // Encode & simpan keterangan, return posisinya (tidak thread-safe, sama seperti store)
+    uint32_t add(const char* text) {
+        scratch.clear();
+        keteranganModels().encode(text, scratch);
+        textBytes += strlen(text);
+
+        if (used + scratch.size() > KETERANGAN_BLOCK_SIZE) {
+            uint8_t* block = (uint8_t*)malloc(KETERANGAN_BLOCK_SIZE);
+            if (block == NULL) throw bad_alloc();
+            blocks.push_back(block);
+            used = 0;
+        }
+        uint32_t ref = (uint32_t)(blocks.size() - 1) << KETERANGAN_BLOCK_BITS | used;
+        memcpy(blocks.back() + used, scratch.data(), scratch.size());
+        used += (uint32_t)scratch.size();
+        
+        // Versi dibaca dari stream itu sendiri: tetap benar walau trainer
+        // menerbitkan model baru setelah encode
+        const uint8_t* p = scratch.data();
+        uint64_t version = 0;
+        getVarint(p, scratch.data() + scratch.size(), version);
+        last.bytes = (uint32_t)scratch.size();
+        last.version = (uint32_t)version;
+        return ref;
+    }
+    
+    // Ukuran & versi model dari add() terakhir
+    const KeteranganEncoding& lastEncoding() const { return last; }
+
+    // Decode keterangan di posisi ref ke out (teks + '\0'). Rusak -> "".
+    const char* text(uint32_t ref, char* out, size_t size) const {
+        uint32_t offset = ref & (KETERANGAN_BLOCK_SIZE - 1);
+        const uint8_t* block = blocks[ref >> KETERANGAN_BLOCK_BITS];
+        size_t available = (ref >> KETERANGAN_BLOCK_BITS) + 1 == blocks.size()
+                               ? used - offset : KETERANGAN_BLOCK_SIZE - offset;
+        if (!keteranganModels().decode(block + offset, available, out, size)) out[0] = '\0';
+        return out;
+    }
+
+    size_t compressedBytes() const {
+        return blocks.empty() ? 0 : (blocks.size() - 1) * KETERANGAN_BLOCK_SIZE + used;
+    }
+    size_t reservedBytes() const { return blocks.size() * KETERANGAN_BLOCK_SIZE; }
+    size_t originalBytes() const { return textBytes; }
+};
+
+// Satu arena untuk semua record yang tersimpan (inisialisasi thread-safe)
+inline KeteranganArena& keteranganArena() {
+    static KeteranganArena arena;
+    return arena;
+}
+
 // =================================================================
 // STRUCT TRANSAKSI
 // =================================================================
-struct Transaksi {
+/*
+ * TransaksiBase   : semua field kecuali keterangan
+ * Transaksi       : + keterangan teks (transaksi baru, hasil parse file)
+ * TransaksiRecord : + posisi keterangan di arena (record di TransactionStore)
+ */
+struct TransaksiBase {
     char id[20];
-    char timestamp[20];     // Format: DD/MM/YYYY HH:MM:SS
+    int64_t waktu;          // Epoch detik (jam lokal), diformat hanya saat tampil
     char jenis[20];         // "Top Up", "Transfer", "Pembayaran"
     char dari[50];          // Username pengirim
     char ke[50];            // Username penerima / merchant
     double jumlah;
-    char keterangan[200];
+    
+    // Waktu dalam format "DD/MM/YYYY HH:MM:SS" (buffer minimal 20 byte)
+    const char* formatWaktu(char* out) const {
+        formatTimestamp(waktu, out);
+        return out;
+    }
+    
+    // '\n' (bukan endl): laporan besar tidak di-flush per baris
+    void displayRow(ostream& out, const char* keterangan) const {
+        out << "| " << setw(15) << left << jenis 
+            << " | Rp " << setw(10) << right << jumlah 
+            << " | " << setw(30) << left << keterangan << " |\n";
+    }
+    
+    void displayDetailWith(const char* keterangan) const {
+        char text[20];
+        cout << "\n      +----------------------------------------+\n";
+        cout << "      | ID Transaksi : " << setw(22) << left << id << "|\n";
+        cout << "      | Waktu        : " << setw(22) << left << formatWaktu(text) << "|\n";
+        cout << "      | Jenis        : " << setw(22) << left << jenis << "|\n";
+        cout << "      | Dari         : " << setw(22) << left << dari << "|\n";
+        cout << "      | Ke           : " << setw(22) << left << ke << "|\n";
+        cout << "      | Jumlah       : Rp " << setw(19) << right << jumlah << "|\n";
+        cout << "      | Keterangan   : " << setw(22) << left << keterangan << "|\n";
+        cout << "      +----------------------------------------+\n";
+    }
+};
+
+struct Transaksi : TransaksiBase {
+    char keterangan[KETERANGAN_MAX_LENGTH];
     
     Transaksi() {
         strcpy(id, "");
-        strcpy(timestamp, "");
+        waktu = 0;
         strcpy(jenis, "");
         strcpy(dari, "");
         strcpy(ke, "");
@@ -31,15 +178,9 @@ struct Transaksi {
     }
     
     Transaksi(const char* j, double jml, const char* ket, const char* dr = "", const char* k = "") {
-        static int counter = 1000;
-        sprintf(id, "TRX%d", counter++);
-        
-        // Generate timestamp
-        time_t now = time(0);
-        struct tm* t = localtime(&now);
-        sprintf(timestamp, "%02d/%02d/%04d %02d:%02d:%02d",
-                t->tm_mday, t->tm_mon + 1, t->tm_year + 1900,
-                t->tm_hour, t->tm_min, t->tm_sec);
+        TransactionClock& clock = transactionClock();
+        clock.nextId(id, sizeof(id));
+        waktu = clock.nowLocal();
         
         strcpy(jenis, j);
         jumlah = jml;
@@ -48,22 +189,41 @@ struct Transaksi {
         strcpy(ke, k);
     }
     
-    void display() const {
-        cout << "| " << setw(15) << left << jenis 
-             << " | Rp " << setw(10) << right << jumlah 
-             << " | " << setw(30) << left << keterangan << " |" << endl;
+    void display(ostream& out = cout) const {
+        displayRow(out, keterangan);
     }
     
     void displayDetail() const {
-        cout << "\n      +----------------------------------------+\n";
-        cout << "      | ID Transaksi : " << setw(22) << left << id << "|\n";
-        cout << "      | Waktu        : " << setw(22) << left << timestamp << "|\n";
-        cout << "      | Jenis        : " << setw(22) << left << jenis << "|\n";
-        cout << "      | Dari         : " << setw(22) << left << dari << "|\n";
-        cout << "      | Ke           : " << setw(22) << left << ke << "|\n";
-        cout << "      | Jumlah       : Rp " << setw(19) << right << jumlah << "|\n";
-        cout << "      | Keterangan   : " << setw(22) << left << keterangan << "|\n";
-        cout << "      +----------------------------------------+\n";
+        displayDetailWith(keterangan);
+    }
+};
+
+struct TransaksiRecord : TransaksiBase {
+    uint32_t keterangan;    // Posisi di keteranganArena()
+    
+    explicit TransaksiRecord(const Transaksi& t) : TransaksiBase(t) {
+        keterangan = keteranganArena().add(t.keterangan);
+    }
+    
+    // Keterangan di-decode ke out (minimal KETERANGAN_MAX_LENGTH byte)
+    const char* keteranganText(char* out) const {
+        return keteranganArena().text(keterangan, out, KETERANGAN_MAX_LENGTH);
+    }
+    
+    // Salinan lengkap (untuk ditulis ke file/checkpoint)
+    void toTransaksi(Transaksi& out) const {
+        (TransaksiBase&)out = *this;
+        keteranganText(out.keterangan);
+    }
+    
+    void display(ostream& out = cout) const {
+        char text[KETERANGAN_MAX_LENGTH];
+        displayRow(out, keteranganText(text));
+    }
+    
+    void displayDetail() const {
+        char text[KETERANGAN_MAX_LENGTH];
+        displayDetailWith(keteranganText(text));
     }
 };
 
@@ -108,19 +268,14 @@ class RefundStack {
 private:
     StackNode* top;
     int size;
+    NodePool<StackNode> pool;   // Node dibebaskan sekaligus saat Stack dihancurkan
     
 public:
     RefundStack() : top(NULL), size(0) {}
     
-    ~RefundStack() {
-        while (!isEmpty()) {
-            pop();
-        }
-    }
-    
     // Push - Tambah refund ke stack (LIFO)
     void push(const RefundRequest& req) {
-        StackNode* newNode = new StackNode(req);
+        StackNode* newNode = pool.create(req);
         newNode->next = top;
         top = newNode;
         size++;
@@ -136,7 +291,7 @@ public:
         StackNode* temp = top;
         RefundRequest data = temp->data;
         top = top->next;
-        delete temp;
+        pool.destroy(temp);
         size--;
         
         return data;
@@ -158,6 +313,14 @@ public:
         return size;
     }
     
+    // Kunjungi semua request dari atas (terbaru) ke bawah
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (StackNode* current = top; current != NULL; current = current->next) {
+            fn(current->data);
+        }
+    }
+    
     void displayAll() const {
         if (isEmpty()) {
             cout << "      Tidak ada refund request.\n";
@@ -219,23 +382,18 @@ private:
     QueueNode* front;
     QueueNode* rear;
     int size;
+    NodePool<QueueNode> pool;   // Node dibebaskan sekaligus saat Queue dihancurkan
     
 public:
     CSQueue() : front(NULL), rear(NULL), size(0) {}
     
-    ~CSQueue() {
-        while (!isEmpty()) {
-            dequeue();
-        }
-    }
-    
     bool isEmpty() const {
         return front == NULL;
     }
     
     // Enqueue - Tambah ticket ke belakang queue
     void enqueue(const CSTicket& ticket) {
-        QueueNode* newNode = new QueueNode(ticket);
+        QueueNode* newNode = pool.create(ticket);
         
         if (isEmpty()) {
             front = rear = newNode;
@@ -261,7 +419,7 @@ public:
             rear = NULL;
         }
         
-        delete temp;
+        pool.destroy(temp);
         size--;
         
         return data;
@@ -279,6 +437,14 @@ public:
         return size;
     }
     
+    // Kunjungi semua tiket dari depan (masuk pertama) ke belakang
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (QueueNode* current = front; current != NULL; current = current->next) {
+            fn(current->data);
+        }
+    }
+    
     void displayAll() const {
         if (isEmpty()) {
             cout << "      Tidak ada tiket CS.\n";
@@ -317,6 +483,15 @@ public:
  * - Karakter dengan frekuensi tinggi dapat kode lebih pendek
  * - Menghemat storage untuk data teks repetitif
  * - Kompresi lossless (data tidak hilang)
+ *
+ * Dari pohon hanya diambil PANJANG kode tiap karakter (maks. 15 bit,
+ * frekuensi diperkecil jika pohon terlalu dalam); kodenya sendiri
+ * diberikan secara kanonik (canonical_huffman.h) sehingga hasil encode
+ * berupa byte stream padat + tabel panjang kode saja.
+ *
+ * SEBAGAI CODEC (codec.h): train() membangun kode dari semua nilai
+ * kolom (+1 untuk byte 1..255 agar teks baru tetap bisa di-encode);
+ * stream compress() hanya [panjang][bit], tanpa tabel per nilai.
  */
 struct HuffmanNode {
     char karakter;
@@ -326,10 +501,13 @@ struct HuffmanNode {
     HuffmanNode(char k, int f) : karakter(k), frekuensi(f), left(NULL), right(NULL) {}
 };
 
-class HuffmanCoding {
+class HuffmanCoding : public Codec {
 private:
     HuffmanNode* root;
-    char kode[256][100];  // Kode Huffman untuk setiap karakter ASCII
+    NodePool<HuffmanNode> pool;     // Semua node pohon Huffman
+    CanonicalHuffman canonical;     // Panjang & kode kanonik per karakter
+    char kode[256][HUFFMAN_MAX_CODE_LENGTH + 1];  // Kode sebagai teks '0'/'1' (untuk ditampilkan)
+    HuffmanDecoder decoder;         // Tabel decode kode hasil train()
     
     // Min Heap manual
     HuffmanNode* heap[256];
@@ -378,28 +556,43 @@ private:
         return minNode;
     }
     
-    // Generate kode Huffman: kiri=0, kanan=1
-    void generateKode(HuffmanNode* node, char* code, int depth) {
-        if (!node) return;
+    // Kedalaman setiap leaf = panjang kode karakternya. Return kedalaman maksimum.
+    int collectLengths(HuffmanNode* node, int depth, int* lengths) {
+        if (!node) return 0;
         
-        // Leaf node - simpan kode
+        // Leaf node - pohon 1 karakter tetap butuh kode 1 bit
         if (!node->left && !node->right) {
-            code[depth] = '\0';
-            strcpy(kode[(unsigned char)node->karakter], code);
-            return;
+            lengths[(unsigned char)node->karakter] = depth > 0 ? depth : 1;
+            return lengths[(unsigned char)node->karakter];
         }
         
-        // Traverse kiri (tambah '0')
-        if (node->left) {
-            code[depth] = '0';
-            generateKode(node->left, code, depth + 1);
+        int left = collectLengths(node->left, depth + 1, lengths);
+        int right = collectLengths(node->right, depth + 1, lengths);
+        return left > right ? left : right;
+    }
+    
+    // Bangun pohon Huffman dari frekuensi (min heap), return root
+    HuffmanNode* buildFromHeap(const int* frekuensi) {
+        pool.releaseAll();
+        heapSize = 0;
+        for (int i = 0; i < 256; i++) {
+            if (frekuensi[i] > 0) {
+                insertHeap(pool.create((char)i, frekuensi[i]));
+            }
         }
         
-        // Traverse kanan (tambah '1')
-        if (node->right) {
-            code[depth] = '1';
-            generateKode(node->right, code, depth + 1);
+        while (heapSize > 1) {
+            HuffmanNode* left = extractMin();
+            HuffmanNode* right = extractMin();
+            
+            HuffmanNode* parent = pool.create('\0', left->frekuensi + right->frekuensi);
+            parent->left = left;
+            parent->right = right;
+            
+            insertHeap(parent);
         }
+        
+        return extractMin();
     }
     
 public:
@@ -415,39 +608,108 @@ public:
         for (int i = 0; text[i] != '\0'; i++) {
             frekuensi[(unsigned char)text[i]]++;
         }
+        buildFromFrequencies(frekuensi);
+    }
+    
+    void buildFromFrequencies(const int* frekuensiAwal) {
+        int frekuensi[256];
+        memcpy(frekuensi, frekuensiAwal, sizeof(frekuensi));
         
-        // 2. Masukkan ke heap
-        heapSize = 0;
-        for (int i = 0; i < 256; i++) {
-            if (frekuensi[i] > 0) {
-                insertHeap(new HuffmanNode((char)i, frekuensi[i]));
+        // 2-3. Bangun pohon; jika lebih dalam dari 15 level, frekuensi
+        // diperkecil (dibagi 2, minimal 1) lalu pohon dibangun ulang
+        int lengths[256];
+        while (true) {
+            root = buildFromHeap(frekuensi);
+            memset(lengths, 0, sizeof(lengths));
+            if (collectLengths(root, 0, lengths) <= HUFFMAN_MAX_CODE_LENGTH) break;
+            for (int i = 0; i < 256; i++) {
+                if (frekuensi[i] > 0) frekuensi[i] = (frekuensi[i] >> 1) | 1;
             }
         }
         
-        // 3. Bangun pohon Huffman
-        while (heapSize > 1) {
-            HuffmanNode* left = extractMin();
-            HuffmanNode* right = extractMin();
-            
-            HuffmanNode* parent = new HuffmanNode('\0', left->frekuensi + right->frekuensi);
-            parent->left = left;
-            parent->right = right;
-            
-            insertHeap(parent);
+        // 4. Kode kanonik dari panjang kode
+        canonical.clear();
+        for (int i = 0; i < 256; i++) {
+            canonical.length[i] = (uint8_t)lengths[i];
+        }
+        canonical.assignCodes();
+        for (int i = 0; i < 256; i++) {
+            int len = canonical.length[i];
+            for (int b = 0; b < len; b++) {
+                kode[i][b] = (canonical.code[i] >> (len - 1 - b)) & 1 ? '1' : '0';
+            }
+            kode[i][len] = '\0';
         }
-        
-        root = extractMin();
-        
-        // 4. Generate kode
-        char code[100];
-        generateKode(root, code, 0);
     }
     
-    void encode(const char* text, char* output) {
-        output[0] = '\0';
+    const CanonicalHuffman& getCanonical() const {
+        return canonical;
+    }
+    
+    // Kode sebagai teks '0'/'1' (untuk ditampilkan), dipotong jika output penuh
+    void encode(const char* text, char* output, size_t size) const {
+        size_t pos = 0;
         for (int i = 0; text[i] != '\0'; i++) {
-            strcat(output, kode[(unsigned char)text[i]]);
+            const char* k = kode[(unsigned char)text[i]];
+            size_t len = strlen(k);
+            if (pos + len >= size) break;
+            memcpy(output + pos, k, len);
+            pos += len;
+        }
+        output[pos] = '\0';
+    }
+    
+    // Stream kanonik padat: [panjang][tabel panjang kode][bit]. Return byte.
+    size_t encodePacked(const char* text, vector<uint8_t>& out) const {
+        return canonical.encode(text, strlen(text), out);
+    }
+    
+    // Decode stream dari encodePacked (tabel lookup, bukan penelusuran pohon)
+    bool decodePacked(const vector<uint8_t>& packed, char* out, size_t outSize) const {
+        return HuffmanDecoder::decodeStream(packed.data(), packed.size(), out, outSize);
+    }
+    
+    // ---- Codec: kode bersama 1 kolom ----
+    const char* name() const { return "huffman"; }
+    
+    void train(const char* const* samples, size_t count) {
+        uint64_t counted[256];
+        countSampleBytes(samples, count, counted);
+        
+        // Frekuensi int: diperkecil (dibagi 2, minimal 1) jika terlalu besar
+        uint64_t largest = 0;
+        for (int i = 0; i < 256; i++) largest = max(largest, counted[i] + 1);
+        int frekuensi[256];
+        for (int i = 0; i < 256; i++) {
+            uint64_t f = i == 0 ? 0 : counted[i] + 1;
+            for (uint64_t l = largest; l > (1u << 30); l >>= 1) f = (f >> 1) | 1;
+            frekuensi[i] = (int)f;
         }
+        buildFromFrequencies(frekuensi);
+        decoder.init(canonical);
+    }
+    
+    // [panjang][bit] dengan kode hasil train(), tanpa tabel
+    size_t compress(const char* text, size_t n, vector<uint8_t>& out) const {
+        for (size_t i = 0; i < n; i++) {
+            if (canonical.length[(unsigned char)text[i]] == 0) return 0;
+        }
+        size_t start = out.size();
+        putVarint(out, n);
+        BitWriter writer(out);
+        canonical.encodeBits(text, n, writer);
+        writer.flush();
+        return out.size() - start;
+    }
+    
+    bool decompress(const uint8_t* data, size_t size, char* out, size_t outSize) const {
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        uint64_t n;
+        if (decoder.getTableBits() == 0 || !getVarint(p, end, n) || n >= outSize) return false;
+        if (!decoder.decode(p, end - p, (size_t)n, out)) return false;
+        out[n] = '\0';
+        return true;
     }
     
     void displayKode() const {
@@ -464,23 +726,26 @@ public:
     }
     
     void calculateEfficiency(const char* original) const {
-        int originalBits = strlen(original) * 8;
+        size_t n = strlen(original);
+        int originalBytes = (int)n;
+        int compressedBits = (int)canonical.encodedBits(original, n);
         
-        char encoded[10000];
-        strcpy(encoded, "");
-        for (int i = 0; original[i] != '\0'; i++) {
-            strcat(encoded, kode[(unsigned char)original[i]]);
-        }
-        int compressedBits = strlen(encoded);
+        vector<uint8_t> packed;
+        int packedBytes = (int)encodePacked(original, packed);
+        vector<uint8_t> table;
+        int tableBytes = (int)canonical.writeTable(table);
         
         cout << "\n      === Efisiensi Kompresi Huffman ===\n";
         cout << "      String Original   : \"" << original << "\"\n";
-        cout << "      Panjang String    : " << strlen(original) << " karakter\n";
-        cout << "      Ukuran Original   : " << originalBits << " bits (ASCII 8-bit)\n";
-        cout << "      Ukuran Compressed : " << compressedBits << " bits\n";
+        cout << "      Panjang String    : " << n << " karakter\n";
+        cout << "      Ukuran Original   : " << originalBytes << " bytes (ASCII 8-bit)\n";
+        cout << "      Bit Kode          : " << compressedBits << " bits ("
+             << (compressedBits + 7) / 8 << " bytes)\n";
+        cout << "      Tabel Kode        : " << tableBytes << " bytes (panjang kode saja)\n";
+        cout << "      Ukuran Compressed : " << packedBytes << " bytes (stream lengkap)\n";
         cout << "      Rasio Kompresi    : " << fixed << setprecision(2) 
-             << (100.0 * compressedBits / originalBits) << "%\n";
-        cout << "      Penghematan       : " << (originalBits - compressedBits) << " bits\n";
+             << (100.0 * packedBytes / originalBytes) << "%\n";
+        cout << "      Penghematan       : " << (originalBytes - packedBytes) << " bytes\n";
         cout << "\n      PENJELASAN:\n";
         cout << "      - Setiap karakter ASCII = 8 bits\n";
         cout << "      - Huffman memberikan kode lebih pendek untuk karakter sering muncul\n";
@@ -488,6 +753,125 @@ public:
     }
 };
 
+// =================================================================
+// TRANSACTION STORE - Penyimpanan Record Transaksi (Append-Only)
+// =================================================================
+/*
+ * Record transaksi disimpan terpisah dari index. AVL Tree hanya
+ * menyimpan jumlah + nomor record 32-bit, sehingga rotasi dan
+ * perbandingan tidak ikut membaca field yang tidak perlu.
+ *
+ * KONSEP:
+ * - Append-only: record tidak pernah dipindah atau dihapus
+ * - Disimpan per chunk 4096 record -> alamat record stabil dan
+ *   menambah record tidak pernah menyalin record lama
+ * - rec -> (chunk, offset) = (rec >> 12, rec & 4095)
+ * - Record = TransaksiRecord (168 byte): keterangan disimpan
+ *   terkompresi di keteranganArena(), bukan char[200] (360 byte)
+ */
+const int TRANSACTION_CHUNK_BITS = 12;
+const uint32_t TRANSACTION_CHUNK_SIZE = 1u << TRANSACTION_CHUNK_BITS;
+
+class TransactionStore {
+private:
+    vector<TransaksiRecord*> chunks;
+    uint32_t count;
+    
+    TransactionStore(const TransactionStore&);
+    TransactionStore& operator=(const TransactionStore&);
+    
+public:
+    TransactionStore() : count(0) {}
+    
+    ~TransactionStore() {
+        for (size_t c = 0; c < chunks.size(); c++) {
+            free(chunks[c]);
+        }
+    }
+    
+    // Tambah record, return nomor record-nya. ID yang masuk dicatat ke
+    // transactionClock() -> ID baru selalu melanjutkan ID terbesar yang dimuat
+    uint32_t append(const Transaksi& t) {
+        transactionClock().observeId(t.id);
+        if ((count >> TRANSACTION_CHUNK_BITS) == chunks.size()) {
+            TransaksiRecord* chunk = (TransaksiRecord*)malloc(TRANSACTION_CHUNK_SIZE * sizeof(TransaksiRecord));
+            if (chunk == NULL) throw bad_alloc();
+            chunks.push_back(chunk);
+        }
+        uint32_t rec = count++;
+        new (&chunks[rec >> TRANSACTION_CHUNK_BITS][rec & (TRANSACTION_CHUNK_SIZE - 1)]) TransaksiRecord(t);
+        return rec;
+    }
+    
+    /*
+     * Tambah banyak record sekaligus (load awal), return record pertama.
+     * Model keterangan yang belum pernah dilatih dilatih dulu dari
+     * semua keterangan ini, agar arena tidak terisi kode 8 bit/karakter.
+     */
+    uint32_t appendBulk(const Transaksi* const* rows, int n) {
+        if (keteranganModels().versionCount() == 1 && n > 0) {
+            uint64_t freq[256] = {0};
+            for (int i = 0; i < n; i++) {
+                for (const char* p = rows[i]->keterangan; *p != '\0'; p++) {
+                    freq[(unsigned char)*p]++;
+                }
+            }
+            keteranganModels().train(freq);
+        }
+        uint32_t first = count;
+        for (int i = 0; i < n; i++) {
+            append(*rows[i]);
+        }
+        return first;
+    }
+    
+    const TransaksiRecord& at(uint32_t rec) const {
+        return chunks[rec >> TRANSACTION_CHUNK_BITS][rec & (TRANSACTION_CHUNK_SIZE - 1)];
+    }
+    
+    const TransaksiRecord& operator[](uint32_t rec) const { return at(rec); }
+    
+    uint32_t size() const { return count; }
+    
+    size_t reservedBytes() const {
+        return chunks.size() * TRANSACTION_CHUNK_SIZE * sizeof(TransaksiRecord);
+    }
+};
+
+/*
+ * PAGE TOKEN - posisi di index transaksi untuk melanjutkan laporan
+ * Index diurutkan berdasarkan (jumlah, nomor record); token menyimpan
+ * key baris berikutnya sehingga halaman bisa dilanjutkan kapan saja
+ * (juga setelah ada insert) tanpa menghitung ulang dari awal.
+ * Bentuk teks: "<jumlah>:<rec>", mis. "150000:1234".
+ */
+struct PageToken {
+    double key;
+    uint32_t rec;
+    
+    PageToken() : key(-DBL_MAX), rec(0) {}
+    PageToken(double k, uint32_t r) : key(k), rec(r) {}
+    
+    void format(char* out, size_t size) const {
+        snprintf(out, size, "%.17g:%u", key, rec);
+    }
+    
+    bool parse(const char* text) {
+        double k;
+        unsigned int r;
+        char extra;
+        if (sscanf(text, "%lf:%u%c", &k, &r, &extra) != 2) return false;
+        key = k;
+        rec = r;
+        return true;
+    }
+};
+
+// Urutan key index: jumlah, lalu nomor record (record lebih awal dulu)
+inline bool indexKeyLess(double a, uint32_t aRec, double b, uint32_t bRec) {
+    return a < b || (a == b && aRec < bRec);
+}
+
 // =================================================================
 // AVL TREE - Self-Balancing BST (BONUS)
 // =================================================================
@@ -508,21 +892,83 @@ public:
  * KEUNTUNGAN:
  * - Pencarian O(log n) - DIJAMIN
  * - Tree tidak akan menjadi skewed
+ * 
+ * NODE RAMPING:
+ * - Node hanya berisi key (jumlah), nomor record, height dan 2 anak
+ *   (sebelumnya ~390 byte karena menyimpan Transaksi utuh)
+ * - Record lengkap dibaca dari TransactionStore hanya saat ditampilkan
+ * 
+ * CURSOR:
+ * - Iterasi inorder tanpa rekursi dan tanpa alokasi: cursor menyimpan
+ *   jalur node (maks. AVL_MAX_HEIGHT) yang belum dikunjungi
+ * - lowerBound / upperBound / seek(PageToken) memposisikan cursor O(log n)
+ * 
+ * ORDER STATISTIC:
+ * - Setiap node menyimpan size (jumlah node di subtree) dan sum
+ *   (total jumlah di subtree), diperbarui saat insert dan rotasi
+ * - countInRange, sumInRange, kth dan percentile = O(log n),
+ *   tanpa mengunjungi setiap transaksi yang cocok
  */
 struct AVLNode {
-    Transaksi data;
+    double key;         // Salinan jumlah transaksi (satu-satunya yang dibandingkan)
+    double sum;         // Total key di subtree ini
+    uint32_t rec;       // Nomor record di TransactionStore
+    uint32_t size;      // Jumlah node di subtree ini
+    int height;
     AVLNode* left;
     AVLNode* right;
-    int height;
     
-    AVLNode(const Transaksi& t) : data(t), left(NULL), right(NULL), height(1) {}
+    AVLNode(double k, uint32_t r)
+        : key(k), sum(k), rec(r), size(1), height(1), left(NULL), right(NULL) {}
 };
 
+// Tinggi AVL <= 1.44 log2(n + 2): 64 cukup untuk 2^32 node
+const int AVL_MAX_HEIGHT = 64;
+
 class AVLTree {
+public:
+    /*
+     * Cursor inorder: stack berisi node yang belum dikunjungi (node saat
+     * ini di atas). next() = pindah ke successor, amortized O(1).
+     */
+    class Cursor {
+    private:
+        friend class AVLTree;
+        const AVLTree* tree;
+        AVLNode* path[AVL_MAX_HEIGHT];
+        int depth;
+        
+        void pushLeftSpine(AVLNode* node) {
+            while (node != NULL) {
+                path[depth++] = node;
+                node = node->left;
+            }
+        }
+        
+    public:
+        Cursor() : tree(NULL), depth(0) {}
+        
+        bool valid() const { return depth > 0; }
+        double key() const { return path[depth - 1]->key; }
+        uint32_t rec() const { return path[depth - 1]->rec; }
+        const TransaksiRecord& record() const { return tree->store[rec()]; }
+        PageToken token() const { return PageToken(key(), rec()); }
+        
+        void next() {
+            AVLNode* node = path[--depth];
+            pushLeftSpine(node->right);
+        }
+    };
+    
 private:
     AVLNode* root;
     int nodeCount;
     int rotationCount;
+    TransactionStore& store;    // Record lengkap, node hanya menyimpan nomornya
+    NodePool<AVLNode> pool;     // Node dibebaskan sekaligus saat tree dihancurkan
+    
+    AVLTree(const AVLTree&);
+    AVLTree& operator=(const AVLTree&);
     
     int getHeight(AVLNode* node) const {
         return node ? node->height : 0;
@@ -532,11 +978,22 @@ private:
         return node ? getHeight(node->left) - getHeight(node->right) : 0;
     }
     
-    void updateHeight(AVLNode* node) {
+    static uint32_t sizeOf(AVLNode* node) {
+        return node ? node->size : 0;
+    }
+    
+    static double sumOf(AVLNode* node) {
+        return node ? node->sum : 0.0;
+    }
+    
+    // Hitung ulang height, size dan sum dari kedua anak
+    void updateNode(AVLNode* node) {
         if (node) {
             int leftH = getHeight(node->left);
             int rightH = getHeight(node->right);
             node->height = 1 + (leftH > rightH ? leftH : rightH);
+            node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+            node->sum = node->key + sumOf(node->left) + sumOf(node->right);
         }
     }
     
@@ -549,8 +1006,8 @@ private:
         x->right = y;
         y->left = T2;
         
-        updateHeight(y);
-        updateHeight(x);
+        updateNode(y);
+        updateNode(x);
         
         return x;
     }
@@ -564,49 +1021,49 @@ private:
         y->left = x;
         x->right = T2;
         
-        updateHeight(x);
-        updateHeight(y);
+        updateNode(x);
+        updateNode(y);
         
         return y;
     }
     
-    AVLNode* insertRec(AVLNode* node, const Transaksi& t) {
+    AVLNode* insertRec(AVLNode* node, double key, uint32_t rec) {
         // 1. BST insert
         if (node == NULL) {
             nodeCount++;
-            return new AVLNode(t);
+            return pool.create(key, rec);
         }
         
-        if (t.jumlah < node->data.jumlah) {
-            node->left = insertRec(node->left, t);
+        if (indexKeyLess(key, rec, node->key, node->rec)) {
+            node->left = insertRec(node->left, key, rec);
         } else {
-            node->right = insertRec(node->right, t);
+            node->right = insertRec(node->right, key, rec);
         }
         
-        // 2. Update height
-        updateHeight(node);
+        // 2. Update height, size & sum
+        updateNode(node);
         
         // 3. Balance tree
         int balance = getBalance(node);
         
         // Left Left
-        if (balance > 1 && t.jumlah < node->left->data.jumlah) {
+        if (balance > 1 && indexKeyLess(key, rec, node->left->key, node->left->rec)) {
             return rotateRight(node);
         }
         
         // Right Right
-        if (balance < -1 && t.jumlah >= node->right->data.jumlah) {
+        if (balance < -1 && !indexKeyLess(key, rec, node->right->key, node->right->rec)) {
             return rotateLeft(node);
         }
         
         // Left Right
-        if (balance > 1 && t.jumlah >= node->left->data.jumlah) {
+        if (balance > 1 && !indexKeyLess(key, rec, node->left->key, node->left->rec)) {
             node->left = rotateLeft(node->left);
             return rotateRight(node);
         }
         
         // Right Left
-        if (balance < -1 && t.jumlah < node->right->data.jumlah) {
+        if (balance < -1 && indexKeyLess(key, rec, node->right->key, node->right->rec)) {
             node->right = rotateRight(node->right);
             return rotateLeft(node);
         }
@@ -614,27 +1071,51 @@ private:
         return node;
     }
     
-    void inorderRec(AVLNode* node) const {
-        if (node == NULL) return;
-        inorderRec(node->left);
-        node->data.display();
-        inorderRec(node->right);
-    }
-    
-    void searchRangeRec(AVLNode* node, double min, double max) const {
-        if (node == NULL) return;
+    // Bangun subtree dari sorted[lo..hi]: tengah jadi root, kiri & kanan rekursif
+    // (sorted[i] sudah disimpan sebagai record firstRec + i)
+    AVLNode* buildRec(const Transaksi* const* sorted, uint32_t firstRec, int lo, int hi) {
+        if (lo > hi) return NULL;
         
-        if (node->data.jumlah > min) {
-            searchRangeRec(node->left, min, max);
-        }
+        int mid = lo + (hi - lo + 1) / 2;
+        AVLNode* node = pool.create(sorted[mid]->jumlah, firstRec + (uint32_t)mid);
+        node->left = buildRec(sorted, firstRec, lo, mid - 1);
+        node->right = buildRec(sorted, firstRec, mid + 1, hi);
+        updateNode(node);
         
-        if (node->data.jumlah >= min && node->data.jumlah <= max) {
-            node->data.display();
+        return node;
+    }
+    
+    // Banyak transaksi dengan jumlah < x (dan total jumlahnya)
+    void countBelow(double x, uint32_t& count, double& sum) const {
+        count = 0;
+        sum = 0.0;
+        AVLNode* node = root;
+        while (node != NULL) {
+            if (node->key < x) {
+                count += sizeOf(node->left) + 1;
+                sum += sumOf(node->left) + node->key;
+                node = node->right;
+            } else {
+                node = node->left;
+            }
         }
-        
-        if (node->data.jumlah < max) {
-            searchRangeRec(node->right, min, max);
+    }
+    
+    // Node ke-k (0-based) dalam urutan inorder
+    AVLNode* kthNode(uint32_t k) const {
+        AVLNode* node = root;
+        while (node != NULL) {
+            uint32_t leftSize = sizeOf(node->left);
+            if (k < leftSize) {
+                node = node->left;
+            } else if (k == leftSize) {
+                return node;
+            } else {
+                k -= leftSize + 1;
+                node = node->right;
+            }
         }
+        return NULL;
     }
     
     void visualizeRec(AVLNode* node, int space, int height) const {
@@ -643,42 +1124,44 @@ private:
         space += height;
         visualizeRec(node->right, space, height);
         
-        cout << endl;
+        cout << "\n";
         for (int i = height; i < space; i++) cout << " ";
-        cout << "Rp" << node->data.jumlah << " [BF:" << getBalance(node) << "]" << endl;
+        cout << "Rp" << node->key << " [BF:" << getBalance(node) << "]\n";
         
         visualizeRec(node->left, space, height);
     }
     
 public:
-    AVLTree() : root(NULL), nodeCount(0), rotationCount(0) {}
+    explicit AVLTree(TransactionStore& transactions)
+        : root(NULL), nodeCount(0), rotationCount(0), store(transactions) {}
     
+    // Simpan record ke store lalu index jumlahnya
     void insert(const Transaksi& t) {
-        root = insertRec(root, t);
+        insertRecord(store.append(t), t.jumlah);
     }
     
-    void displayInorder() const {
-        if (root == NULL) {
-            cout << "      Tree kosong.\n";
-            return;
-        }
-        cout << "-----------------------------------------------------------------------" << endl;
-        cout << "| Jenis Transaksi | Jumlah        | Keterangan                        |" << endl;
-        cout << "-----------------------------------------------------------------------" << endl;
-        inorderRec(root);
-        cout << "-----------------------------------------------------------------------" << endl;
+    // Index record yang sudah ada di store
+    void insertRecord(uint32_t rec, double key) {
+        root = insertRec(root, key, rec);
     }
     
-    void searchByRange(double min, double max) const {
-        if (root == NULL) {
-            cout << "      Tree kosong.\n";
+    /*
+     * BULK BUILD - Bangun tree dari data yang SUDAH TERURUT (jumlah)
+     * - Setiap node ditempatkan langsung di posisi akhirnya: O(n)
+     * - Tinggi = ceil(log2(n+1)), |BF| <= 1 untuk semua node
+     * - Tidak ada rotasi, jadi rotationCount tidak bertambah
+     * Hanya untuk tree kosong (dipakai saat load awal).
+     */
+    void buildFromSorted(const Transaksi* const* sorted, int n) {
+        if (root != NULL) {
+            for (int i = 0; i < n; i++) {
+                insert(*sorted[i]);
+            }
             return;
         }
-        cout << "-----------------------------------------------------------------------" << endl;
-        cout << "| Jenis Transaksi | Jumlah        | Keterangan                        |" << endl;
-        cout << "-----------------------------------------------------------------------" << endl;
-        searchRangeRec(root, min, max);
-        cout << "-----------------------------------------------------------------------" << endl;
+        uint32_t firstRec = store.appendBulk(sorted, n);
+        root = buildRec(sorted, firstRec, 0, n - 1);
+        nodeCount = n;
     }
     
     void visualize() const {
@@ -705,6 +1188,115 @@ public:
     bool isEmpty() const {
         return root == NULL;
     }
+    
+    int getNodeCount() const {
+        return nodeCount;
+    }
+    
+    int getHeight() const {
+        return getHeight(root);
+    }
+    
+    const TransactionStore& getStore() const {
+        return store;
+    }
+    
+    // Memori yang dipakai node index (tidak termasuk store)
+    size_t indexBytes() const {
+        return pool.reservedBytes();
+    }
+    
+    // ---- Cursor ----
+    
+    Cursor begin() const {
+        Cursor c;
+        c.tree = this;
+        c.pushLeftSpine(root);
+        return c;
+    }
+    
+    // Cursor di key pertama >= (key, rec)
+    Cursor seek(const PageToken& token) const {
+        Cursor c;
+        c.tree = this;
+        AVLNode* node = root;
+        while (node != NULL) {
+            if (!indexKeyLess(node->key, node->rec, token.key, token.rec)) {
+                c.path[c.depth++] = node;     // Kandidat, cari yang lebih kecil di kiri
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+        return c;
+    }
+    
+    // Cursor di transaksi pertama dengan jumlah >= amount
+    Cursor lowerBound(double amount) const {
+        return seek(PageToken(amount, 0));
+    }
+    
+    // Cursor di transaksi pertama dengan jumlah > amount
+    Cursor upperBound(double amount) const {
+        return seek(PageToken(nextafter(amount, DBL_MAX), 0));
+    }
+    
+    // Kunjungi semua transaksi secara inorder (urut jumlah)
+    template <typename Fn>
+    void forEachInorder(Fn fn) const {
+        for (Cursor c = begin(); c.valid(); c.next()) {
+            fn(c.record());
+        }
+    }
+    
+    // Banyak transaksi dengan jumlah di [min, max]: O(log n)
+    int countInRange(double min, double max) const {
+        if (max < min) return 0;
+        uint32_t upper, lower;
+        double upperSum, lowerSum;
+        countBelow(nextafter(max, DBL_MAX), upper, upperSum);
+        countBelow(min, lower, lowerSum);
+        return (int)(upper - lower);
+    }
+    
+    // Total jumlah transaksi dengan jumlah di [min, max]: O(log n)
+    double sumInRange(double min, double max) const {
+        if (max < min) return 0.0;
+        uint32_t upper, lower;
+        double upperSum, lowerSum;
+        countBelow(nextafter(max, DBL_MAX), upper, upperSum);
+        countBelow(min, lower, lowerSum);
+        return upperSum - lowerSum;
+    }
+    
+    // Transaksi ke-k (0-based, urut jumlah), NULL jika k di luar jangkauan
+    const TransaksiRecord* kth(int k) const {
+        if (k < 0 || k >= nodeCount) return NULL;
+        return &store[kthNode((uint32_t)k)->rec];
+    }
+    
+    // Jumlah pada persentil p (0-100, nearest rank), 0 jika tree kosong
+    double percentile(double p) const {
+        if (nodeCount == 0) return 0.0;
+        int k = (int)ceil(p / 100.0 * nodeCount) - 1;
+        if (k < 0) k = 0;
+        if (k >= nodeCount) k = nodeCount - 1;
+        return kthNode((uint32_t)k)->key;
+    }
+    
+    // Kunjungi nomor record dengan jumlah di [min, max] tanpa membaca record
+    template <typename Fn>
+    void forEachRecInRange(double min, double max, Fn fn) const {
+        for (Cursor c = lowerBound(min); c.valid() && c.key() <= max; c.next()) {
+            fn(c.rec());
+        }
+    }
+    
+    // Kunjungi transaksi dengan jumlah di [min, max] secara inorder
+    template <typename Fn>
+    void forEachInRange(double min, double max, Fn fn) const {
+        forEachRecInRange(min, max, [&](uint32_t rec) { fn(store[rec]); });
+    }
 };
 
 #endif
@@ -6,18 +6,70 @@
 #include <cstdlib>
 #include <ctime>
 #include "user.h"
+#include "account_table.h"
 #include "data_structures.h"
+#include "transaction_index.h"
+#include "transaction_report.h"
+#include "account_store.h"
+#include "transaction_log.h"
+#include "parallel_loader.h"
+#include "tokenizer.h"
+#include "checkpoint.h"
+#include "columnar_archive.h"
+#include "log_segments.h"
+#include "block_compressor.h"
+#include "admin_credentials.h"
+#include "time_util.h"
+#include <algorithm>
+#include <queue>
 
 using namespace std;
 
+// Checkpoint ditulis ulang setelah sekian transaksi baru
+const int CHECKPOINT_INTERVAL = 1000;
+
+// Ukuran buffer ekspor laporan (ditulis ke file per 1 MB, bukan per baris)
+const size_t EXPORT_BUFFER_SIZE = 1024 * 1024;
+
+// 1 transaksi dalam format baris transactions.txt / WAL (tanpa '\n')
+inline int formatTransactionLine(const TransaksiBase& t, const char* keterangan, char* out, size_t size) {
+    char waktu[20];
+    int len = snprintf(out, size, "%s|%s|%s|%s|%s|%.15g|%s",
+                       t.id, t.formatWaktu(waktu), t.jenis, t.dari, t.ke,
+                       t.jumlah, keterangan);
+    return len < (int)size ? len : (int)size - 1;
+}
+
+inline int formatTransactionLine(const Transaksi& t, char* out, size_t size) {
+    return formatTransactionLine(t, t.keterangan, out, size);
+}
+
+inline int formatTransactionLine(const TransaksiRecord& t, char* out, size_t size) {
+    char keterangan[KETERANGAN_MAX_LENGTH];
+    return formatTransactionLine(t, t.keteranganText(keterangan), out, size);
+}
+
 // =================================================================
 // CLASS FILE HANDLER - Manajemen File .txt Database
 // =================================================================
 class FileHandler {
 private:
     const char* userFile;
+    const char* accountFile;
     const char* adminFile;
     const char* transactionFile;
+    const char* logFile;
+    const char* archiveFile;
+    AccountStore accountStore;
+    TransactionLog transactionLog;
+    bool logOpened;
+    const char* checkpointFiles[2];
+    int transactionsSinceCheckpoint;
+    ColumnarArchive archive;
+    SegmentCatalog segmentCatalog;
+    bool segmentsLoaded;
+    WalTail walTail;
+    AdminCredentialTable adminTable;
     
     void generateNIK(char* nik) {
         for (int i = 0; i < 16; i++) {
@@ -33,11 +85,44 @@ private:
         sprintf(date, "%02d/%02d/%04d", day, month, year);
     }
     
+    void userToRecord(const User& user, AccountRecord& rec) {
+        memset(&rec, 0, sizeof(AccountRecord));
+        KTP ktp = user.getKTP();
+        rec.saldo = user.getSaldo();
+        copyField(rec.username, sizeof(rec.username), user.getUsername());
+        copyField(rec.password, sizeof(rec.password), user.getPassword());
+        copyField(rec.pin, sizeof(rec.pin), user.getPIN());
+        copyField(rec.nik, sizeof(rec.nik), ktp.nik);
+        copyField(rec.namaLengkap, sizeof(rec.namaLengkap), ktp.namaLengkap);
+        copyField(rec.alamat, sizeof(rec.alamat), ktp.alamat);
+        copyField(rec.tanggalLahir, sizeof(rec.tanggalLahir), ktp.tanggalLahir);
+    }
+    
+    void recordToUser(const AccountRecord& rec, User& user) {
+        KTP ktp;
+        strcpy(ktp.nik, rec.nik);
+        strcpy(ktp.namaLengkap, rec.namaLengkap);
+        strcpy(ktp.alamat, rec.alamat);
+        strcpy(ktp.tanggalLahir, rec.tanggalLahir);
+        
+        user = User(rec.username, rec.password, rec.pin, rec.saldo);
+        user.setKTP(ktp);
+    }
+    
 public:
     FileHandler() {
         userFile = "users.txt";
+        accountFile = "users.dat";
         adminFile = "admins.txt";
         transactionFile = "transactions.txt";
+        logFile = "transactions.wal";
+        archiveFile = "transactions.col";
+        logOpened = false;
+        checkpointFiles[0] = "checkpoint.0.ckp";
+        checkpointFiles[1] = "checkpoint.1.ckp";
+        transactionsSinceCheckpoint = 0;
+        segmentsLoaded = false;
+        adminTable.setFile(adminFile);
         srand(time(0));
     }
     
@@ -53,6 +138,13 @@ public:
             checkUser.close();
         }
         
+        // users.dat yang sudah ada juga dianggap database valid
+        ifstream checkAccount(accountFile, ios::binary);
+        if (checkAccount.is_open()) {
+            userExists = true;
+            checkAccount.close();
+        }
+        
         if (!userExists) {
             cout << "\n=== Inisialisasi Database ===\n";
             cout << "Membuat dummy data...\n";
@@ -169,161 +261,913 @@ public:
         file.close();
     }
     
-    int loadUsers(User*& users) {
-        ifstream file(userFile);
-        if (!file.is_open()) {
-            return 0;
+    // =================================================================
+    // KONVERTER users.txt -> users.dat (dijalankan sekali)
+    // =================================================================
+    /*
+     * Membaca users.txt (format pipe "|") lalu menulis semua akun ke
+     * users.dat dalam format record biner fixed-size. File ditulis ke
+     * users.dat.tmp terlebih dahulu lalu di-rename, sehingga konversi
+     * yang terputus tidak meninggalkan users.dat setengah jadi.
+     */
+    bool convertUsersText(const char* txtPath, const char* datPath) {
+        MappedFile file;
+        if (!file.open(txtPath)) {
+            return false;
         }
         
+        const char* begin = file.data();
+        const char* end = begin + file.size();
+        
         int count = 0;
-        char line[500];
-        while (file.getline(line, 500)) {
-            count++;
+        for (const char* p = begin; p < end; p++) {
+            if (*p == '\n') count++;
         }
         
-        file.clear();
-        file.seekg(0);
+        char tmpPath[260];
+        sprintf(tmpPath, "%s.tmp", datPath);
         
-        users = new User[count];
+        AccountStore store;
+        if (!store.create(tmpPath, count + 1)) {
+            cout << "Error: Tidak bisa membuat file users.dat\n";
+            return false;
+        }
         
+        RecordTokenizer tokenizer(begin, end);
+        string_view f[8];
+        int n;
         int idx = 0;
-        while (file.getline(line, 500)) {
-            char username[50], password[50], pin[7];
-            double saldo;
-            KTP ktp;
-            
-            char* token = strtok(line, "|");
-            strcpy(username, token);
-            
-            token = strtok(NULL, "|");
-            strcpy(password, token);
-            
-            token = strtok(NULL, "|");
-            strcpy(pin, token);
-            
-            token = strtok(NULL, "|");
-            saldo = atof(token);
-            
-            token = strtok(NULL, "|");
-            strcpy(ktp.nik, token);
-            
-            token = strtok(NULL, "|");
-            strcpy(ktp.namaLengkap, token);
-            
-            token = strtok(NULL, "|");
-            strcpy(ktp.alamat, token);
+        
+        while ((n = tokenizer.nextRecord(f, 8)) >= 0) {
+            if (n < 8) continue;
             
-            token = strtok(NULL, "|");
-            strcpy(ktp.tanggalLahir, token);
+            if (!store.setCount(idx + 1)) {
+                store.close();
+                remove(tmpPath);
+                return false;
+            }
+            AccountRecord* rec = store.record(idx);
+            memset(rec, 0, sizeof(AccountRecord));
             
-            users[idx] = User(username, password, pin, saldo);
-            users[idx].setKTP(ktp);
+            copyField(rec->username, sizeof(rec->username), f[0]);
+            copyField(rec->password, sizeof(rec->password), f[1]);
+            copyField(rec->pin, sizeof(rec->pin), f[2]);
+            parseDouble(f[3], rec->saldo);
+            copyField(rec->nik, sizeof(rec->nik), f[4]);
+            copyField(rec->namaLengkap, sizeof(rec->namaLengkap), f[5]);
+            copyField(rec->alamat, sizeof(rec->alamat), f[6]);
+            copyField(rec->tanggalLahir, sizeof(rec->tanggalLahir), f[7]);
             idx++;
         }
-        
         file.close();
-        return count;
+        
+        // Data harus sudah di disk sebelum rename, jika tidak rename bisa
+        // tersimpan lebih dulu dan users.dat berisi record kosong
+        bool synced = store.syncAll();
+        store.close();
+        if (!synced) {
+            remove(tmpPath);
+            return false;
+        }
+        
+        remove(datPath);
+        if (rename(tmpPath, datPath) != 0) {
+            cout << "Error: Tidak bisa menyimpan users.dat\n";
+            return false;
+        }
+        return true;
+    }
+    
+    /*
+     * LOAD USERS DARI users.dat (mmap)
+     * Jika users.dat belum ada, users.txt dikonversi terlebih dahulu.
+     * Tidak ada parsing teks, tetapi setiap record tetap disalin ke User
+     * di AccountTable -> startup O(n) (sekitar 0.7 detik dan ~460 MB
+     * per 1 juta akun), bukan O(1). Seluruh kode memegang User* sehingga
+     * field belum dibaca langsung dari record mmap.
+     */
+    int loadUsers(AccountTable& accounts) {
+        if (!accountStore.open(accountFile)) {
+            // users.dat hilang/rusak: pulihkan dari checkpoint, lalu users.txt
+            if (!restoreAccountsFromCheckpoint() &&
+                !convertUsersText(userFile, accountFile)) {
+                return 0;
+            }
+            if (!accountStore.open(accountFile)) {
+                return 0;
+            }
+        }
+        
+        int count = (int)accountStore.getCount();
+        accounts.reserve(count);
+        
+        User user;
+        for (int i = 0; i < count; i++) {
+            recordToUser(*accountStore.record(i), user);
+            if (accounts.add(user) == NULL) {
+                cout << "Error: Tabel akun penuh\n";
+                break;
+            }
+        }
+        
+        return accounts.size();
     }
     
+    /*
+     * LOGIN ADMIN
+     * Kredensial dicari di hash table di memori; admins.txt hanya dibaca
+     * ulang jika file-nya berubah (mtime / inode / ukuran).
+     */
     bool loadAdmin(const char* username, const char* password, char* adminID) {
-        ifstream file(adminFile);
-        if (!file.is_open()) {
+        return adminTable.authenticate(username, password, adminID);
+    }
+    
+    // Username dipakai oleh admin (tidak boleh didaftarkan sebagai user)
+    bool isAdminUsername(const char* username) {
+        return adminTable.contains(username);
+    }
+    
+    /*
+     * Isi Transaksi dari field "id|timestamp|jenis|dari|ke|jumlah|keterangan".
+     * Field berupa string_view dari RecordTokenizer (zero-copy), hanya
+     * disalin sekali ke field fixed-size Transaksi; timestamp langsung
+     * di-parse ke epoch.
+     */
+    static bool fillTransaction(const string_view* f, int n, Transaksi& t) {
+        if (n < 6) return false;
+        
+        copyField(t.id, sizeof(t.id), f[0]);
+        if (!parseTimestamp(f[1], t.waktu)) return false;
+        copyField(t.jenis, sizeof(t.jenis), f[2]);
+        copyField(t.dari, sizeof(t.dari), f[3]);
+        copyField(t.ke, sizeof(t.ke), f[4]);
+        if (!parseDouble(f[5], t.jumlah)) return false;
+        if (n > 6) copyField(t.keterangan, sizeof(t.keterangan), f[6]);
+        
+        return true;
+    }
+    
+    // Parse semua baris dalam 1 chunk file (aman dipanggil multi-thread)
+    static void parseTransactionChunk(const char* p, const char* end, vector<Transaksi>& out) {
+        RecordTokenizer tokenizer(p, end);
+        string_view f[7];
+        int n;
+        
+        while ((n = tokenizer.nextRecord(f, 7)) >= 0) {
+            Transaksi t;
+            if (fillTransaction(f, n, t)) {
+                out.push_back(t);
+            }
+        }
+    }
+    
+    // Potong teks per baris menjadi chunk, parse setiap chunk di thread pool
+    static void parseTextChunks(const char* data, size_t size, vector< vector<Transaksi> >& rows) {
+        vector<size_t> bounds;
+        splitChunks(data, size, LOADER_CHUNK_SIZE, bounds);
+        
+        int chunkCount = (int)bounds.size() - 1;
+        size_t first = rows.size();
+        rows.resize(first + chunkCount);
+        parallelFor(chunkCount, [&](int c) {
+            parseTransactionChunk(data + bounds[c], data + bounds[c + 1], rows[first + c]);
+        });
+    }
+    
+    // transactions.txt yang sudah dikompresi per blok
+    void packedTransactionFile(char* out, size_t size) {
+        snprintf(out, size, "%s%s", transactionFile, BLOCK_FILE_SUFFIX);
+    }
+    
+    /*
+     * Parse transactions.txt (mmap), atau transactions.txt.hz jika teksnya
+     * sudah dikompresi: setiap blok (= baris utuh) didekompresi dan
+     * di-parse langsung di thread pool, tanpa menyalin seluruh file.
+     * Return false jika keduanya tidak ada.
+     */
+    bool parseLegacyTransactions(vector< vector<Transaksi> >& rows) {
+        MappedFile file;
+        if (file.open(transactionFile)) {
+            parseTextChunks(file.data(), file.size(), rows);
+            return true;
+        }
+        
+        char packedPath[260];
+        packedTransactionFile(packedPath, sizeof(packedPath));
+        BlockFileReader reader;
+        if (!reader.open(packedPath)) {
             return false;
         }
         
-        char line[200];
-        while (file.getline(line, 200)) {
-            char user[50], pass[50], id[20];
-            
-            char* token = strtok(line, "|");
-            strcpy(user, token);
-            
-            token = strtok(NULL, "|");
-            strcpy(pass, token);
-            
-            token = strtok(NULL, "|");
-            strcpy(id, token);
-            
-            if (strcmp(user, username) == 0 && strcmp(pass, password) == 0) {
-                strcpy(adminID, id);
-                file.close();
-                return true;
+        if (!reader.lineAligned()) {
+            vector<char> text;
+            if (!reader.readAll(text)) {
+                cout << "Error: Blok rusak di " << packedPath << "\n";
+                return false;
             }
+            parseTextChunks(text.data(), text.size(), rows);
+            return true;
         }
         
-        file.close();
-        return false;
+        int blockCount = (int)reader.blockCount();
+        size_t first = rows.size();
+        rows.resize(first + blockCount);
+        atomic<int> damaged(0);
+        parallelFor(blockCount, [&](int b) {
+            vector<char> text;
+            if (!reader.readBlock(b, text)) {
+                damaged++;
+                return;
+            }
+            parseTransactionChunk(text.data(), text.data() + text.size(), rows[first + b]);
+        });
+        if (damaged > 0) {
+            cout << "Error: " << damaged << " blok rusak di " << packedPath
+                 << ", transaksinya dilewati\n";
+        }
+        return true;
     }
     
-    void loadTransactions(AVLTree& avlTree) {
-        ifstream file(transactionFile);
-        if (!file.is_open()) {
+    // Urutkan 1 chunk berdasarkan jumlah (stable -> urutan file dipertahankan)
+    static void sortChunk(const vector<Transaksi>& rows, vector<const Transaksi*>& sorted) {
+        sorted.resize(rows.size());
+        for (size_t i = 0; i < rows.size(); i++) {
+            sorted[i] = &rows[i];
+        }
+        stable_sort(sorted.begin(), sorted.end(),
+                    [](const Transaksi* a, const Transaksi* b) { return a->jumlah < b->jumlah; });
+    }
+    
+    // Buka transaction log (WAL) sekali, dipakai sampai program selesai
+    bool openLog() {
+        if (!segmentsLoaded) {
+            segmentCatalog.load();
+            segmentsLoaded = true;
+        }
+        if (!logOpened) {
+            logOpened = transactionLog.open(logFile);
+        }
+        return logOpened;
+    }
+    
+    // LSN awal record WAL yang belum tersegel
+    uint64_t unsealedLsn() {
+        uint64_t base = transactionLog.getBaseLsn();
+        uint64_t sealed = segmentCatalog.endLsn();
+        return sealed > base ? sealed : base;
+    }
+    
+    /*
+     * LOAD TRANSAKSI (PARALEL)
+     * 1. transactions.txt di-mmap lalu dipotong per baris menjadi chunk
+     * 2. Setiap chunk di-parse dan diurutkan di thread pool
+     * 3. Setiap segmen log tertutup menjadi 1 chunk, transaksi dari WAL
+     *    (transactions.wal) yang belum tersegel menjadi chunk terakhir
+     * 4. Semua chunk yang sudah urut digabung (k-way merge), lalu
+     *    index transaksi dibangun sekaligus dalam O(n) tanpa rotasi/split
+     * Jika ada checkpoint valid, langkah 1-4 dilewati: tree dibangun dari
+     * checkpoint dan hanya WAL setelah LSN checkpoint yang di-replay.
+     */
+    void loadTransactions(TransactionIndex& transactionIndex, RefundStack& refundStack,
+                          CSQueue& csQueue) {
+        // Jalur cepat: checkpoint + replay ekor WAL
+        uint64_t checkpointLsn;
+        if (transactionIndex.isEmpty() &&
+            loadCheckpoint(transactionIndex, refundStack, csQueue, checkpointLsn)) {
+            int replayed = 0;
+            transactionLog.replay(checkpointLsn, [&](char* payload, uint32_t len, uint64_t) {
+                vector<Transaksi> rows;
+                parseTransactionChunk(payload, payload + len, rows);
+                for (size_t i = 0; i < rows.size(); i++) {
+                    transactionIndex.insert(rows[i]);
+                    replayed++;
+                }
+            });
+            cout << "Checkpoint dimuat, " << replayed << " transaksi baru di-replay dari WAL.\n";
+            transactionsSinceCheckpoint = replayed;
+            return;
+        }
+        
+        vector< vector<Transaksi> > rows;
+        parseLegacyTransactions(rows);
+        
+        if (openLog() && segmentCatalog.count() > 0) {
+            size_t first = rows.size();
+            rows.resize(first + segmentCatalog.count());
+            parallelFor(segmentCatalog.count(), [&](int s) {
+                const ColumnarArchive& segment = segmentCatalog.segment(s);
+                vector<Transaksi>& out = rows[first + s];
+                out.resize(segment.rowCount());
+                for (uint64_t i = 0; i < segment.rowCount(); i++) {
+                    segment.row(i, out[i]);
+                }
+            });
+        }
+        
+        rows.push_back(vector<Transaksi>());
+        if (openLog()) {
+            vector<Transaksi>& walRows = rows.back();
+            transactionLog.replay(unsealedLsn(), [&](char* payload, uint32_t len, uint64_t) {
+                parseTransactionChunk(payload, payload + len, walRows);
+            });
+        }
+        
+        // Tree sudah berisi data -> insert biasa satu per satu
+        if (!transactionIndex.isEmpty()) {
+            for (size_t c = 0; c < rows.size(); c++) {
+                for (size_t i = 0; i < rows[c].size(); i++) {
+                    transactionIndex.insert(rows[c][i]);
+                }
+            }
             return;
         }
         
+        int chunkCount = (int)rows.size();
+        vector< vector<const Transaksi*> > sorted(chunkCount);
+        parallelFor(chunkCount, [&](int c) {
+            sortChunk(rows[c], sorted[c]);
+        });
+        
+        // K-way merge, jumlah sama -> chunk lebih awal didahulukan
+        typedef pair<double, pair<int, size_t> > HeapItem;
+        priority_queue<HeapItem, vector<HeapItem>, greater<HeapItem> > heap;
+        size_t total = 0;
+        for (int c = 0; c < chunkCount; c++) {
+            total += sorted[c].size();
+            if (!sorted[c].empty()) {
+                heap.push(HeapItem(sorted[c][0]->jumlah, make_pair(c, (size_t)0)));
+            }
+        }
+        
+        vector<const Transaksi*> merged;
+        merged.reserve(total);
+        while (!heap.empty()) {
+            int c = heap.top().second.first;
+            size_t i = heap.top().second.second;
+            heap.pop();
+            
+            merged.push_back(sorted[c][i]);
+            if (i + 1 < sorted[c].size()) {
+                heap.push(HeapItem(sorted[c][i + 1]->jumlah, make_pair(c, i + 1)));
+            }
+        }
+        
+        transactionIndex.buildFromSorted(merged.data(), (int)merged.size());
+    }
+    
+    /*
+     * SIMPAN USERS KE users.dat (INCREMENTAL)
+     * Hanya user yang ada di antrian dirty yang ditulis: record-nya
+     * ditimpa langsung di mmap (in-place) lalu page-nya di-flush.
+     * Biaya logout = O(jumlah akun yang berubah), bukan O(total akun).
+     *
+     * Jika flush gagal, slot yang belum tersimpan dikembalikan ke antrian
+     * dirty (dicoba lagi pada save berikutnya) dan fungsi return false.
+     */
+    bool saveUsers(AccountTable& accounts) {
+        int count = accounts.size();
+        if (!accountStore.isOpen() && !accountStore.create(accountFile, count)) {
+            cout << "Error: Tidak bisa menyimpan data users\n";
+            return false;
+        }
+        
+        if ((uint64_t)count > accountStore.getCount()) {
+            if (!accountStore.setCount(count) || !accountStore.syncHeader()) {
+                cout << "Error: Tidak bisa menyimpan data users\n";
+                return false;
+            }
+        }
+        
+        vector<int> dirtySlots;
+        User::takeDirtySlots(dirtySlots);
+        
+        for (size_t i = 0; i < dirtySlots.size(); i++) {
+            int slot = dirtySlots[i];
+            if (slot < 0 || slot >= count) continue;
+            
+            userToRecord(accounts[slot], *accountStore.record(slot));
+            if (!accountStore.syncRecord(slot)) {
+                for (size_t j = i; j < dirtySlots.size(); j++) {
+                    int s = dirtySlots[j];
+                    if (s < 0 || s >= count) continue;
+                    accounts[s].clearDirty();
+                    accounts[s].markDirty();
+                }
+                cout << "Error: Data user belum tersimpan ke disk\n";
+                return false;
+            }
+            accounts[slot].clearDirty();
+        }
+        return true;
+    }
+    
+    /*
+     * SIMPAN 1 TRANSAKSI KE WAL
+     * Record ditulis ke log yang selalu terbuka dan baru dianggap
+     * berhasil setelah group commit selesai (write + fdatasync).
+     * Return false jika transaksi TIDAK tersimpan (saldo jangan diubah).
+     */
+    bool appendTransaction(const Transaksi& t) {
         char line[500];
-        while (file.getline(line, 500)) {
-            Transaksi t;
+        int len = formatTransactionLine(t, line, sizeof(line));
+        
+        if (!openLog() || !transactionLog.append(line, (uint32_t)len)) {
+            cout << "Error: Tidak bisa menyimpan transaksi\n";
+            return false;
+        }
+        transactionsSinceCheckpoint++;
+        return true;
+    }
+    
+    // =================================================================
+    // CHECKPOINT
+    // =================================================================
+    // Ukuran transactions.txt (ukuran asli jika sudah dikompresi)
+    uint64_t legacyTransactionSize() {
+        ifstream file(transactionFile, ios::binary | ios::ate);
+        if (file.is_open()) return (uint64_t)file.tellg();
+        
+        char packedPath[260];
+        packedTransactionFile(packedPath, sizeof(packedPath));
+        BlockFileReader reader;
+        return reader.open(packedPath) ? reader.originalSize() : 0;
+    }
+    
+    // Index slot checkpoint valid dengan LSN terbesar (-1 jika tidak ada)
+    int newestCheckpoint(CheckpointHeader& header) {
+        memset(&header, 0, sizeof(header));
+        int best = -1;
+        for (int i = 0; i < 2; i++) {
+            CheckpointHeader h;
+            if (readCheckpointHeader(checkpointFiles[i], h) &&
+                (best < 0 || h.lsn > header.lsn)) {
+                header = h;
+                best = i;
+            }
+        }
+        return best;
+    }
+    
+    /*
+     * Tulis checkpoint ke slot yang lebih lama.
+     * Mencakup akun, semua transaksi (inorder), refund dan tiket pending.
+     */
+    bool writeCheckpoint(TransactionIndex& transactionIndex, RefundStack& refundStack,
+                         CSQueue& csQueue, AccountTable& accounts) {
+        if (!openLog()) return false;
+        int userCount = accounts.size();
+        
+        CheckpointHeader header;
+        memset(&header, 0, sizeof(header));
+        header.lsn = transactionLog.endLsn();
+        header.legacySize = legacyTransactionSize();
+        header.accountCount = userCount;
+        header.transactionCount = transactionIndex.getNodeCount();
+        header.refundCount = refundStack.getSize();
+        header.ticketCount = csQueue.getSize();
+        
+        CheckpointWriter writer;
+        AccountRecord rec;
+        for (int i = 0; i < userCount; i++) {
+            userToRecord(accounts[i], rec);
+            putAccount(writer, rec);
+        }
+        transactionIndex.forEachInorder([&](const TransaksiRecord& t) { putTransaksi(writer, t); });
+        refundStack.forEach([&](const RefundRequest& req) { putRefund(writer, req); });
+        csQueue.forEach([&](const CSTicket& ticket) { putTicket(writer, ticket); });
+        
+        // Timpa slot yang tidak valid / LSN-nya lebih kecil
+        CheckpointHeader newest;
+        int slot = newestCheckpoint(newest) == 0 ? 1 : 0;
+        
+        if (!writeCheckpointFile(checkpointFiles[slot], header, writer.data())) {
+            cout << "Error: Tidak bisa menulis checkpoint\n";
+            return false;
+        }
+        transactionsSinceCheckpoint = 0;
+        
+        // Semua record WAL sudah tercakup checkpoint -> aman disegel
+        rollLogIfDue();
+        return true;
+    }
+    
+    // Checkpoint periodik: hanya jika sudah ada cukup transaksi baru
+    void checkpointIfDue(TransactionIndex& transactionIndex, RefundStack& refundStack,
+                         CSQueue& csQueue, AccountTable& accounts) {
+        if (transactionsSinceCheckpoint >= CHECKPOINT_INTERVAL) {
+            writeCheckpoint(transactionIndex, refundStack, csQueue, accounts);
+        }
+    }
+    
+    /*
+     * Muat checkpoint valid terbaru. Checkpoint hanya dipakai jika
+     * transactions.txt tidak berubah dan LSN-nya masih ada di WAL aktif
+     * (bukan di segmen yang sudah tersegel).
+     */
+    bool loadCheckpoint(TransactionIndex& transactionIndex, RefundStack& refundStack,
+                        CSQueue& csQueue, uint64_t& lsn) {
+        if (!openLog()) return false;
+        
+        for (int attempt = 0; attempt < 2; attempt++) {
+            CheckpointHeader header;
+            int slot = newestCheckpoint(header);
+            if (attempt == 1) slot = 1 - slot;   // Coba slot lainnya
+            if (slot < 0) return false;
             
-            char* token = strtok(line, "|");
-            strcpy(t.id, token);
+            vector<char> payload;
+            if (!readCheckpointFile(checkpointFiles[slot], header, payload) ||
+                header.legacySize != legacyTransactionSize() ||
+                header.lsn > transactionLog.endLsn() ||
+                header.lsn < transactionLog.getBaseLsn()) {
+                continue;
+            }
+            
+            CheckpointReader reader(payload.data(), payload.data() + payload.size());
+            AccountRecord rec;
+            for (uint64_t i = 0; i < header.accountCount; i++) {
+                getAccount(reader, rec);
+            }
             
-            token = strtok(NULL, "|");
-            strcpy(t.timestamp, token);
+            vector<Transaksi> rows(header.transactionCount);
+            vector<const Transaksi*> sorted(header.transactionCount);
+            for (uint64_t i = 0; i < header.transactionCount; i++) {
+                getTransaksi(reader, rows[i]);
+                sorted[i] = &rows[i];
+            }
             
-            token = strtok(NULL, "|");
-            strcpy(t.jenis, token);
+            vector<RefundRequest> refunds(header.refundCount);
+            for (uint64_t i = 0; i < header.refundCount; i++) {
+                getRefund(reader, refunds[i]);
+            }
             
-            token = strtok(NULL, "|");
-            strcpy(t.dari, token);
+            vector<CSTicket> tickets(header.ticketCount);
+            for (uint64_t i = 0; i < header.ticketCount; i++) {
+                getTicket(reader, tickets[i]);
+            }
             
-            token = strtok(NULL, "|");
-            strcpy(t.ke, token);
+            if (!reader.ok()) continue;
             
-            token = strtok(NULL, "|");
-            t.jumlah = atof(token);
+            transactionIndex.buildFromSorted(sorted.data(), (int)sorted.size());
             
-            token = strtok(NULL, "|");
-            if (token) strcpy(t.keterangan, token);
+            // Stack disimpan dari atas -> push ulang dari bawah
+            for (size_t i = refunds.size(); i > 0; i--) {
+                refundStack.push(refunds[i - 1]);
+            }
+            for (size_t i = 0; i < tickets.size(); i++) {
+                csQueue.enqueue(tickets[i]);
+            }
             
-            avlTree.insert(t);
+            lsn = header.lsn;
+            return true;
+        }
+        return false;
+    }
+    
+    /*
+     * Bangun ulang users.dat dari image akun di checkpoint terbaru.
+     * Sama seperti convertUsersText: ditulis ke users.dat.tmp, image
+     * divalidasi dan di-flush, baru di-rename -> crash di tengah restore
+     * tidak pernah meninggalkan users.dat dengan record kosong.
+     */
+    bool restoreAccountsFromCheckpoint() {
+        CheckpointHeader header;
+        int slot = newestCheckpoint(header);
+        vector<char> payload;
+        if (slot < 0 || !readCheckpointFile(checkpointFiles[slot], header, payload)) {
+            return false;
         }
         
-        file.close();
+        char tmpPath[260];
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", accountFile);
+        
+        AccountStore store;
+        if (!store.create(tmpPath, header.accountCount) ||
+            !store.setCount(header.accountCount)) {
+            store.close();
+            remove(tmpPath);
+            return false;
+        }
+        
+        CheckpointReader reader(payload.data(), payload.data() + payload.size());
+        for (uint64_t i = 0; i < header.accountCount; i++) {
+            getAccount(reader, *store.record(i));
+        }
+        
+        bool ok = reader.ok() && store.syncAll();
+        store.close();
+        if (!ok) {
+            cout << "Error: Image akun di checkpoint rusak, users.dat tidak dipulihkan\n";
+            remove(tmpPath);
+            return false;
+        }
+        
+        remove(accountFile);
+        if (rename(tmpPath, accountFile) != 0) {
+            cout << "Error: Tidak bisa menyimpan users.dat\n";
+            return false;
+        }
+        cout << "[INFO] users.dat dipulihkan dari checkpoint.\n";
+        return true;
     }
     
-    void saveUsers(User* users, int count) {
-        ofstream file(userFile);
-        if (!file.is_open()) {
-            cout << "Error: Tidak bisa menyimpan data users\n";
-            return;
+    // =================================================================
+    // ARSIP KOLOM (transactions.col)
+    // =================================================================
+    /*
+     * transactions.txt sudah tertutup (transaksi baru masuk ke WAL), jadi
+     * isinya diarsipkan sekali ke format kolom. Arsip dibangun ulang hanya
+     * jika belum ada atau ukuran transactions.txt berubah.
+     */
+    bool buildArchive() {
+        vector< vector<Transaksi> > rows;
+        if (!parseLegacyTransactions(rows)) {
+            return false;
         }
         
-        for (int i = 0; i < count; i++) {
-            KTP ktp = users[i].getKTP();
-            file << users[i].getUsername() << "|"
-                 << users[i].getPassword() << "|"
-                 << users[i].getPIN() << "|"
-                 << users[i].getSaldo() << "|"
-                 << ktp.nik << "|" << ktp.namaLengkap << "|"
-                 << ktp.alamat << "|" << ktp.tanggalLahir << "\n";
+        vector<const Transaksi*> ordered;
+        for (size_t c = 0; c < rows.size(); c++) {
+            for (size_t i = 0; i < rows[c].size(); i++) {
+                ordered.push_back(&rows[c][i]);
+            }
         }
         
+        ColumnarWriter writer;
+        if (!writer.write(archiveFile, ordered.data(), ordered.size(), legacyTransactionSize())) {
+            cout << "Error: Tidak bisa menulis " << archiveFile << "\n";
+            return false;
+        }
+        return true;
+    }
+    
+    // Arsip kolom siap baca (NULL jika transactions.txt tidak ada)
+    const ColumnarArchive* getArchive() {
+        uint64_t sourceSize = legacyTransactionSize();
+        if (archive.isOpen() && archive.sourceSize() == sourceSize) {
+            return &archive;
+        }
+        
+        if (!archive.open(archiveFile) || archive.sourceSize() != sourceSize) {
+            archive.close();
+            if (!buildArchive() || !archive.open(archiveFile)) {
+                return NULL;
+            }
+        }
+        return &archive;
+    }
+    
+    // =================================================================
+    // KOMPRESI RIWAYAT DINGIN (.hz)
+    // =================================================================
+    /*
+     * transactions.txt dan segmen log lama tidak pernah berubah lagi,
+     * jadi boleh disimpan terkompresi (block_compressor.h). Loader, arsip
+     * kolom dan checkpoint tetap membacanya lewat file .hz.
+     */
+    bool hasTransactionText() {
+        ifstream file(transactionFile, ios::binary);
+        return file.is_open();
+    }
+    
+    /*
+     * transactions.txt -> transactions.txt.hz. File teks dihapus hanya
+     * setelah setiap blok hasil kompresi di-decode dan sama persis.
+     */
+    bool compressTransactionFile(BlockCompressStats& stats) {
+        char packedPath[260];
+        packedTransactionFile(packedPath, sizeof(packedPath));
+        
+        MappedFile file;
+        if (!file.open(transactionFile)) {
+            return false;
+        }
+        if (!compressToFile(file.data(), file.size(), packedPath, true, stats)) {
+            cout << "Error: Tidak bisa menulis " << packedPath << "\n";
+            return false;
+        }
+        
+        BlockFileReader reader;
+        atomic<bool> same(reader.open(packedPath) && reader.originalSize() == file.size());
+        if (same) {
+            parallelFor((int)reader.blockCount(), [&](int b) {
+                vector<char> text;
+                const BlockIndexEntry& e = reader.block(b);
+                if (!reader.readBlock(b, text) ||
+                    memcmp(text.data(), file.data() + e.originalOffset, text.size()) != 0) {
+                    same = false;
+                }
+            });
+        }
+        reader.close();
         file.close();
+        
+        if (!same) {
+            cout << "Error: Verifikasi " << packedPath << " gagal, file asli dipertahankan\n";
+            remove(packedPath);
+            return false;
+        }
+        remove(transactionFile);
+        return true;
     }
     
-    void appendTransaction(const Transaksi& t) {
-        ofstream file(transactionFile, ios::app);
-        if (!file.is_open()) {
-            cout << "Error: Tidak bisa menyimpan transaksi\n";
+    // Segmen log lama -> segment.*.col.hz. Return jumlah segmen.
+    int compressColdSegments(BlockCompressStats& stats) {
+        if (!openLog()) return 0;
+        return segmentCatalog.compressCold(SEGMENT_HOT_COUNT, stats);
+    }
+    
+    int segmentCount() {
+        openLog();
+        return segmentCatalog.count();
+    }
+    
+    // =================================================================
+    // SEGMEN LOG
+    // =================================================================
+    /*
+     * Segel WAL aktif menjadi segmen jika ukurannya melewati batas atau
+     * transaksi pertamanya berasal dari hari sebelumnya. Dipanggil hanya
+     * setelah checkpoint, sehingga checkpoint selalu mencakup semua
+     * segmen dan startup cukup me-replay WAL aktif.
+     */
+    bool rollLogIfDue() {
+        if (!openLog()) return false;
+        
+        uint64_t fromLsn = unsealedLsn();
+        uint64_t endLsn = transactionLog.endLsn();
+        if (endLsn <= fromLsn) return false;
+        
+        const WalTail& tail = unsealedTail();
+        endLsn = tail.getEndLsn();
+        
+        bool sizeDue = endLsn - fromLsn >= SEGMENT_MAX_BYTES;
+        bool dayDue = false;
+        if (tail.size() > 0) {
+            dayDue = tail.at(0).waktu / 86400 < currentLocalEpoch() / 86400;
+        }
+        if (!sizeDue && !dayDue) return false;
+        
+        vector<const Transaksi*> ordered(tail.size());
+        for (size_t i = 0; i < tail.size(); i++) {
+            ordered[i] = &tail.at(i);
+        }
+        if (!segmentCatalog.seal(ordered.data(), ordered.size(), fromLsn, endLsn)) {
+            return false;
+        }
+        return transactionLog.rollover(endLsn);
+    }
+    
+    // Arsip lama (transactions.col) + semua segmen, urut dari terlama
+    void collectArchives(vector<const ColumnarArchive*>& archives) {
+        openLog();
+        archives.clear();
+        const ColumnarArchive* legacy = getArchive();
+        if (legacy != NULL) archives.push_back(legacy);
+        for (int i = 0; i < segmentCatalog.count(); i++) {
+            archives.push_back(&segmentCatalog.segment(i));
+        }
+    }
+    
+    int getSegmentCount() {
+        openLog();
+        return segmentCatalog.count();
+    }
+    
+    // Transaksi WAL aktif yang belum tersegel: hanya record baru yang di-parse
+    const WalTail& unsealedTail() {
+        if (!openLog()) {
+            walTail.reset(0);
+            return walTail;
+        }
+        
+        uint64_t fromLsn = unsealedLsn();
+        if (walTail.getBaseLsn() != fromLsn) {
+            walTail.reset(fromLsn);
+        }
+        if (transactionLog.endLsn() > walTail.getEndLsn()) {
+            vector<Transaksi> parsed;
+            transactionLog.replay(walTail.getEndLsn(), [&](char* payload, uint32_t len, uint64_t lsn) {
+                parsed.clear();
+                parseTransactionChunk(payload, payload + len, parsed);
+                for (size_t i = 0; i < parsed.size(); i++) {
+                    walTail.add(parsed[i]);
+                }
+                walTail.advance(lsn);
+            });
+        }
+        return walTail;
+    }
+    
+    // Transaksi dengan waktu di [from, to]: segmen + WAL aktif
+    template <typename Fn>
+    void queryTimeRange(int64_t from, int64_t to, SegmentScanStats& stats, Fn fn) {
+        vector<const ColumnarArchive*> archives;
+        collectArchives(archives);
+        
+        Transaksi t;
+        scanTimeRange(archives, from, to, stats, [&](const ColumnarArchive& a, uint64_t row) {
+            a.row(row, t);
+            fn(t);
+        });
+        
+        const WalTail& tail = unsealedTail();
+        stats.segments++;
+        if (!tail.overlapsTime(from, to)) {
+            stats.skipped++;
             return;
         }
+        stats.rowsScanned += tail.size();
+        for (size_t i = 0; i < tail.size(); i++) {
+            if (tail.at(i).waktu >= from && tail.at(i).waktu <= to) {
+                stats.matches++;
+                fn(tail.at(i));
+            }
+        }
+    }
+    
+    // Transaksi dengan jumlah di [minVal, maxVal]: segmen + WAL aktif
+    template <typename Fn>
+    void queryAmountRange(double minVal, double maxVal, SegmentScanStats& stats, Fn fn) {
+        vector<const ColumnarArchive*> archives;
+        collectArchives(archives);
         
-        file << t.id << "|" << t.timestamp << "|" << t.jenis << "|"
-             << t.dari << "|" << t.ke << "|" << t.jumlah << "|"
-             << t.keterangan << "\n";
+        Transaksi t;
+        scanAmountRange(archives, minVal, maxVal, stats, [&](const ColumnarArchive& a, uint64_t row) {
+            a.row(row, t);
+            fn(t);
+        });
         
+        const WalTail& tail = unsealedTail();
+        stats.segments++;
+        if (!tail.overlapsAmount(minVal, maxVal)) {
+            stats.skipped++;
+            return;
+        }
+        stats.rowsScanned += tail.size();
+        for (size_t i = 0; i < tail.size(); i++) {
+            if (tail.at(i).jumlah >= minVal && tail.at(i).jumlah <= maxVal) {
+                stats.matches++;
+                fn(tail.at(i));
+            }
+        }
+    }
+    
+    // Cari 1 transaksi berdasarkan ID: WAL aktif dulu, lalu segmen terbaru
+    bool findTransaction(const char* id, Transaksi& out, SegmentScanStats& stats) {
+        const Transaksi* found = unsealedTail().find(id);
+        stats.segments++;
+        if (found != NULL) {
+            out = *found;
+            stats.matches++;
+            return true;
+        }
+        
+        vector<const ColumnarArchive*> archives;
+        collectArchives(archives);
+        return findInArchives(archives, id, out, stats);
+    }
+    
+    // Atur commit window group commit WAL (mikrodetik)
+    void setLogCommitWindow(long microseconds) {
+        transactionLog.setCommitWindow(microseconds);
+    }
+    
+    // =================================================================
+    // EKSPOR LAPORAN
+    // =================================================================
+    /*
+     * Ekspor transaksi dengan jumlah di [min, max] (urut jumlah) ke file
+     * teks berformat transactions.txt. Baris diambil lewat cursor index
+     * dan dikumpulkan di buffer 1 MB -> file ditulis per blok, bukan per
+     * baris. Return jumlah baris, -1 jika gagal.
+     */
+    long long exportTransactions(const TransactionIndex& index, double min, double max,
+                                 const char* path) {
+        ofstream file(path, ios::binary);
+        if (!file.is_open()) {
+            cout << "Error: Tidak bisa membuat file " << path << "\n";
+            return -1;
+        }
+        
+        vector<char> buffer(EXPORT_BUFFER_SIZE);
+        size_t used = 0;
+        PageToken token(min, 0);
+        bool hasMore;
+        size_t rows = visitPage(index, max, token, 0, hasMore, [&](const TransaksiRecord& t) {
+            if (used + 512 > buffer.size()) {
+                file.write(buffer.data(), used);
+                used = 0;
+            }
+            used += formatTransactionLine(t, buffer.data() + used, 511);
+            buffer[used++] = '\n';
+        });
+        file.write(buffer.data(), used);
         file.close();
+        
+        if (file.fail()) {
+            cout << "Error: Gagal menulis " << path << "\n";
+            return -1;
+        }
+        return (long long)rows;
     }
 };
 
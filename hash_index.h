@@ -0,0 +1,136 @@
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+#include <cstdint>
+#include <vector>
+#include <string_view>
+
+using namespace std;
+
+// =================================================================
+// HASH INDEX - Index Hash Open Addressing (Linear Probing)
+// =================================================================
+/*
+ * Index dari key string ke value kecil (biasanya index/slot array).
+ *
+ * KONSEP:
+ * - Setiap slot hanya menyimpan fingerprint hash (32-bit) + value.
+ *   Key TIDAK disalin: key diambil dari data aslinya lewat KeyOf,
+ *   yaitu functor keyOf(value) -> string_view.
+ * - Posisi awal = hash & (kapasitas - 1), jika terisi geser ke slot
+ *   berikutnya (linear probing) -> akses memori berurutan, ramah cache
+ * - Key hanya dibandingkan jika fingerprint cocok
+ * - Kapasitas pangkat 2, diperbesar 2x jika load factor > 0.7
+ *
+ * KOMPLEKSITAS: insert & find rata-rata O(1), tidak tergantung jumlah data
+ */
+
+// Hash 64-bit FNV-1a
+inline uint64_t hashBytes(string_view s) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < s.size(); i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+template <typename Value, typename KeyOf>
+class HashIndex {
+private:
+    struct Slot {
+        uint32_t tag;       // Fingerprint hash, 0 = slot kosong
+        Value value;
+    };
+
+    vector<Slot> slots;
+    size_t used;
+    KeyOf keyOf;
+
+    static uint32_t tagOf(uint64_t hash) {
+        uint32_t tag = (uint32_t)(hash >> 32);
+        return tag == 0 ? 1 : tag;
+    }
+
+    void placeNew(uint64_t hash, const Value& value) {
+        size_t mask = slots.size() - 1;
+        size_t i = (size_t)hash & mask;
+        while (slots[i].tag != 0) i = (i + 1) & mask;
+        slots[i].tag = tagOf(hash);
+        slots[i].value = value;
+    }
+
+    void rehash(size_t capacity) {
+        vector<Slot> old;
+        old.swap(slots);
+        slots.assign(capacity, Slot());
+        for (size_t i = 0; i < old.size(); i++) {
+            if (old[i].tag != 0) {
+                placeNew(hashBytes(keyOf(old[i].value)), old[i].value);
+            }
+        }
+    }
+
+public:
+    explicit HashIndex(KeyOf accessor = KeyOf()) : used(0), keyOf(accessor) {}
+
+    void clear() {
+        slots.clear();
+        used = 0;
+    }
+
+    // Siapkan kapasitas untuk n entry tanpa rehash berulang
+    void reserve(size_t n) {
+        size_t capacity = 16;
+        while (capacity * 7 < n * 10) capacity *= 2;
+        if (capacity > slots.size()) rehash(capacity);
+    }
+
+    // Tambah value; false jika key-nya sudah ada
+    bool insert(const Value& value) {
+        if (slots.empty() || (used + 1) * 10 > slots.size() * 7) {
+            rehash(slots.empty() ? 16 : slots.size() * 2);
+        }
+
+        string_view key = keyOf(value);
+        uint64_t hash = hashBytes(key);
+        uint32_t tag = tagOf(hash);
+        size_t mask = slots.size() - 1;
+
+        size_t i = (size_t)hash & mask;
+        while (slots[i].tag != 0) {
+            if (slots[i].tag == tag && keyOf(slots[i].value) == key) return false;
+            i = (i + 1) & mask;
+        }
+        slots[i].tag = tag;
+        slots[i].value = value;
+        used++;
+        return true;
+    }
+
+    // Cari value dengan key tertentu, NULL jika tidak ada
+    const Value* find(string_view key) const {
+        if (slots.empty()) return NULL;
+
+        uint64_t hash = hashBytes(key);
+        uint32_t tag = tagOf(hash);
+        size_t mask = slots.size() - 1;
+
+        for (size_t i = (size_t)hash & mask; slots[i].tag != 0; i = (i + 1) & mask) {
+            if (slots[i].tag == tag && keyOf(slots[i].value) == key) {
+                return &slots[i].value;
+            }
+        }
+        return NULL;
+    }
+
+    // Versi non-const: value boleh diganti (key harus tetap sama)
+    Value* find(string_view key) {
+        return const_cast<Value*>(static_cast<const HashIndex*>(this)->find(key));
+    }
+
+    size_t size() const { return used; }
+    size_t capacity() const { return slots.size(); }
+};
+
+#endif
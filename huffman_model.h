@@ -0,0 +1,242 @@
+#ifndef HUFFMAN_MODEL_H
+#define HUFFMAN_MODEL_H
+
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "canonical_huffman.h"
+
+using namespace std;
+
+// =================================================================
+// HUFFMAN MODEL - Model Huffman Bersama untuk Keterangan Transaksi
+// =================================================================
+/*
+ * SEBELUMNYA: setiap top up / transfer membangun HuffmanCoding baru
+ * (heap + pohon) dari 1 keterangan ~25 byte. Ratusan alokasi per
+ * transaksi, dan tabel kode yang ikut disimpan lebih besar dari
+ * penghematannya (hasil "kompresi" > teks asli).
+ *
+ * KONSEP:
+ * - 1 model (panjang kode kanonik + tabel decode) dilatih sekali saat
+ *   load dari semua keterangan, lalu dipakai bersama read-only
+ * - Semua byte 1..255 tetap punya kode (frekuensi +1) -> teks apa pun
+ *   bisa di-encode tanpa melatih ulang
+ * - Encode = lookup panjang & kode per karakter, tanpa alokasi node
+ * - Stream: [versi model: varint][panjang teks: varint][bit kode]
+ *   -> tanpa tabel; decode memakai model sesuai versi di stream
+ *
+ * VERSI & LATIH ULANG:
+ * - Model tidak pernah diubah setelah diterbitkan; model baru = versi
+ *   baru. Semua versi tetap hidup (maks. 64) agar stream lama tetap
+ *   bisa di-decode.
+ * - Frekuensi keterangan baru dihitung tanpa lock. Thread latar
+ *   belakang memeriksa secara berkala: jika bit dengan model aktif
+ *   > 3% lebih boros dari model yang dilatih dari teks baru itu, model
+ *   baru diterbitkan dengan 1 atomic store (pembaca tidak menunggu).
+ */
+const uint32_t HUFFMAN_MODEL_MAX_VERSIONS = 64;
+const double HUFFMAN_RETRAIN_GAIN = 0.03;           // Latih ulang jika >= 3% lebih hemat
+const uint64_t HUFFMAN_RETRAIN_MIN_BYTES = 4096;    // Minimal teks baru sebelum dinilai
+const int HUFFMAN_RETRAIN_INTERVAL_SECONDS = 30;
+
+class HuffmanModel {
+private:
+    uint32_t version;
+    uint64_t trainedBytes;
+    CanonicalHuffman code;
+    HuffmanDecoder decoder;
+
+public:
+    HuffmanModel(uint32_t modelVersion, const uint64_t* frequencies) : version(modelVersion), trainedBytes(0) {
+        uint64_t freq[256];
+        for (int s = 0; s < 256; s++) {
+            trainedBytes += frequencies[s];
+            freq[s] = s == 0 ? 0 : frequencies[s] + 1;
+        }
+        code.buildFromFrequencies(freq);
+        decoder.init(code);
+    }
+
+    uint32_t getVersion() const { return version; }
+    uint64_t getTrainedBytes() const { return trainedBytes; }
+    const CanonicalHuffman& getCode() const { return code; }
+
+    // Total bit kode untuk teks dengan frekuensi tertentu
+    uint64_t costBits(const uint64_t* frequencies) const {
+        uint64_t bits = 0;
+        for (int s = 0; s < 256; s++) {
+            bits += frequencies[s] * code.length[s];
+        }
+        return bits;
+    }
+
+    // Stream [versi][panjang][bit]. Return jumlah byte yang ditulis.
+    size_t encode(const char* text, size_t n, vector<uint8_t>& out) const {
+        size_t start = out.size();
+        putVarint(out, version);
+        putVarint(out, n);
+        BitWriter writer(out);
+        code.encodeBits(text, n, writer);
+        writer.flush();
+        return out.size() - start;
+    }
+
+    // Decode bagian [panjang][bit] (versi sudah dibaca). out diisi teks + '\0'.
+    bool decodeBody(const uint8_t* p, const uint8_t* end, char* out, size_t outSize) const {
+        uint64_t n;
+        if (!getVarint(p, end, n) || n >= outSize) return false;
+        if (!decoder.decode(p, end - p, (size_t)n, out)) return false;
+        out[n] = '\0';
+        return true;
+    }
+};
+
+class HuffmanModelRegistry {
+private:
+    atomic<const HuffmanModel*> models[HUFFMAN_MODEL_MAX_VERSIONS + 1];   // Index = versi
+    atomic<const HuffmanModel*> active;
+    atomic<uint32_t> published;
+    atomic<uint64_t> recent[256];   // Frekuensi teks sejak penilaian terakhir
+
+    mutex mtx;                      // Menerbitkan model & thread latar belakang
+    condition_variable cv;
+    thread trainer;
+    bool stopping;
+
+    HuffmanModelRegistry(const HuffmanModelRegistry&);
+    HuffmanModelRegistry& operator=(const HuffmanModelRegistry&);
+
+    void trainerLoop(int intervalSeconds) {
+        unique_lock<mutex> lock(mtx);
+        while (!stopping) {
+            cv.wait_for(lock, chrono::seconds(intervalSeconds));
+            if (stopping) break;
+            lock.unlock();
+            retrainIfDrifted();
+            lock.lock();
+        }
+    }
+
+public:
+    HuffmanModelRegistry() : active(NULL), published(0), stopping(false) {
+        for (uint32_t v = 0; v <= HUFFMAN_MODEL_MAX_VERSIONS; v++) models[v].store(NULL);
+        for (int s = 0; s < 256; s++) recent[s].store(0);
+
+        // Versi 1: model awal (semua byte sama) sampai dilatih dari data
+        uint64_t uniform[256] = {0};
+        train(uniform);
+    }
+
+    ~HuffmanModelRegistry() {
+        stopBackground();
+        for (uint32_t v = 0; v <= HUFFMAN_MODEL_MAX_VERSIONS; v++) delete models[v].load();
+    }
+
+    /*
+     * Latih & terbitkan model baru dari frekuensi byte. Return versinya,
+     * atau 0 jika batas versi tercapai (model aktif tetap dipakai).
+     */
+    uint32_t train(const uint64_t* frequencies) {
+        lock_guard<mutex> lock(mtx);
+        uint32_t version = published.load(memory_order_relaxed) + 1;
+        if (version > HUFFMAN_MODEL_MAX_VERSIONS) return 0;
+
+        const HuffmanModel* model = new HuffmanModel(version, frequencies);
+        models[version].store(model, memory_order_release);
+        published.store(version, memory_order_release);
+        active.store(model, memory_order_release);
+        return version;
+    }
+
+    const HuffmanModel& current() const {
+        return *active.load(memory_order_acquire);
+    }
+
+    // Model versi tertentu, NULL jika tidak ada
+    const HuffmanModel* model(uint64_t version) const {
+        if (version == 0 || version > HUFFMAN_MODEL_MAX_VERSIONS) return NULL;
+        return models[version].load(memory_order_acquire);
+    }
+
+    uint32_t versionCount() const { return published.load(memory_order_acquire); }
+
+    /*
+     * Catat frekuensi teks baru (untuk deteksi pergeseran isi keterangan).
+     * Load + store biasa, bukan fetch_add: hanya statistik, tambahan yang
+     * hilang karena 2 thread bersamaan tidak masalah.
+     */
+    void observe(const char* text, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            atomic<uint64_t>& c = recent[(unsigned char)text[i]];
+            c.store(c.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        }
+    }
+
+    // Encode dengan model aktif + catat frekuensinya. Return jumlah byte.
+    size_t encode(const char* text, vector<uint8_t>& out) {
+        size_t n = strlen(text);
+        observe(text, n);
+        return current().encode(text, n, out);
+    }
+
+    // Decode stream dari encode() dengan model sesuai versinya
+    bool decode(const uint8_t* data, size_t size, char* out, size_t outSize) const {
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        uint64_t version;
+        if (!getVarint(p, end, version)) return false;
+        const HuffmanModel* m = model(version);
+        return m != NULL && m->decodeBody(p, end, out, outSize);
+    }
+
+    /*
+     * Nilai teks sejak penilaian terakhir (minimal 4 KB): terbitkan model
+     * baru jika model aktif >= 3% lebih boros. Return true jika dilatih ulang.
+     */
+    bool retrainIfDrifted() {
+        uint64_t total = 0;
+        for (int s = 0; s < 256; s++) total += recent[s].load(memory_order_relaxed);
+        if (total < HUFFMAN_RETRAIN_MIN_BYTES) return false;
+
+        uint64_t freq[256];
+        for (int s = 0; s < 256; s++) freq[s] = recent[s].exchange(0, memory_order_relaxed);
+
+        HuffmanModel fresh(0, freq);
+        uint64_t activeBits = current().costBits(freq);
+        uint64_t freshBits = fresh.costBits(freq);
+        if (activeBits < freshBits * (1.0 + HUFFMAN_RETRAIN_GAIN)) return false;
+        return train(freq) != 0;
+    }
+
+    // Thread latar belakang: retrainIfDrifted() setiap intervalSeconds
+    void startBackground(int intervalSeconds = HUFFMAN_RETRAIN_INTERVAL_SECONDS) {
+        lock_guard<mutex> lock(mtx);
+        if (trainer.joinable()) return;
+        stopping = false;
+        trainer = thread(&HuffmanModelRegistry::trainerLoop, this, intervalSeconds);
+    }
+
+    void stopBackground() {
+        {
+            lock_guard<mutex> lock(mtx);
+            if (!trainer.joinable()) return;
+            stopping = true;
+        }
+        cv.notify_all();
+        trainer.join();
+    }
+};
+
+// Model keterangan bersama untuk seluruh program (inisialisasi thread-safe)
+inline HuffmanModelRegistry& keteranganModels() {
+    static HuffmanModelRegistry registry;
+    return registry;
+}
+
+#endif
@@ -0,0 +1,358 @@
+#ifndef LOG_SEGMENTS_H
+#define LOG_SEGMENTS_H
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include "data_structures.h"
+#include "columnar_archive.h"
+#include "hash_index.h"
+
+using namespace std;
+
+// =================================================================
+// LOG SEGMENTS - Segmen Log Transaksi per Waktu / Ukuran
+// =================================================================
+/*
+ * Log transaksi tidak lagi tumbuh sebagai 1 file selamanya:
+ * - WAL aktif ditutup (sealed) menjadi segmen jika sudah melewati
+ *   batas ukuran, atau jika transaksi pertamanya dari hari sebelumnya
+ * - Segmen disimpan dalam format kolom (columnar_archive.h) dengan nama
+ *   segment.<baseLsn>.col, lalu WAL diganti file baru (rollover)
+ * - Daftar segmen disimpan di segments.idx (1 nama file per baris)
+ *
+ * ZONE MAP:
+ * Footer setiap segmen berisi min/max waktu, min/max jumlah, jumlah
+ * baris dan bloom filter ID. Query rentang waktu/jumlah dan pencarian
+ * ID melewati segmen yang pasti tidak cocok tanpa membaca kolomnya.
+ *
+ * URUTAN SEAL (aman terhadap crash):
+ * 1. Tulis file segmen (tmp + rename)
+ * 2. Tulis ulang segments.idx (tmp + rename)
+ * 3. Rollover WAL
+ * Crash sebelum langkah 2: segmen yatim diabaikan, record masih di WAL.
+ * Crash sebelum langkah 3: record WAL sebelum endLsn segmen dilewati.
+ *
+ * EKOR WAL:
+ * Transaksi WAL aktif yang belum tersegel di-cache di WalTail beserta
+ * zone map dan hash index ID-nya, sehingga query hanya mem-parse record
+ * WAL yang baru ditambahkan sejak query sebelumnya.
+ *
+ * SEGMEN DINGIN:
+ * Segmen lama bisa dikompresi per blok (block_compressor.h) menjadi
+ * segment.<baseLsn>.col.hz; file .col dihapus setelah hasilnya
+ * terverifikasi. segments.idx tidak berubah: ColumnarArchive::open
+ * membaca .hz jika .col tidak ada.
+ */
+const uint64_t SEGMENT_MAX_BYTES = 4 * 1024 * 1024;   // Batas ukuran WAL aktif
+const int SEGMENT_HOT_COUNT = 2;                       // Segmen terbaru yang tidak dikompresi
+
+// Statistik 1 query: berapa segmen dilewati berkat zone map / bloom
+struct SegmentScanStats {
+    int segments;
+    int skipped;
+    uint64_t rowsScanned;
+    uint64_t matches;
+
+    SegmentScanStats() : segments(0), skipped(0), rowsScanned(0), matches(0) {}
+};
+
+class SegmentCatalog {
+private:
+    const char* manifestFile;
+    vector<ColumnarArchive*> segments;
+
+    bool writeManifest() {
+        char tmpPath[260];
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", manifestFile);
+
+        ofstream file(tmpPath);
+        if (!file.is_open()) return false;
+        for (size_t i = 0; i < segments.size(); i++) {
+            char name[64];
+            segmentName(segments[i]->footer().baseLsn, name, sizeof(name));
+            file << name << "\n";
+        }
+        file.close();
+        if (file.fail()) return false;
+
+        remove(manifestFile);
+        return rename(tmpPath, manifestFile) == 0;
+    }
+
+public:
+    SegmentCatalog() : manifestFile("segments.idx") {}
+
+    ~SegmentCatalog() {
+        for (size_t i = 0; i < segments.size(); i++) {
+            delete segments[i];
+        }
+    }
+
+    static void segmentName(uint64_t baseLsn, char* out, size_t size) {
+        snprintf(out, size, "segment.%016llu.col", (unsigned long long)baseLsn);
+    }
+
+    // Buka semua segmen yang terdaftar di segments.idx
+    int load() {
+        ifstream file(manifestFile);
+        if (!file.is_open()) return 0;
+
+        char line[260];
+        while (file.getline(line, sizeof(line))) {
+            size_t len = strlen(line);
+            if (len > 0 && line[len - 1] == '\r') line[--len] = '\0';
+            if (len == 0) continue;
+
+            ColumnarArchive* segment = new ColumnarArchive();
+            if (!segment->open(line)) {
+                cout << "Error: Segmen " << line << " tidak bisa dibuka\n";
+                delete segment;
+                continue;
+            }
+            segments.push_back(segment);
+        }
+        return (int)segments.size();
+    }
+
+    int count() const { return (int)segments.size(); }
+    const ColumnarArchive& segment(int i) const { return *segments[i]; }
+
+    // LSN akhir segmen terakhir (record WAL sebelum ini sudah tersegel)
+    uint64_t endLsn() const {
+        return segments.empty() ? 0 : segments.back()->footer().endLsn;
+    }
+
+    // Segel transaksi [baseLsn, endLsn) menjadi segmen baru
+    bool seal(const Transaksi* const* rows, size_t rowCount, uint64_t baseLsn, uint64_t endLsn) {
+        char name[64];
+        segmentName(baseLsn, name, sizeof(name));
+
+        ColumnarWriter writer;
+        if (!writer.write(name, rows, rowCount, endLsn - baseLsn, baseLsn, endLsn)) {
+            cout << "Error: Tidak bisa menulis segmen " << name << "\n";
+            return false;
+        }
+
+        ColumnarArchive* segment = new ColumnarArchive();
+        if (!segment->open(name)) {
+            delete segment;
+            return false;
+        }
+        segments.push_back(segment);
+
+        if (!writeManifest()) {
+            cout << "Error: Tidak bisa memperbarui " << manifestFile << "\n";
+            delete segments.back();
+            segments.pop_back();
+            return false;
+        }
+        return true;
+    }
+
+    /*
+     * Kompresi semua segmen kecuali keepHot segmen terbaru. Return jumlah
+     * segmen yang dikompresi; ukurannya ditambahkan ke total.
+     */
+    int compressCold(int keepHot, BlockCompressStats& total) {
+        int compressed = 0;
+        for (int i = 0; i + keepHot < (int)segments.size(); i++) {
+            ColumnarArchive* segment = segments[i];
+            if (segment->isCompressed()) continue;
+
+            char name[64], packedName[80];
+            segmentName(segment->footer().baseLsn, name, sizeof(name));
+            snprintf(packedName, sizeof(packedName), "%s%s", name, BLOCK_FILE_SUFFIX);
+
+            // Verifikasi sebelum .col dihapus: readAll gagal jika CRC salah
+            // satu blok tidak cocok, lalu hasil decode dibandingkan byte per
+            // byte dengan segmen asli yang masih di-mmap
+            BlockCompressStats stats;
+            BlockFileReader check;
+            vector<char> text;
+            if (!compressFile(name, packedName, false, stats) ||
+                !check.open(packedName) || !check.readAll(text) ||
+                text.size() != segment->byteSize() ||
+                memcmp(text.data(), segment->data(), text.size()) != 0) {
+                cout << "Error: Tidak bisa mengkompresi segmen " << name << "\n";
+                check.close();
+                remove(packedName);
+                continue;
+            }
+            check.close();
+
+            // Tutup mmap dulu (Windows tidak bisa menghapus file yang di-map)
+            segment->close();
+            remove(name);
+            if (!segment->open(name)) {
+                cout << "Error: Segmen " << packedName << " tidak bisa dibuka\n";
+                continue;
+            }
+            total.originalBytes += stats.originalBytes;
+            total.compressedBytes += stats.compressedBytes;
+            total.blocks += stats.blocks;
+            total.rawBlocks += stats.rawBlocks;
+            compressed++;
+        }
+        return compressed;
+    }
+};
+
+// =================================================================
+// WAL TAIL - Cache Transaksi WAL yang Belum Tersegel
+// =================================================================
+/*
+ * SEBELUMNYA: setiap query (cari ID, rentang waktu/jumlah) me-replay dan
+ * mem-parse ulang seluruh WAL aktif -> O(ukuran WAL) per query.
+ *
+ * SEKARANG: baris yang sudah di-parse disimpan bersama LSN akhirnya.
+ * Query berikutnya hanya me-replay record setelah LSN itu. Seperti
+ * footer segmen, cache menyimpan zone map (min/max waktu & jumlah) dan
+ * index ID -> baris (hash_index.h). Jika LSN awal WAL berubah (seal +
+ * rollover), cache dikosongkan dan dibangun ulang.
+ */
+class WalTail;
+
+struct WalTailIdOf {
+    const WalTail* tail;
+
+    string_view operator()(uint32_t row) const;
+};
+
+class WalTail {
+private:
+    vector<Transaksi> rows;
+    HashIndex<uint32_t, WalTailIdOf> ids;
+    uint64_t baseLsn;           // LSN record pertama yang di-cache
+    uint64_t endLsn;            // LSN setelah record terakhir yang di-parse
+    int64_t minWaktu, maxWaktu;
+    double minJumlah, maxJumlah;
+
+    WalTail(const WalTail&);
+    WalTail& operator=(const WalTail&);
+
+public:
+    WalTail() : ids(WalTailIdOf{this}) {
+        reset(0);
+    }
+
+    void reset(uint64_t lsn) {
+        rows.clear();
+        ids.clear();
+        baseLsn = endLsn = lsn;
+        minWaktu = maxWaktu = 0;
+        minJumlah = maxJumlah = 0;
+    }
+
+    uint64_t getBaseLsn() const { return baseLsn; }
+    uint64_t getEndLsn() const { return endLsn; }
+    size_t size() const { return rows.size(); }
+    const Transaksi& at(size_t i) const { return rows[i]; }
+
+    // Tambah 1 baris; ID yang sama menunjuk ke baris terbaru
+    void add(const Transaksi& t) {
+        if (rows.empty()) {
+            minWaktu = maxWaktu = t.waktu;
+            minJumlah = maxJumlah = t.jumlah;
+        } else {
+            if (t.waktu < minWaktu) minWaktu = t.waktu;
+            if (t.waktu > maxWaktu) maxWaktu = t.waktu;
+            if (t.jumlah < minJumlah) minJumlah = t.jumlah;
+            if (t.jumlah > maxJumlah) maxJumlah = t.jumlah;
+        }
+        uint32_t row = (uint32_t)rows.size();
+        rows.push_back(t);
+        if (!ids.insert(row)) *ids.find(t.id) = row;
+    }
+
+    void advance(uint64_t lsn) { endLsn = lsn; }
+
+    bool overlapsTime(int64_t from, int64_t to) const {
+        return !rows.empty() && maxWaktu >= from && minWaktu <= to;
+    }
+
+    bool overlapsAmount(double minVal, double maxVal) const {
+        return !rows.empty() && maxJumlah >= minVal && minJumlah <= maxVal;
+    }
+
+    const Transaksi* find(const char* id) const {
+        const uint32_t* row = ids.find(id);
+        return row ? &rows[*row] : NULL;
+    }
+};
+
+inline string_view WalTailIdOf::operator()(uint32_t row) const {
+    return tail->at(row).id;
+}
+
+// ---- Query lintas arsip (arsip lama + segmen) ----
+
+// Panggil fn(arsip, baris) untuk setiap transaksi dengan waktu di [from, to]
+template <typename Fn>
+void scanTimeRange(const vector<const ColumnarArchive*>& archives, int64_t from, int64_t to,
+                   SegmentScanStats& stats, Fn fn) {
+    for (size_t s = 0; s < archives.size(); s++) {
+        const ColumnarArchive& a = *archives[s];
+        stats.segments++;
+        if (!a.overlapsTime(from, to)) {
+            stats.skipped++;
+            continue;
+        }
+        for (uint64_t i = 0; i < a.rowCount(); i++) {
+            int64_t t = a.waktu(i);
+            if (t >= from && t <= to) {
+                stats.matches++;
+                fn(a, i);
+            }
+        }
+        stats.rowsScanned += a.rowCount();
+    }
+}
+
+// Panggil fn(arsip, baris) untuk setiap transaksi dengan jumlah di [minVal, maxVal]
+template <typename Fn>
+void scanAmountRange(const vector<const ColumnarArchive*>& archives, double minVal, double maxVal,
+                     SegmentScanStats& stats, Fn fn) {
+    for (size_t s = 0; s < archives.size(); s++) {
+        const ColumnarArchive& a = *archives[s];
+        stats.segments++;
+        if (!a.overlapsAmount(minVal, maxVal)) {
+            stats.skipped++;
+            continue;
+        }
+        for (uint64_t i = 0; i < a.rowCount(); i++) {
+            double v = a.jumlah(i);
+            if (v >= minVal && v <= maxVal) {
+                stats.matches++;
+                fn(a, i);
+            }
+        }
+        stats.rowsScanned += a.rowCount();
+    }
+}
+
+// Cari ID dari segmen terbaru ke terlama, segmen ditolak bloom filter dilewati
+inline bool findInArchives(const vector<const ColumnarArchive*>& archives, const char* id,
+                           Transaksi& out, SegmentScanStats& stats) {
+    for (size_t s = archives.size(); s-- > 0;) {
+        const ColumnarArchive& a = *archives[s];
+        stats.segments++;
+        if (!a.mayContainId(id)) {
+            stats.skipped++;
+            continue;
+        }
+        uint64_t row;
+        stats.rowsScanned += a.rowCount();
+        if (a.findId(id, row)) {
+            a.row(row, out);
+            stats.matches++;
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+using namespace std;
+
+// =================================================================
+// NODE POOL - Slab Allocator untuk Node Struktur Data
+// =================================================================
+/*
+ * SEBELUMNYA: setiap node dibuat dengan new sendiri-sendiri
+ * -> jutaan panggilan malloc, node tersebar di heap, dan tree yang
+ *    tidak punya destructor bocor (leak).
+ *
+ * KONSEP POOL:
+ * - Node diambil dari blok (slab) besar yang berurutan di memori.
+ *   Ukuran blok tumbuh 2x (64, 128, ... sampai 65536 node per blok)
+ * - Node yang dihapus masuk free list dan dipakai ulang lebih dulu
+ * - Setiap struktur data punya pool sendiri (free list per struktur)
+ * - Saat struktur dihancurkan, semua blok dibebaskan sekaligus
+ *   tanpa perlu menelusuri node satu per satu
+ *
+ * Hanya untuk node yang trivially destructible (semua node di
+ * data_structures.h berisi char array / angka / pointer saja).
+ */
+const size_t POOL_FIRST_BLOCK = 64;
+const size_t POOL_MAX_BLOCK = 65536;
+
+template <typename T>
+class NodePool {
+private:
+    static_assert(is_trivially_destructible<T>::value,
+                  "NodePool hanya untuk node yang trivially destructible");
+
+    union Slot {
+        Slot* next;                 // Saat berada di free list
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    vector<Slot*> blocks;
+    size_t blockSize;               // Kapasitas blok terakhir
+    size_t used;                    // Slot terpakai di blok terakhir
+    Slot* freeList;
+    size_t live;
+
+    NodePool(const NodePool&);
+    NodePool& operator=(const NodePool&);
+
+    Slot* takeSlot() {
+        if (freeList != NULL) {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            return slot;
+        }
+        if (blocks.empty() || used == blockSize) {
+            size_t next = blocks.empty() ? POOL_FIRST_BLOCK : blockSize * 2;
+            if (next > POOL_MAX_BLOCK) next = POOL_MAX_BLOCK;
+            Slot* block = (Slot*)malloc(next * sizeof(Slot));
+            if (block == NULL) throw bad_alloc();
+            blocks.push_back(block);
+            blockSize = next;
+            used = 0;
+        }
+        return &blocks.back()[used++];
+    }
+
+public:
+    NodePool() : blockSize(0), used(0), freeList(NULL), live(0) {}
+
+    ~NodePool() {
+        releaseAll();
+    }
+
+    // Buat node baru (argumen diteruskan ke constructor T)
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = takeSlot();
+        live++;
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    // Kembalikan node ke free list
+    void destroy(T* node) {
+        if (node == NULL) return;
+        Slot* slot = (Slot*)(void*)node;
+        slot->next = freeList;
+        freeList = slot;
+        live--;
+    }
+
+    // Bebaskan semua node sekaligus (pointer node lama jadi tidak valid)
+    void releaseAll() {
+        for (size_t i = 0; i < blocks.size(); i++) {
+            free(blocks[i]);
+        }
+        blocks.clear();
+        blockSize = 0;
+        used = 0;
+        freeList = NULL;
+        live = 0;
+    }
+
+    size_t liveCount() const { return live; }
+    size_t blockCount() const { return blocks.size(); }
+
+    size_t reservedBytes() const {
+        size_t total = 0, size = POOL_FIRST_BLOCK;
+        for (size_t i = 0; i < blocks.size(); i++) {
+            total += size * sizeof(Slot);
+            if (size < POOL_MAX_BLOCK) size *= 2;
+        }
+        return total;
+    }
+};
+
+#endif
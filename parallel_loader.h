@@ -0,0 +1,179 @@
+#ifndef PARALLEL_LOADER_H
+#define PARALLEL_LOADER_H
+
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace std;
+
+// =================================================================
+// PARALLEL LOADER - Utilitas Load File Besar Secara Paralel
+// =================================================================
+/*
+ * KONSEP:
+ * 1. File dibuka read-only dengan mmap (tidak disalin ke buffer)
+ * 2. Isi file dipotong menjadi beberapa chunk, setiap batas chunk
+ *    digeser ke karakter '\n' berikutnya agar tidak ada baris terpotong
+ * 3. Chunk dibagikan ke thread pool, setiap thread mengambil chunk
+ *    berikutnya sampai semua chunk selesai diproses
+ */
+const size_t LOADER_CHUNK_SIZE = 4 * 1024 * 1024;   // 4 MB per chunk
+
+// File read-only yang di-mmap utuh
+class MappedFile {
+private:
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mapHandle;
+#else
+    int fd;
+#endif
+    const char* base;
+    size_t length;
+
+public:
+    MappedFile() : base(NULL), length(0) {
+#ifdef _WIN32
+        fileHandle = INVALID_HANDLE_VALUE;
+        mapHandle = NULL;
+#else
+        fd = -1;
+#endif
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    bool open(const char* path) {
+        close();
+#ifdef _WIN32
+        fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER li;
+        if (!GetFileSizeEx(fileHandle, &li)) {
+            close();
+            return false;
+        }
+        length = (size_t)li.QuadPart;
+        if (length == 0) return true;
+
+        mapHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapHandle == NULL) {
+            close();
+            return false;
+        }
+        base = (const char*)MapViewOfFile(mapHandle, FILE_MAP_READ, 0, 0, 0);
+#else
+        fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close();
+            return false;
+        }
+        length = (size_t)st.st_size;
+        if (length == 0) return true;
+
+        void* p = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        base = (p == MAP_FAILED) ? NULL : (const char*)p;
+        if (base != NULL) {
+            madvise(p, length, MADV_SEQUENTIAL);
+        }
+#endif
+        if (base == NULL) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (base != NULL) UnmapViewOfFile(base);
+        if (mapHandle != NULL) CloseHandle(mapHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+        mapHandle = NULL;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (base != NULL) munmap((void*)base, length);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        base = NULL;
+        length = 0;
+    }
+
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+};
+
+/*
+ * Potong [data, data+size) menjadi chunk +- chunkSize byte.
+ * bounds berisi offset awal setiap chunk ditambah offset akhir file,
+ * jadi chunk ke-i = [bounds[i], bounds[i+1]).
+ */
+inline void splitChunks(const char* data, size_t size, size_t chunkSize, vector<size_t>& bounds) {
+    bounds.clear();
+    bounds.push_back(0);
+
+    size_t pos = 0;
+    while (size - pos > chunkSize) {
+        const char* nl = (const char*)memchr(data + pos + chunkSize, '\n',
+                                             size - pos - chunkSize);
+        if (nl == NULL) break;
+        pos = (size_t)(nl - data) + 1;
+        bounds.push_back(pos);
+    }
+
+    if (bounds.back() != size) {
+        bounds.push_back(size);
+    }
+}
+
+/*
+ * Jalankan fn(0) ... fn(taskCount - 1) di thread pool.
+ * Jumlah worker = jumlah core; thread pemanggil ikut bekerja.
+ */
+template <typename Fn>
+void parallelFor(int taskCount, Fn fn) {
+    if (taskCount <= 0) return;
+
+    int workers = (int)thread::hardware_concurrency();
+    if (workers < 1) workers = 1;
+    if (workers > taskCount) workers = taskCount;
+
+    atomic<int> next(0);
+    auto worker = [&]() {
+        int task;
+        while ((task = next.fetch_add(1)) < taskCount) {
+            fn(task);
+        }
+    };
+
+    vector<thread> pool;
+    for (int i = 1; i < workers; i++) {
+        pool.push_back(thread(worker));
+    }
+    worker();
+
+    for (size_t i = 0; i < pool.size(); i++) {
+        pool[i].join();
+    }
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef TIME_INDEX_H
+#define TIME_INDEX_H
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "data_structures.h"
+
+using namespace std;
+
+// =================================================================
+// TIME INDEX - Index Transaksi Urut Waktu (Sorted Array)
+// =================================================================
+/*
+ * Index jumlah (AVL / B+ Tree) tidak bisa menjawab "semua transaksi
+ * antara 2 waktu" tanpa memindai semuanya.
+ *
+ * KONSEP:
+ * - Array entry (waktu epoch, nomor record) urut waktu, sama -> urut
+ *   record. Waktu ikut disimpan di entry -> binary search tidak perlu
+ *   membaca record di TransactionStore.
+ * - Query rentang waktu = binary search O(log n) ke entry pertama,
+ *   lalu scan berurutan (array kontigu, ramah cache & prefetch)
+ * - sync() mengejar record baru di store: transaksi baru hampir selalu
+ *   paling akhir -> cukup ditempel di ujung array (O(1)). Saat load
+ *   (store urut jumlah) entry baru diurutkan sekali lalu digabung.
+ */
+struct TimeIndexEntry {
+    int64_t waktu;
+    uint32_t rec;
+
+    bool operator<(const TimeIndexEntry& other) const {
+        return waktu < other.waktu || (waktu == other.waktu && rec < other.rec);
+    }
+};
+
+class TransactionTimeIndex {
+private:
+    const TransactionStore& store;
+    vector<TimeIndexEntry> entries;
+    uint32_t synced;                // Record [0, synced) sudah ter-index
+
+    TransactionTimeIndex(const TransactionTimeIndex&);
+    TransactionTimeIndex& operator=(const TransactionTimeIndex&);
+
+public:
+    explicit TransactionTimeIndex(const TransactionStore& transactions)
+        : store(transactions), synced(0) {}
+
+    void sync() {
+        uint32_t to = (uint32_t)store.size();
+        if (synced == to) return;
+
+        size_t old = entries.size();
+        entries.reserve(to);
+        bool ordered = true;
+        for (uint32_t rec = synced; rec < to; rec++) {
+            TimeIndexEntry e = {store[rec].waktu, rec};
+            if (!entries.empty() && e < entries.back()) ordered = false;
+            entries.push_back(e);
+        }
+
+        if (!ordered) {
+            sort(entries.begin() + old, entries.end());
+            inplace_merge(entries.begin(), entries.begin() + old, entries.end());
+        }
+        synced = to;
+    }
+
+    size_t size() const { return entries.size(); }
+
+    // Posisi entry pertama dengan waktu >= from
+    size_t lowerBound(int64_t from) const {
+        TimeIndexEntry key = {from, 0};
+        return lower_bound(entries.begin(), entries.end(), key) - entries.begin();
+    }
+
+    // Posisi entry pertama dengan waktu > to
+    size_t upperBound(int64_t to) const {
+        TimeIndexEntry key = {to, UINT32_MAX};
+        return upper_bound(entries.begin(), entries.end(), key) - entries.begin();
+    }
+
+    size_t countInRange(int64_t from, int64_t to) const {
+        if (from > to) return 0;
+        return upperBound(to) - lowerBound(from);
+    }
+
+    // Masih ada transaksi di posisi pos dengan waktu <= to?
+    bool hasRow(size_t pos, int64_t to) const {
+        return pos < entries.size() && entries[pos].waktu <= to;
+    }
+
+    /*
+     * Kunjungi maksimal limit transaksi (0 = tanpa batas) mulai dari
+     * posisi pos selama waktunya <= to. pos maju ke baris berikutnya
+     * (untuk halaman berikutnya). Return jumlah baris.
+     */
+    template <typename Fn>
+    size_t visitFrom(size_t& pos, int64_t to, size_t limit, Fn fn) const {
+        size_t rows = 0;
+        for (; hasRow(pos, to); pos++) {
+            if (limit > 0 && rows == limit) break;
+            fn(store[entries[pos].rec]);
+            rows++;
+        }
+        return rows;
+    }
+
+    // Semua transaksi dengan waktu di [from, to], urut waktu
+    template <typename Fn>
+    size_t forEachInRange(int64_t from, int64_t to, Fn fn) const {
+        size_t pos = lowerBound(from);
+        return visitFrom(pos, to, 0, fn);
+    }
+
+    size_t indexBytes() const {
+        return entries.capacity() * sizeof(TimeIndexEntry);
+    }
+};
+
+#endif
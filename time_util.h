@@ -0,0 +1,103 @@
+#ifndef TIME_UTIL_H
+#define TIME_UTIL_H
+
+#include <cstdint>
+#include <ctime>
+#include <string_view>
+
+using namespace std;
+
+// =================================================================
+// TIME UTIL - Konversi Timestamp "DD/MM/YYYY HH:MM:SS" <-> Epoch
+// =================================================================
+/*
+ * Timestamp disimpan sebagai detik sejak 01/01/1970 00:00:00 menurut
+ * jam lokal yang tertulis di data (tanpa konversi zona waktu), sehingga
+ * konversi bolak-balik selalu menghasilkan string yang sama.
+ * Perhitungan tanggal memakai algoritma "days from civil" (murni
+ * aritmatika, tanpa localtime/mktime yang memakai lock).
+ */
+
+// Jumlah hari sejak 01/01/1970 untuk tanggal (y, m, d)
+inline int64_t daysFromCivil(int64_t y, int m, int d) {
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yoe = y - era * 400;
+    int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+inline void civilFromDays(int64_t z, int& y, int& m, int& d) {
+    z += 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    y = (int)(yoe + era * 400 + (m <= 2));
+}
+
+// Parse "DD/MM/YYYY HH:MM:SS" -> epoch detik. Return false jika format salah.
+inline bool parseTimestamp(string_view s, int64_t& epoch) {
+    if (s.size() < 19) return false;
+
+    const int pos[] = {0, 1, 3, 4, 6, 7, 8, 9, 11, 12, 14, 15, 17, 18};
+    int digit[14];
+    for (int i = 0; i < 14; i++) {
+        char c = s[pos[i]];
+        if (c < '0' || c > '9') return false;
+        digit[i] = c - '0';
+    }
+
+    int day = digit[0] * 10 + digit[1];
+    int month = digit[2] * 10 + digit[3];
+    int year = digit[4] * 1000 + digit[5] * 100 + digit[6] * 10 + digit[7];
+    int hour = digit[8] * 10 + digit[9];
+    int minute = digit[10] * 10 + digit[11];
+    int second = digit[12] * 10 + digit[13];
+    if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+
+    epoch = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+// Jam lokal sekarang dalam epoch detik (skala yang sama dengan parseTimestamp)
+inline int64_t currentLocalEpoch() {
+    time_t now = time(0);
+    struct tm* t = localtime(&now);
+    return daysFromCivil(t->tm_year + 1900, t->tm_mon + 1, t->tm_mday) * 86400 +
+           t->tm_hour * 3600 + t->tm_min * 60 + t->tm_sec;
+}
+
+// Tulis angka 2 digit (00-99) ke buffer
+inline void putTwoDigits(char* out, unsigned v) {
+    out[0] = (char)('0' + v / 10 % 10);
+    out[1] = (char)('0' + v % 10);
+}
+
+// Epoch detik -> "DD/MM/YYYY HH:MM:SS" (buffer minimal 20 byte)
+inline void formatTimestamp(int64_t epoch, char* out) {
+    int64_t days = epoch >= 0 ? epoch / 86400 : (epoch - 86399) / 86400;
+    unsigned secs = (unsigned)(epoch - days * 86400);
+    int y, m, d;
+    civilFromDays(days, y, m, d);
+
+    putTwoDigits(out, (unsigned)d);
+    out[2] = '/';
+    putTwoDigits(out + 3, (unsigned)m);
+    out[5] = '/';
+    putTwoDigits(out + 6, (unsigned)y / 100);
+    putTwoDigits(out + 8, (unsigned)y % 100);
+    out[10] = ' ';
+    putTwoDigits(out + 11, secs / 3600);
+    out[13] = ':';
+    putTwoDigits(out + 14, secs / 60 % 60);
+    out[16] = ':';
+    putTwoDigits(out + 17, secs % 60);
+    out[19] = '\0';
+}
+
+#endif
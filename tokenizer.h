@@ -0,0 +1,169 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <cstring>
+#include <cstdint>
+#include <string_view>
+#include <charconv>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    #include <immintrin.h>
+#endif
+
+using namespace std;
+
+// =================================================================
+// RECORD TOKENIZER - Parser Field "|" Tanpa Copy (SIMD)
+// =================================================================
+/*
+ * PENGGANTI strtok UNTUK SEMUA LOADER
+ *
+ * Masalah strtok:
+ * - Tidak reentrant (state global) -> tidak bisa dipakai multi-thread
+ * - Memodifikasi buffer input (menulis '\0')
+ * - Scan byte per byte
+ *
+ * Cara kerja tokenizer ini:
+ * - Mencari '|' dan '\n' sekaligus 32 byte (AVX2) atau 16 byte (SSE2)
+ *   per instruksi: bandingkan, gabungkan mask, ambil bit pertama
+ * - Field dikembalikan sebagai string_view yang menunjuk langsung ke
+ *   buffer input (zero-copy), buffer tidak diubah
+ * - Angka di-parse dengan from_chars (tidak tergantung locale)
+ *
+ * Jalur yang dipakai dipilih saat kompilasi:
+ * - AVX2  : kompilasi dengan -mavx2 (atau -march=native)
+ * - SSE2  : default di semua CPU x86-64
+ * - Scalar: CPU lain, atau paksa dengan -DEWALLET_SCALAR_TOKENIZER
+ */
+
+// Cari '|' atau '\n' pertama di [p, end), kembalikan end jika tidak ada
+inline const char* findDelimiterScalar(const char* p, const char* end) {
+    while (p < end && *p != '|' && *p != '\n') {
+        p++;
+    }
+    return p;
+}
+
+#ifdef __SSE2__
+inline const char* findDelimiterSSE2(const char* p, const char* end) {
+    const __m128i pipe = _mm_set1_epi8('|');
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)p);
+        __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(chunk, pipe), _mm_cmpeq_epi8(chunk, newline));
+        unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+    return findDelimiterScalar(p, end);
+}
+#endif
+
+#ifdef __AVX2__
+inline const char* findDelimiterAVX2(const char* p, const char* end) {
+    const __m256i pipe = _mm256_set1_epi8('|');
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    while (end - p >= 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)p);
+        __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, pipe),
+                                      _mm256_cmpeq_epi8(chunk, newline));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(hit);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return findDelimiterSSE2(p, end);
+}
+#endif
+
+inline const char* findDelimiter(const char* p, const char* end) {
+#if defined(EWALLET_SCALAR_TOKENIZER)
+    return findDelimiterScalar(p, end);
+#elif defined(__AVX2__)
+    return findDelimiterAVX2(p, end);
+#elif defined(__SSE2__)
+    return findDelimiterSSE2(p, end);
+#else
+    return findDelimiterScalar(p, end);
+#endif
+}
+
+inline const char* tokenizerMode() {
+#if defined(EWALLET_SCALAR_TOKENIZER)
+    return "Scalar";
+#elif defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+class RecordTokenizer {
+private:
+    const char* pos;
+    const char* end;
+
+public:
+    RecordTokenizer(const char* begin, const char* finish) : pos(begin), end(finish) {}
+
+    bool atEnd() const {
+        return pos >= end;
+    }
+
+    /*
+     * Ambil field-field dari 1 baris berikutnya.
+     * - Maksimal maxFields field; field terakhir berisi sisa baris
+     * - '\r' di akhir baris (file Windows) dibuang
+     * - Return jumlah field, atau -1 jika input sudah habis
+     */
+    int nextRecord(string_view* fields, int maxFields) {
+        if (pos >= end) return -1;
+
+        int count = 0;
+        while (true) {
+            const char* start = pos;
+            const char* stop;
+
+            if (count == maxFields - 1) {
+                stop = (const char*)memchr(pos, '\n', end - pos);
+                if (stop == NULL) stop = end;
+            } else {
+                stop = findDelimiter(pos, end);
+            }
+
+            const char* fieldEnd = stop;
+            bool lineDone = (stop == end || *stop == '\n');
+            if (lineDone && fieldEnd > start && fieldEnd[-1] == '\r') {
+                fieldEnd--;
+            }
+
+            fields[count++] = string_view(start, fieldEnd - start);
+            pos = (stop < end) ? stop + 1 : end;
+
+            if (lineDone) break;
+        }
+        return count;
+    }
+};
+
+// Salin field ke buffer fixed-size (terpotong jika terlalu panjang)
+inline void copyField(char* dest, size_t size, string_view field) {
+    size_t len = field.size() < size - 1 ? field.size() : size - 1;
+    memcpy(dest, field.data(), len);
+    dest[len] = '\0';
+}
+
+// Parse angka dengan from_chars (tidak tergantung locale, tanpa copy)
+inline bool parseDouble(string_view field, double& value) {
+    from_chars_result r = from_chars(field.data(), field.data() + field.size(), value);
+    return r.ec == errc();
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef TRANSACTION_CLOCK_H
+#define TRANSACTION_CLOCK_H
+
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+#include <atomic>
+#include "time_util.h"
+
+using namespace std;
+
+// =================================================================
+// TRANSACTION CLOCK - Waktu & ID Transaksi
+// =================================================================
+/*
+ * SEBELUMNYA: setiap constructor Transaksi memanggil time(0),
+ * localtime (memakai lock global) dan sprintf, dan ID diambil dari
+ * "static int counter = 1000" yang mulai dari 1000 lagi setiap program
+ * dijalankan -> ID bentrok dengan TRX1000.. yang sudah ada di file,
+ * dan tidak aman dipakai beberapa thread.
+ *
+ * WAKTU:
+ * - Selisih jam lokal - UTC di-cache per detik; localtime_r hanya
+ *   dipanggil jika detiknya berganti (maks. 1x per detik)
+ * - Di detik yang sama: waktu lokal = time(0) + selisih (tanpa lock)
+ *
+ * ID TRANSAKSI: "TRX" + angka 64-bit (maks. 16 digit)
+ *   angka = (detik sejak 01/01/2024 UTC) << 20 | urutan
+ * - Urut waktu: ID lebih besar = transaksi lebih baru
+ * - Bebas bentrok: angka diambil dengan compare-and-swap dari ID
+ *   terakhir (lock-free), selalu > ID sebelumnya. Lebih dari 2^20 ID
+ *   dalam 1 detik tetap unik (meminjam ruang detik berikutnya).
+ * - Melanjutkan dari ID terbesar yang dimuat (observeId dipanggil untuk
+ *   setiap record yang masuk TransactionStore)
+ */
+const int64_t TRX_ID_EPOCH = 1704067200;    // 01/01/2024 00:00:00 UTC
+const int TRX_ID_SEQUENCE_BITS = 20;
+
+class TransactionClock {
+private:
+    atomic<int64_t> cachedSecond;   // time(0) saat selisih terakhir dihitung
+    atomic<int64_t> localOffset;    // Jam lokal - UTC (detik)
+    atomic<uint64_t> lastId;
+
+    TransactionClock(const TransactionClock&);
+    TransactionClock& operator=(const TransactionClock&);
+
+    void refresh(int64_t now) {
+        time_t t = (time_t)now;
+        struct tm local;
+#ifdef _WIN32
+        localtime_s(&local, &t);
+#else
+        localtime_r(&t, &local);
+#endif
+        int64_t localEpoch = daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday) * 86400 +
+                             local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+        localOffset.store(localEpoch - now, memory_order_relaxed);
+        cachedSecond.store(now, memory_order_release);
+    }
+
+    // Naikkan lastId ke minimal value (lock-free)
+    void raiseTo(uint64_t value) {
+        uint64_t last = lastId.load(memory_order_relaxed);
+        while (value > last && !lastId.compare_exchange_weak(last, value, memory_order_relaxed)) {
+        }
+    }
+
+public:
+    TransactionClock() : cachedSecond(INT64_MIN), localOffset(0), lastId(0) {}
+
+    // Waktu sekarang dalam epoch jam lokal (skala sama dengan parseTimestamp)
+    int64_t nowLocal() {
+        int64_t now = (int64_t)time(0);
+        if (now != cachedSecond.load(memory_order_acquire)) refresh(now);
+        return now + localOffset.load(memory_order_relaxed);
+    }
+
+    // Angka ID berikutnya: > semua ID yang sudah dibuat/dimuat
+    uint64_t nextIdNumber() {
+        uint64_t candidate = (uint64_t)((int64_t)time(0) - TRX_ID_EPOCH) << TRX_ID_SEQUENCE_BITS;
+        uint64_t last = lastId.load(memory_order_relaxed);
+        uint64_t next;
+        do {
+            next = candidate > last ? candidate : last + 1;
+        } while (!lastId.compare_exchange_weak(last, next, memory_order_relaxed));
+        return next;
+    }
+
+    // Tulis ID baru "TRX..." ke out (minimal 20 byte)
+    void nextId(char* out, size_t size) {
+        snprintf(out, size, "TRX%llu", (unsigned long long)nextIdNumber());
+    }
+
+    // ID yang dimuat dari data: ID baru berikutnya harus lebih besar
+    void observeId(const char* id) {
+        if (id[0] != 'T' || id[1] != 'R' || id[2] != 'X') return;
+
+        uint64_t value = 0;
+        int digits = 0;
+        for (const char* p = id + 3; *p >= '0' && *p <= '9' && digits < 19; p++, digits++) {
+            value = value * 10 + (uint64_t)(*p - '0');
+        }
+        if (digits > 0) raiseTo(value);
+    }
+
+    uint64_t lastIdNumber() const {
+        return lastId.load(memory_order_relaxed);
+    }
+};
+
+// Satu clock untuk seluruh program (inisialisasi thread-safe)
+inline TransactionClock& transactionClock() {
+    static TransactionClock clock;
+    return clock;
+}
+
+#endif
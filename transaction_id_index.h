@@ -0,0 +1,190 @@
+#ifndef TRANSACTION_ID_INDEX_H
+#define TRANSACTION_ID_INDEX_H
+
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <string_view>
+#include "data_structures.h"
+#include "hash_index.h"
+
+using namespace std;
+
+// =================================================================
+// TRANSACTION ID INDEX - Lookup Transaksi berdasarkan ID + Status Refund
+// =================================================================
+/*
+ * SEBELUMNYA: refund diterima tanpa cek ke data transaksi, karena
+ * mencari 1 ID berarti menelusuri seluruh index jumlah (O(n)).
+ *
+ * KONSEP:
+ * - HashIndex ID -> nomor record di TransactionStore (ID tidak disalin,
+ *   diambil dari record-nya). ID ganda: transaksi terbaru yang dipakai.
+ * - Status refund per transaksi = 2 bit (4 transaksi per byte):
+ *     0 = belum pernah, 1 = sedang diajukan, 2 = sudah di-refund
+ * - Refund yang disetujui dicatat sebagai transaksi "Refund" dengan
+ *   keterangan "Refund <ID>: ..." -> status "sudah di-refund" ikut
+ *   terbangun ulang dari log/checkpoint saat load
+ * - Validasi refund (pemilik, jumlah, refund ganda) = O(1)
+ */
+const char* const REFUND_JENIS = "Refund";
+const char* const REFUND_NOTE_PREFIX = "Refund ";
+
+enum RefundState {
+    REFUND_NONE = 0,
+    REFUND_PENDING = 1,
+    REFUND_DONE = 2
+};
+
+struct TransactionIdOf {
+    const TransactionStore* store;
+
+    string_view operator()(uint32_t rec) const {
+        return (*store)[rec].id;
+    }
+};
+
+class TransactionIdIndex {
+private:
+    const TransactionStore& store;
+    HashIndex<uint32_t, TransactionIdOf> index;
+    vector<uint8_t> states;         // 2 bit RefundState per record
+    uint32_t synced;                // Record [0, synced) sudah ter-index
+
+    TransactionIdIndex(const TransactionIdIndex&);
+    TransactionIdIndex& operator=(const TransactionIdIndex&);
+
+    void setState(uint32_t rec, RefundState state) {
+        int shift = (rec & 3) * 2;
+        states[rec >> 2] = (uint8_t)((states[rec >> 2] & ~(3 << shift)) | (state << shift));
+    }
+
+    // ID ganda: record dengan waktu terbaru yang dipakai (sama -> record terakhir)
+    bool newerThan(uint32_t a, uint32_t b) const {
+        int64_t ta = store[a].waktu, tb = store[b].waktu;
+        return ta > tb || (ta == tb && a > b);
+    }
+
+    // Transaksi "Refund" -> tandai transaksi asalnya sudah di-refund
+    void applyRefundRecord(const TransaksiRecord& t) {
+        if (strcmp(t.jenis, REFUND_JENIS) != 0) return;
+
+        // Keterangan hanya di-decode untuk transaksi "Refund"
+        char keterangan[KETERANGAN_MAX_LENGTH];
+        t.keteranganText(keterangan);
+        size_t prefix = strlen(REFUND_NOTE_PREFIX);
+        if (strncmp(keterangan, REFUND_NOTE_PREFIX, prefix) != 0) return;
+
+        string_view id(keterangan + prefix);
+        size_t end = id.find(':');
+        if (end != string_view::npos) id = id.substr(0, end);
+
+        const uint32_t* rec = index.find(id);
+        if (rec != NULL) setState(*rec, REFUND_DONE);
+    }
+
+public:
+    explicit TransactionIdIndex(const TransactionStore& transactions)
+        : store(transactions), index(TransactionIdOf{&transactions}), synced(0) {}
+
+    // Index semua record baru di store (saat load: semuanya, setelah insert: 1 record)
+    void sync() {
+        uint32_t to = (uint32_t)store.size();
+        if (synced == to) return;
+
+        index.reserve(to);
+        states.resize((to + 3) / 4, 0);
+        for (uint32_t rec = synced; rec < to; rec++) {
+            uint32_t* existing = index.find(store[rec].id);
+            if (existing == NULL) {
+                index.insert(rec);
+            } else if (!newerThan(*existing, rec)) {
+                *existing = rec;
+            }
+        }
+
+        // Setelah semua ID masuk: urutan record di store (saat load = urut
+        // jumlah) tidak menjamin transaksi asal ter-index lebih dulu
+        for (uint32_t rec = synced; rec < to; rec++) {
+            applyRefundRecord(store[rec]);
+        }
+        synced = to;
+    }
+
+    // Record transaksi dengan ID tertentu, -1 jika tidak ada
+    int64_t findRec(const char* id) const {
+        const uint32_t* rec = index.find(id);
+        return rec ? (int64_t)*rec : -1;
+    }
+
+    const TransaksiRecord* find(const char* id) const {
+        int64_t rec = findRec(id);
+        return rec >= 0 ? &store[(uint32_t)rec] : NULL;
+    }
+
+    RefundState refundState(uint32_t rec) const {
+        return (RefundState)((states[rec >> 2] >> ((rec & 3) * 2)) & 3);
+    }
+
+    static const char* refundStateName(RefundState state) {
+        if (state == REFUND_PENDING) return "Sedang diajukan";
+        if (state == REFUND_DONE) return "Sudah di-refund";
+        return "Belum pernah";
+    }
+
+    /*
+     * Validasi refund: transaksi ada, dibayar oleh username (pengirim),
+     * 0 < jumlah <= jumlah transaksi, dan status refund = expected
+     * (REFUND_NONE saat diajukan, REFUND_PENDING saat diproses admin).
+     * Return record transaksi, atau -1 (pesan error sudah ditampilkan).
+     */
+    int64_t validateRefund(const char* username, const char* id, double jumlah,
+                           RefundState expected) const {
+        int64_t rec = findRec(id);
+        if (rec < 0) {
+            cout << "Error: Transaction ID " << id << " tidak ditemukan!\n";
+            return -1;
+        }
+
+        const TransaksiRecord& t = store[(uint32_t)rec];
+        if (strcmp(t.jenis, REFUND_JENIS) == 0 || strcmp(t.dari, username) != 0) {
+            cout << "Error: Transaksi " << id << " bukan pembayaran/transfer milik "
+                 << username << "!\n";
+            return -1;
+        }
+        if (jumlah <= 0 || jumlah > t.jumlah) {
+            cout << "Error: Jumlah refund harus antara Rp 0 dan Rp " << t.jumlah << "!\n";
+            return -1;
+        }
+
+        RefundState state = refundState((uint32_t)rec);
+        if (state != expected) {
+            cout << "Error: Status refund transaksi " << id << ": "
+                 << refundStateName(state) << "!\n";
+            return -1;
+        }
+        return rec;
+    }
+
+    void markPending(uint32_t rec) { setState(rec, REFUND_PENDING); }
+    void clearPending(uint32_t rec) { setState(rec, REFUND_NONE); }
+
+    // Request di stack refund (dari checkpoint) -> status "sedang diajukan"
+    void restorePending(const RefundStack& refundStack) {
+        refundStack.forEach([&](const RefundRequest& req) {
+            int64_t rec = findRec(req.transactionId);
+            if (rec >= 0 && refundState((uint32_t)rec) == REFUND_NONE) {
+                setState((uint32_t)rec, REFUND_PENDING);
+            }
+        });
+    }
+
+    size_t size() const { return index.size(); }
+
+    size_t indexBytes() const {
+        return index.capacity() * (sizeof(uint32_t) * 2) + states.capacity();
+    }
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef TRANSACTION_INDEX_H
+#define TRANSACTION_INDEX_H
+
+#include "data_structures.h"
+#include "bplus_tree.h"
+
+// =================================================================
+// TRANSACTION INDEX - Pilihan Struktur Index Transaksi
+// =================================================================
+/*
+ * Index jumlah transaksi dipilih saat kompilasi:
+ * - Default: AVLTree (binary tree, visualisasi balance factor)
+ * - -DUSE_BPLUS_TREE: BPlusTree (node lebar + leaf tersambung,
+ *   lebih cepat untuk data besar yang tidak muat di cache)
+ * Keduanya punya interface yang sama dan memakai TransactionStore.
+ */
+#ifdef USE_BPLUS_TREE
+typedef BPlusTree TransactionIndex;
+const char* const TRANSACTION_INDEX_NAME = "B+ Tree";
+#else
+typedef AVLTree TransactionIndex;
+const char* const TRANSACTION_INDEX_NAME = "AVL Tree";
+#endif
+
+#endif
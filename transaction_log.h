@@ -0,0 +1,472 @@
+#ifndef TRANSACTION_LOG_H
+#define TRANSACTION_LOG_H
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace std;
+
+// =================================================================
+// CRC32 - Checksum Record Log
+// =================================================================
+/*
+ * Slicing-by-8: 8 tabel 256 entry, 8 byte input per iterasi (bukan
+ * 1 lookup per byte). Hasil sama persis dengan CRC32 per byte, jadi
+ * file WAL/checkpoint lama tetap valid.
+ */
+struct Crc32Table {
+    uint32_t entry[8][256];
+
+    Crc32Table() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            entry[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; i++) {
+            for (int t = 1; t < 8; t++) {
+                entry[t][i] = entry[0][entry[t - 1][i] & 0xFF] ^ (entry[t - 1][i] >> 8);
+            }
+        }
+    }
+};
+
+inline uint32_t crc32(const void* data, size_t len, uint32_t crc = 0) {
+    static const Crc32Table table;
+
+    const unsigned char* p = (const unsigned char*)data;
+    crc = ~crc;
+    for (; len >= 8; p += 8, len -= 8) {
+        uint32_t lo = crc ^ ((uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+        crc = table.entry[7][lo & 0xFF] ^ table.entry[6][(lo >> 8) & 0xFF] ^
+              table.entry[5][(lo >> 16) & 0xFF] ^ table.entry[4][lo >> 24] ^
+              table.entry[3][p[4]] ^ table.entry[2][p[5]] ^
+              table.entry[1][p[6]] ^ table.entry[0][p[7]];
+    }
+    for (; len > 0; p++, len--) {
+        crc = table.entry[0][(crc ^ *p) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+// =================================================================
+// TRANSACTION LOG - Write-Ahead Log dengan Group Commit
+// =================================================================
+/*
+ * FORMAT FILE transactions.wal
+ *
+ * [Header 32 byte][Record][Record]...
+ * Record = [panjang payload (u32)][CRC32 payload (u32)][payload]
+ *
+ * Payload adalah 1 baris transaksi dengan format yang sama seperti
+ * transactions.txt, sehingga parser yang sama bisa dipakai ulang.
+ *
+ * GROUP COMMIT:
+ * - File log selalu terbuka (tidak ada open/close per transaksi)
+ * - append() memasukkan record ke buffer lalu menunggu commit
+ * - Thread writer mengumpulkan semua append yang datang selama
+ *   "commit window", lalu menulis semuanya dengan 1x write + 1x fdatasync
+ * - append() baru kembali setelah datanya DIJAMIN tersimpan di disk
+ *
+ * FAIL-STOP:
+ * Jika write/fdatasync 1 batch gagal, isi page cache tidak bisa lagi
+ * dipercaya. Log berhenti menulis: batch itu dan semua append berikutnya
+ * return false, dan tidak ada record yang ditulis lagi sampai log dibuka
+ * ulang. append() hanya return true jika batch-nya sendiri sudah durable.
+ *
+ * RECOVERY:
+ * - Saat dibuka, semua record dibaca dan dicek panjang & CRC-nya
+ * - Record terakhir yang terpotong (crash saat menulis) dibuang dan
+ *   file dipotong di akhir record valid terakhir
+ *
+ * LSN (Log Sequence Number) = posisi byte setelah sebuah record,
+ * dihitung dari awal area data log.
+ *
+ * ROLLOVER:
+ * Setelah isi log ditutup menjadi segmen (lihat log_segments.h), log
+ * diganti file baru yang kosong dengan baseLsn = LSN akhir log lama,
+ * sehingga LSN tetap naik terus secara global antar segmen.
+ */
+const uint32_t TRANSACTION_LOG_VERSION = 1;
+const uint32_t LOG_MAX_RECORD = 4096;
+
+struct TransactionLogHeader {
+    char magic[8];          // "EWTXLOG\0"
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t baseLsn;       // LSN awal file ini
+    uint64_t reserved2;
+};
+
+class TransactionLog {
+private:
+#ifdef _WIN32
+    HANDLE fileHandle;
+#else
+    int fd;
+#endif
+    char path[260];
+    uint64_t baseLsn;
+    uint64_t writeOffset;       // Offset file setelah record valid terakhir
+
+    // State group commit
+    mutex mtx;
+    condition_variable writerCv;
+    condition_variable commitCv;
+    vector<char> pending;
+    uint64_t enqueuedSeq;
+    uint64_t committedSeq;      // Seq terakhir yang sudah diproses writer
+    uint64_t durableSeq;        // Seq terakhir yang berhasil di-fdatasync
+    bool writeFailed;           // Fail-stop: tidak ada write setelah gagal
+    bool stopping;
+    long commitWindowUs;
+    thread writer;
+
+    bool writeAt(uint64_t offset, const char* buf, size_t len) {
+#ifdef _WIN32
+        while (len > 0) {
+            OVERLAPPED ov;
+            memset(&ov, 0, sizeof(ov));
+            ov.Offset = (DWORD)(offset & 0xFFFFFFFFu);
+            ov.OffsetHigh = (DWORD)(offset >> 32);
+            DWORD written = 0;
+            if (!WriteFile(fileHandle, buf, (DWORD)len, &written, &ov)) return false;
+            buf += written;
+            offset += written;
+            len -= written;
+        }
+        return true;
+#else
+        while (len > 0) {
+            ssize_t n = pwrite(fd, buf, len, (off_t)offset);
+            if (n < 0) return false;
+            buf += n;
+            offset += (uint64_t)n;
+            len -= (size_t)n;
+        }
+        return true;
+#endif
+    }
+
+    bool syncData() {
+#ifdef _WIN32
+        return FlushFileBuffers(fileHandle) != 0;
+#elif defined(__APPLE__)
+        return fsync(fd) == 0;
+#else
+        return fdatasync(fd) == 0;
+#endif
+    }
+
+    bool readAt(uint64_t offset, void* buf, size_t len) const {
+#ifdef _WIN32
+        OVERLAPPED ov;
+        memset(&ov, 0, sizeof(ov));
+        ov.Offset = (DWORD)(offset & 0xFFFFFFFFu);
+        ov.OffsetHigh = (DWORD)(offset >> 32);
+        DWORD got = 0;
+        if (!ReadFile(fileHandle, buf, (DWORD)len, &got, &ov)) return false;
+        return got == len;
+#else
+        size_t done = 0;
+        while (done < len) {
+            ssize_t n = pread(fd, (char*)buf + done, len - done, (off_t)(offset + done));
+            if (n <= 0) return false;
+            done += (size_t)n;
+        }
+        return true;
+#endif
+    }
+
+    uint64_t fileSize() const {
+#ifdef _WIN32
+        LARGE_INTEGER li;
+        if (!GetFileSizeEx(fileHandle, &li)) return 0;
+        return (uint64_t)li.QuadPart;
+#else
+        struct stat st;
+        if (fstat(fd, &st) != 0) return 0;
+        return (uint64_t)st.st_size;
+#endif
+    }
+
+    bool truncateFile(uint64_t size) {
+#ifdef _WIN32
+        LARGE_INTEGER li;
+        li.QuadPart = (LONGLONG)size;
+        return SetFilePointerEx(fileHandle, li, NULL, FILE_BEGIN) && SetEndOfFile(fileHandle);
+#else
+        return ftruncate(fd, (off_t)size) == 0;
+#endif
+    }
+
+    bool isOpen() const {
+#ifdef _WIN32
+        return fileHandle != INVALID_HANDLE_VALUE;
+#else
+        return fd >= 0;
+#endif
+    }
+
+    // Scan seluruh record, buang ekor yang terpotong / checksum salah
+    void recover() {
+        uint64_t size = fileSize();
+        uint64_t offset = sizeof(TransactionLogHeader);
+        char buf[LOG_MAX_RECORD];
+
+        while (offset + 8 <= size) {
+            uint32_t meta[2];
+            if (!readAt(offset, meta, 8)) break;
+            if (meta[0] == 0 || meta[0] > LOG_MAX_RECORD || offset + 8 + meta[0] > size) break;
+            if (!readAt(offset + 8, buf, meta[0])) break;
+            if (crc32(buf, meta[0]) != meta[1]) break;
+            offset += 8 + meta[0];
+        }
+
+        if (offset < size) {
+            cout << "[WAL] Recovery: " << (size - offset)
+                 << " byte record terpotong di akhir log dibuang.\n";
+        }
+        truncateFile(offset);
+        writeOffset = offset;
+    }
+
+    void writerLoop() {
+        vector<char> batch;
+        unique_lock<mutex> lock(mtx);
+
+        while (true) {
+            writerCv.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty() && stopping) break;
+
+            // Tunggu selama commit window agar append lain ikut 1 batch
+            if (commitWindowUs > 0 && !stopping) {
+                writerCv.wait_for(lock, chrono::microseconds(commitWindowUs),
+                                  [this] { return stopping; });
+            }
+
+            batch.swap(pending);
+            uint64_t batchSeq = enqueuedSeq;
+            uint64_t offset = writeOffset;
+            bool failed = writeFailed;
+            lock.unlock();
+
+            bool ok = !failed &&
+                      writeAt(offset, batch.data(), batch.size()) && syncData();
+
+            lock.lock();
+            if (ok) {
+                writeOffset += batch.size();
+                durableSeq = batchSeq;
+            } else {
+                writeFailed = true;
+            }
+            batch.clear();
+            committedSeq = batchSeq;
+            commitCv.notify_all();
+        }
+    }
+
+public:
+    TransactionLog() : baseLsn(0), writeOffset(0), enqueuedSeq(0), committedSeq(0),
+                       durableSeq(0), writeFailed(false), stopping(false), commitWindowUs(2000) {
+#ifdef _WIN32
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        fd = -1;
+#endif
+        path[0] = '\0';
+    }
+
+    ~TransactionLog() {
+        close();
+    }
+
+    // Atur lama commit window (mikrodetik). 0 = commit langsung.
+    void setCommitWindow(long microseconds) {
+        lock_guard<mutex> lock(mtx);
+        commitWindowUs = microseconds;
+    }
+
+    bool open(const char* logPath) {
+        close();
+        if (logPath != path) {
+            strncpy(path, logPath, sizeof(path) - 1);
+            path[sizeof(path) - 1] = '\0';
+        }
+#ifdef _WIN32
+        fileHandle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                                 OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+        fd = ::open(path, O_RDWR | O_CREAT, 0644);
+#endif
+        if (!isOpen()) {
+            cout << "Error: Tidak bisa membuka transaction log\n";
+            return false;
+        }
+
+        TransactionLogHeader h;
+        if (fileSize() < sizeof(h)) {
+            memset(&h, 0, sizeof(h));
+            memcpy(h.magic, "EWTXLOG", 7);
+            h.version = TRANSACTION_LOG_VERSION;
+            h.baseLsn = 0;
+            if (!truncateFile(0) || !writeAt(0, (const char*)&h, sizeof(h)) || !syncData()) {
+                close();
+                return false;
+            }
+        } else if (!readAt(0, &h, sizeof(h)) ||
+                   memcmp(h.magic, "EWTXLOG", 7) != 0 ||
+                   h.version != TRANSACTION_LOG_VERSION) {
+            cout << "Error: Format transaction log tidak dikenali\n";
+            close();
+            return false;
+        }
+
+        baseLsn = h.baseLsn;
+        recover();
+
+        writeFailed = false;
+        stopping = false;
+        writer = thread(&TransactionLog::writerLoop, this);
+        return true;
+    }
+
+    void close() {
+        if (writer.joinable()) {
+            {
+                lock_guard<mutex> lock(mtx);
+                stopping = true;
+            }
+            writerCv.notify_all();
+            writer.join();
+        }
+        if (!isOpen()) return;
+#ifdef _WIN32
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        ::close(fd);
+        fd = -1;
+#endif
+    }
+
+    /*
+     * Tambah 1 record ke log. Fungsi ini menunggu sampai batch yang
+     * memuat record ini selesai di-fdatasync (durable).
+     */
+    bool append(const char* data, uint32_t len) {
+        if (len == 0 || len > LOG_MAX_RECORD) return false;
+
+        uint32_t meta[2] = { len, crc32(data, len) };
+
+        unique_lock<mutex> lock(mtx);
+        if (!writer.joinable() || writeFailed) return false;
+
+        pending.insert(pending.end(), (const char*)meta, (const char*)meta + 8);
+        pending.insert(pending.end(), data, data + len);
+        uint64_t mySeq = ++enqueuedSeq;
+        writerCv.notify_one();
+
+        commitCv.wait(lock, [this, mySeq] { return committedSeq >= mySeq; });
+        return durableSeq >= mySeq;
+    }
+
+    // LSN setelah record terakhir yang sudah durable
+    uint64_t endLsn() {
+        lock_guard<mutex> lock(mtx);
+        return baseLsn + writeOffset - sizeof(TransactionLogHeader);
+    }
+
+    // LSN awal file log yang aktif
+    uint64_t getBaseLsn() {
+        lock_guard<mutex> lock(mtx);
+        return baseLsn;
+    }
+
+    // Ukuran data record di log aktif (byte)
+    uint64_t dataSize() {
+        lock_guard<mutex> lock(mtx);
+        return writeOffset - sizeof(TransactionLogHeader);
+    }
+
+    /*
+     * Ganti log aktif dengan file kosong yang dimulai dari newBaseLsn.
+     * File baru ditulis ke .tmp lalu di-rename, sehingga crash di tengah
+     * proses meninggalkan log lama atau log baru secara utuh.
+     * Pemanggil menjamin tidak ada append yang berjalan bersamaan.
+     */
+    bool rollover(uint64_t newBaseLsn) {
+        if (path[0] == '\0') return false;
+        close();
+
+        char tmpPath[270];
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+        TransactionLogHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, "EWTXLOG", 7);
+        h.version = TRANSACTION_LOG_VERSION;
+        h.baseLsn = newBaseLsn;
+
+        FILE* f = fopen(tmpPath, "wb");
+        bool ok = f != NULL && fwrite(&h, sizeof(h), 1, f) == 1 && fflush(f) == 0;
+#ifndef _WIN32
+        if (ok) ok = fsync(fileno(f)) == 0;
+#endif
+        if (f != NULL) fclose(f);
+
+        if (ok) {
+            remove(path);
+            ok = rename(tmpPath, path) == 0;
+        }
+        if (!ok) {
+            cout << "Error: Tidak bisa mengganti transaction log\n";
+        }
+        return open(path) && ok;
+    }
+
+    /*
+     * Baca ulang semua record mulai dari LSN tertentu.
+     * Callback dipanggil dengan payload yang sudah di-NUL-terminate.
+     */
+    template <typename Callback>
+    void replay(uint64_t fromLsn, Callback callback) {
+        uint64_t end;
+        {
+            lock_guard<mutex> lock(mtx);
+            end = writeOffset;
+        }
+
+        uint64_t offset = sizeof(TransactionLogHeader);
+        if (fromLsn > baseLsn) offset += fromLsn - baseLsn;
+
+        char buf[LOG_MAX_RECORD + 1];
+        while (offset + 8 <= end) {
+            uint32_t meta[2];
+            if (!readAt(offset, meta, 8) || !readAt(offset + 8, buf, meta[0])) break;
+            buf[meta[0]] = '\0';
+            offset += 8 + meta[0];
+            callback(buf, meta[0], baseLsn + offset - sizeof(TransactionLogHeader));
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef TRANSACTION_RECORDER_H
+#define TRANSACTION_RECORDER_H
+
+#include "data_structures.h"
+#include "transaction_index.h"
+#include "account_history.h"
+#include "transaction_id_index.h"
+#include "time_index.h"
+#include "file_handler.h"
+
+using namespace std;
+
+// =================================================================
+// TRANSACTION RECORDER - Jalur Tulis Tunggal untuk Transaksi Baru
+// =================================================================
+/*
+ * Semua transaksi baru (top up, transfer, pembayaran, refund admin)
+ * lewat record() supaya urutannya selalu sama:
+ * 1. Tulis ke WAL dan tunggu group commit (durable)
+ * 2. Baru masuk index jumlah, riwayat akun, index ID dan index waktu
+ * Jika langkah 1 gagal, tidak ada index yang berubah dan record()
+ * return false -> pemanggil TIDAK boleh mengubah saldo.
+ */
+class TransactionRecorder {
+private:
+    TransactionIndex& transactionIndex;
+    AccountHistory& accountHistory;
+    TransactionIdIndex& transactionIds;
+    TransactionTimeIndex& timeIndex;
+
+public:
+    TransactionRecorder(TransactionIndex& index, AccountHistory& history,
+                        TransactionIdIndex& ids, TransactionTimeIndex& times)
+        : transactionIndex(index), accountHistory(history), transactionIds(ids), timeIndex(times) {}
+
+    // encoded (opsional) diisi ukuran & versi model keterangan yang disimpan
+    bool record(const Transaksi& t, FileHandler& fileHandler, KeteranganEncoding* encoded = NULL) {
+        if (!fileHandler.appendTransaction(t)) {
+            return false;
+        }
+        transactionIndex.insert(t);
+        if (encoded != NULL) *encoded = keteranganArena().lastEncoding();
+        accountHistory.sync();
+        transactionIds.sync();
+        timeIndex.sync();
+        return true;
+    }
+};
+
+#endif
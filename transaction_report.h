@@ -0,0 +1,73 @@
+#ifndef TRANSACTION_REPORT_H
+#define TRANSACTION_REPORT_H
+
+#include <iostream>
+#include "transaction_index.h"
+
+using namespace std;
+
+// =================================================================
+// TRANSACTION REPORT - Laporan Transaksi lewat Cursor Index
+// =================================================================
+/*
+ * Semua laporan transaksi (tabel admin, halaman, ekspor file) dibangun
+ * di atas cursor index (AVLTree::Cursor / BPlusTree::Cursor):
+ * - Iteratif: tidak ada rekursi sedalam tree
+ * - Tanpa alokasi per baris
+ * - Ditulis ke sink (ostream) dengan '\n' -> tidak ada flush per baris
+ * - Bisa berhenti setelah N baris lalu dilanjutkan dengan PageToken
+ */
+const int REPORT_PAGE_SIZE = 20;
+
+inline void writeTableRule(ostream& out) {
+    out << "-----------------------------------------------------------------------\n";
+}
+
+inline void writeTableHeader(ostream& out) {
+    writeTableRule(out);
+    out << "| Jenis Transaksi | Jumlah        | Keterangan                        |\n";
+    writeTableRule(out);
+}
+
+/*
+ * Kunjungi maksimal limit transaksi (0 = tanpa batas) dengan jumlah
+ * <= max, mulai dari key pertama >= token. Return jumlah baris.
+ * Jika masih ada baris berikutnya, hasMore = true dan token berisi
+ * posisi baris tersebut (untuk halaman berikutnya).
+ */
+template <typename Index, typename Fn>
+size_t visitPage(const Index& index, double max, PageToken& token, size_t limit,
+                 bool& hasMore, Fn fn) {
+    size_t rows = 0;
+    typename Index::Cursor c = index.seek(token);
+    for (; c.valid() && c.key() <= max; c.next()) {
+        if (limit > 0 && rows == limit) break;
+        fn(c.record());
+        rows++;
+    }
+
+    hasMore = c.valid() && c.key() <= max;
+    if (hasMore) token = c.token();
+    return rows;
+}
+
+// Tulis 1 halaman tabel transaksi ke sink
+template <typename Index>
+size_t writeTransactionPage(ostream& out, const Index& index, double max, PageToken& token,
+                            size_t limit, bool& hasMore) {
+    return visitPage(index, max, token, limit, hasMore,
+                     [&](const TransaksiRecord& t) { t.display(out); });
+}
+
+// Tulis semua transaksi dengan jumlah di [min, max] sebagai 1 tabel
+template <typename Index>
+size_t writeTransactionTable(ostream& out, const Index& index, double min, double max) {
+    PageToken token(min, 0);
+    bool hasMore;
+    writeTableHeader(out);
+    size_t rows = writeTransactionPage(out, index, max, token, 0, hasMore);
+    writeTableRule(out);
+    return rows;
+}
+
+#endif
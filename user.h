@@ -4,6 +4,7 @@
 #include <iostream>
 #include <cstring>
 #include <iomanip>
+#include <vector>
 
 using namespace std;
 
@@ -49,6 +50,12 @@ struct KTP {
  * - PIN 6 digit untuk keamanan
  * - Data KTP untuk identitas
  * - Fungsi transaksi (Top Up, Transfer, Pembayaran)
+ *
+ * DIRTY TRACKING:
+ * - Setiap user tahu posisi record-nya di users.dat (slot)
+ * - Setiap perubahan data (saldo, password, PIN, KTP) menandai user
+ *   sebagai "dirty" dan memasukkan slot-nya ke antrian dirty
+ * - Saat menyimpan, hanya slot di antrian dirty yang ditulis ulang
  */
 class User {
 private:
@@ -57,6 +64,13 @@ private:
     double saldo;
     char pin[7];  // 6 digit + null terminator
     KTP dataKTP;
+    int slot;     // Posisi record di users.dat (-1 = belum punya)
+    bool dirty;
+    
+    static vector<int>& dirtyQueue() {
+        static vector<int> queue;
+        return queue;
+    }
     
 public:
     User() {
@@ -64,6 +78,8 @@ public:
         strcpy(password, "");
         saldo = 0.0;
         strcpy(pin, "");
+        slot = -1;
+        dirty = false;
     }
     
     User(const char* u, const char* p, const char* pn, double s = 0.0) {
@@ -71,6 +87,8 @@ public:
         strcpy(password, p);
         saldo = s;
         strcpy(pin, pn);
+        slot = -1;
+        dirty = false;
     }
     
     virtual ~User() {}
@@ -92,6 +110,7 @@ public:
     
     void setPassword(const char* newPass) {
         strcpy(password, newPass);
+        markDirty();
     }
     
     double getSaldo() const { return saldo; }
@@ -99,12 +118,14 @@ public:
     void addSaldo(double amount) {
         if (amount > 0) {
             saldo += amount;
+            markDirty();
         }
     }
     
     bool deductSaldo(double amount) {
         if (amount > 0 && saldo >= amount) {
             saldo -= amount;
+            markDirty();
             return true;
         }
         return false;
@@ -117,11 +138,13 @@ public:
     void setPIN(const char* newPin) {
         if (strlen(newPin) == 6) {
             strcpy(pin, newPin);
+            markDirty();
         }
     }
     
     void setKTP(const KTP& ktp) {
         dataKTP = ktp;
+        markDirty();
     }
     
     KTP getKTP() const {
@@ -131,6 +154,33 @@ public:
     const char* getPIN() const {
         return pin;
     }
+    
+    int getSlot() const { return slot; }
+    
+    void setSlot(int s) {
+        slot = s;
+        dirty = false;
+    }
+    
+    bool isDirty() const { return dirty; }
+    
+    // Tandai user berubah -> slot masuk antrian dirty (sekali saja)
+    void markDirty() {
+        if (!dirty && slot >= 0) {
+            dirty = true;
+            dirtyQueue().push_back(slot);
+        }
+    }
+    
+    void clearDirty() {
+        dirty = false;
+    }
+    
+    // Ambil semua slot dirty lalu kosongkan antrian
+    static void takeDirtySlots(vector<int>& out) {
+        out.swap(dirtyQueue());
+        dirtyQueue().clear();
+    }
 };
 
 #endif